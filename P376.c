@@ -0,0 +1,128 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: supersingular isogeny parameters and generation of functions for P376
+* The constants and the strategies are generated by tools/gen_params.py 126 78 53 7, see P747.c for the encodings.
+*********************************************************************************************/
+
+#include "P376_internal.h"
+
+// Curve isogeny system "SIGKp376". Base curve: Montgomery curve By^2 = Cx^3 + Ax^2 + Cx defined over GF(p376^2), where A=0, B=1, C=1
+// and p376 = 2^126*3^78*5^53*7 - 1. The cofactor 7 makes p376 = 3 mod 4, so that GF(p376^2) = GF(p376)(i) with i^2 = -1.
+
+static const uint64_t p376[NWORDS64_FIELD] = {0xFFFFFFFFFFFFFFFF, 0xBFFFFFFFFFFFFFFF, 0x5AFBA1783B3853C6, 0x6AC919DC8401FEBF, 0xEB9DB2E8379E65BE, 0x00B49879D9074BCF};
+#if !defined(UNROLLED_IMPLEMENTATION) && !defined(AVX2_IMPLEMENTATION)  // The unrolled code has the words of p+1 as literals
+static const uint64_t p376p1[NWORDS64_FIELD] = {0x0000000000000000, 0xC000000000000000, 0x5AFBA1783B3853C6, 0x6AC919DC8401FEBF, 0xEB9DB2E8379E65BE, 0x00B49879D9074BCF};
+#endif
+static const uint64_t p376x2[NWORDS64_FIELD] = {0xFFFFFFFFFFFFFFFE, 0x7FFFFFFFFFFFFFFF, 0xB5F742F07670A78D, 0xD59233B90803FD7E, 0xD73B65D06F3CCB7C, 0x016930F3B20E979F};
+// Alice's generator values {XPA0 + XPA1*i, XQA0, XRA0 + XRA1*i} in GF(p376^2), expressed in Montgomery representation
+static const uint64_t A_gen[5 * NWORDS64_FIELD] = {0xEDF26C76064F9040, 0xA49628222C5F42CC, 0xFFFE464F8F4170D5, 0x60328ACF9541E4EE, 0xD8EDCC0C34F7AD6D, 0x00162F9A3E07E478, // XPA0
+	0xDED665A2A5C662BB, 0x9A8528C90FE3DA73, 0x3B434B902B3177CB, 0xF5539D8D0BC46D28, 0xA485F9A3D884206D, 0x008008EC7E456767, // XPA1
+	0x636666EE72E705EA, 0x126310667314C258, 0xC85DE8E5CEADCC89, 0xB42C0EE39C985FD3, 0x7A0B488AB8444272, 0x00062F2D96424BAE, // XQA0
+	0xE7E42DA2D7402836, 0x316664C913491713, 0x405F09EECCB09E5A, 0x081AA7B2BD4A82F0, 0x1E12FDAA7D1EB21B, 0x003F13AF2F8F7870, // XRA0
+	0xC24BA0F0E3B6EDCA, 0xE2A69287C4D8EB54, 0x463E1EACF3730D56, 0xD16A968206F28891, 0x41CA0E6F336B7CB5, 0x008CD95CD483F3CE}; // XRA1
+// Bob's generator values {XPB0 + XPB1*i, XQB0, XRB0 + XRB1*i} in GF(p376^2), expressed in Montgomery representation
+static const uint64_t B_gen[5 * NWORDS64_FIELD] = {0xAFC92F3C8C205DA6, 0x47137170CE4006DC, 0xBDAB8EC2FE0EA985, 0x4055BD57ACADB904, 0x9761973E48675ACF, 0x003C8571ECE967DA, // XPB0
+	0xBF893B6C0AFACADE, 0x55AD031DDB31C873, 0xF7701735B7B0FD7D, 0x7BA47C6B59109BD1, 0x0253D0415A505EFE, 0x0048AA3C2E0DCA52, // XPB1
+	0x3385A6F6D5D505D6, 0xB4EBEC9A6A65F822, 0x47174AC05756DA70, 0xB6E0AFB97E4C9783, 0x309AD29FD00EF0EC, 0x007EC4F95BC6C3D5, // XQB0
+	0xC4C8D40F3590B177, 0x87E36926FB51EF1F, 0xECCCC73A636DFDA3, 0xE2B85746D6DCF262, 0x741C53D0D5A2B881, 0x00715BD436D13957, // XRB0
+	0xDB83B6AB8655BF79, 0x663566A46E218152, 0x6C692887E516082C, 0x2D40BB242B86BF1D, 0x8CD15B4207C19242, 0x001AEB9F5E24F49A}; // XRB1
+// Eve's generator values {XPC0 + XPC1*i, XQC0, XRC0 + XRC1*i} in GF(p376^2), expressed in Montgomery representation
+static const uint64_t C_gen[5 * NWORDS64_FIELD] = {0x90EB838A30C69828, 0xB24510A8253FB68A, 0x3E675F17DBC9BBB0, 0xD8C133C21D33E656, 0xD85E9707E22B2898, 0x0091282D0E0038AB, // XPC0
+	0x8E0F8C70BBAFB5F3, 0x0AC21FB5EAE86473, 0x2992C26F46DAA510, 0x82409194928EEE04, 0x1D5B5E52CDAF125B, 0x002158177C099F9F, // XPC1
+	0xA1E6363B439F03E8, 0x58AB05BD1AAF0B7C, 0x7517F9D4DAA2230F, 0xEBFD4FC326227FB6, 0x9A2C593E9F2D8DD8, 0x000F3EE1F3DAE4E4, // XQC0
+	0xBEF015E2E9C0E4D7, 0xF8BE46CF29D91449, 0x918D56E9D53AD630, 0x5BCDF04C5A6E4F2F, 0x42B9368B8DB5EF9B, 0x0022215666BBCAC0, // XRC0
+	0x8B039FA4F492AB58, 0xFC3AC37E603668A8, 0x91ACD5A056CAD4E6, 0xD5D961A59CEA0286, 0xD46A9F8325CFCB78, 0x0079347D94522259}; // XRC1
+
+// Montgomery constant Montgomery_R2 = (2^384)^2 mod p376
+static const uint64_t Montgomery_R2[NWORDS64_FIELD] = {0x582E3877A3B90578, 0x37A6958291CB2260, 0xB3ACA028D92F9DF8, 0x454CAF562F8D130D, 0x440E1C48152FF052, 0x0043281987C68A91};
+// Value one in Montgomery representation
+static const uint64_t Montgomery_one[NWORDS64_FIELD] = {0x000000000000016A, 0x8000000000000000, 0x582DABFC425988F4, 0xFFA16E2D552DC569, 0xD30103A15A0420BC, 0x00A063B31BAECBFC};
+
+// Fixed parameters for isogeny tree computation
+#if defined(SIGK_SMALL_FOOTPRINT)
+// Strategies storing at most MAX_INT_POINTS = 5 points, generated by tools/gen_params.py 126 78 53 7 --points 5.
+// The splits are listed in the order the traversal reads them
+static const unsigned int strat_Alice[MAX_Alice - 1] = {
+	32, 16, 8, 4, 2, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2, 1, 1, 2, 1, 1, 4,
+	2, 1, 1, 2, 1, 1, 16, 8, 4, 2, 1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1, 8, 4, 2,
+	1, 1, 2, 1, 1, 4, 2, 1, 1, 2, 1, 1};
+
+static const unsigned int strat_Bob[MAX_Bob - 1] = {
+	36, 20, 12, 6, 3, 2, 1, 3, 2, 1, 1, 1, 6, 3, 2, 1, 1, 1, 3, 1, 1, 1, 1, 9, 5,
+	3, 2, 1, 1, 1, 2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 16, 9, 5, 3, 2, 1, 1, 1,
+	2, 1, 1, 1, 4, 2, 1, 1, 1, 2, 1, 1, 7, 4, 2, 1, 1, 1, 2, 1, 1, 3, 2, 1, 1,
+	1, 1};
+
+static const unsigned int strat_Eve[MAX_Eve - 1] = {
+	20, 15, 8, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 2, 1, 1, 1, 1, 1, 6, 3, 3, 2, 1, 1,
+	1, 1, 1, 2, 1, 1, 1, 1, 8, 5, 3, 2, 1, 1, 1, 1, 2, 1, 1, 1, 3, 2, 1, 1, 1,
+	1, 1};
+#else
+static const unsigned int strat_Alice[MAX_Alice] = {
+	0, 1, 1, 2, 2, 2, 3, 4, 4, 4, 4, 5, 5, 6, 7, 8, 8, 8, 8, 8, 9, 9, 10, 11, 11,
+	11, 12, 12, 13, 14, 15, 16, 16, 16, 16, 17, 16, 17, 17, 17, 17, 19, 17, 17, 18, 19, 20, 21, 21, 21,
+	21, 23, 23, 24, 24, 25, 26, 27, 28, 28, 30, 30, 31};
+
+static const unsigned int strat_Bob[MAX_Bob] = {
+	0, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4, 5, 5, 5, 6, 7, 7, 7, 7, 8, 9, 9, 9, 9, 9,
+	10, 11, 12, 12, 12, 12, 12, 13, 14, 14, 15, 16, 16, 16, 16, 16, 18, 16, 16, 17, 18, 19, 20, 21, 21,
+	21, 21, 21, 21, 22, 22, 23, 23, 24, 25, 24, 28, 28, 28, 28, 28, 29, 28, 28, 28, 28, 28, 31, 28, 28,
+	28, 30, 31};
+
+static const unsigned int strat_Eve[MAX_Eve] = {
+	0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 8, 8, 8, 8,
+	8, 9, 9, 10, 11, 9, 10, 11, 12, 12, 12, 12, 12, 12, 13, 13, 14, 14, 14, 15, 14, 14, 16, 17, 17,
+	17, 18, 18};
+
+// Strategies for the isogeny evaluations of each row shared by 2 and 4 threads, see sigk_set_workers(), generated by
+// tools/gen_params.py 126 78 53 7 --cores 2 4. They store at most MAX_INT_POINTS points and list the splits in traversal order.
+// The evaluations of a row fill at most 5 blocks, so the 4-thread strategies also serve more threads
+static const unsigned int strat_Alice_2cores[MAX_Alice - 1] = {
+	23, 18, 10, 7, 4, 3, 2, 1, 3, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 5, 7,
+	3, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 1, 1, 1, 7, 5, 5, 3, 2, 1, 1, 1, 1, 1,
+	2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1};
+
+static const unsigned int strat_Bob_2cores[MAX_Bob - 1] = {
+	26, 24, 14, 7, 3, 1, 1, 1, 2, 1, 3, 3, 2, 1, 1, 1, 7, 3, 3, 2, 1, 1, 1, 1, 3,
+	2, 1, 1, 1, 9, 7, 5, 2, 1, 2, 2, 1, 1, 1, 3, 2, 1, 1, 1, 1, 2, 3, 2, 1, 1,
+	1, 1, 7, 7, 6, 3, 2, 1, 1, 1, 1, 2, 2, 1, 1, 1, 1, 2, 2, 1, 1, 1, 1, 1, 1,
+	2, 1};
+
+static const unsigned int strat_Eve_2cores[MAX_Eve - 1] = {
+	14, 15, 10, 6, 3, 1, 1, 1, 1, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1,
+	5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 3, 3, 2, 1, 1, 1, 1, 1, 1, 1,
+	1, 1};
+
+static const unsigned int strat_Alice_4cores[MAX_Alice - 1] = {
+	13, 18, 12, 10, 6, 3, 2, 1, 3, 2, 1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1, 2, 4, 3,
+	2, 1, 1, 1, 1, 1, 1, 1, 6, 2, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 4, 3, 2, 1, 1, 1, 1, 1, 1};
+
+static const unsigned int strat_Bob_4cores[MAX_Bob - 1] = {
+	9, 31, 8, 7, 9, 7, 3, 3, 2, 1, 1, 1, 1, 3, 2, 1, 1, 1, 1, 2, 3, 2, 1, 1, 1,
+	1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 2, 1, 7, 7, 6, 2, 3, 3, 2, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1};
+
+static const unsigned int strat_Eve_4cores[MAX_Eve - 1] = {
+	10, 7, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1};
+#endif
+
+// Including GF(p), GF(p^2), curve, isogeny and kex functions, named after SIGK_SET by P376_internal.h
+
+#if defined(UNSATURATED_IMPLEMENTATION)
+#include "generic/fp_unsat.c"
+#elif defined(UNROLLED_IMPLEMENTATION)
+#include "generic/fp_p376_unrolled.c"
+#elif defined(AVX2_IMPLEMENTATION)
+#include "generic/fp_p376_unrolled.c"
+#include "amd64/fp_avx2.c"
+#else
+#include "generic/fp_generic.c"
+#endif
+#include "fpx.c"
+#include "ec_isogeny.c"
+#include "groupKey.c"
@@ -0,0 +1,80 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: API header file for P376
+* Parameter set SIGKp376 over p376 = 2^126*3^78*5^53*7 - 1, a smaller prime for faster exchanges at a lower
+* security level than SIGKp747. The functions are those of api.h with the suffix _SIGKp376 and the same
+* arguments, return values and operation identifiers. Its descriptor in the registry is sigk_params_get("SIGKp376").
+*********************************************************************************************/
+
+#ifndef __P376_API_H__
+#define __P376_API_H__
+
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO_SECRETKEYBYTES_SIGKp376       16
+#define CRYPTO_PUBLICKEYBYTES_SIGKp376       564
+#define CRYPTO_BYTES_SIGKp376                94
+#define CRYPTO_SHAREDPUBLICBYTES_SIGKp376    282
+
+// Algorithm name
+#define CRYPTO_ALGNAME_SIGKp376 "SIGKp376"
+
+// Private keys in [0, 2^126 - 1] for Alice, [0, 2^Floor(Log(2,3^78)) - 1] for Bob and [0, 2^Floor(Log(2,5^53)) - 1] for Eve, stored in 16 bytes.
+// Public keys consist of 6 GF(p376^2) elements encoded in 564 bytes, shared public keys of 3 elements encoded in 282 bytes,
+// shared secrets of one element encoded in 94 bytes.
+void random_mod_order_A_SIGKp376(unsigned char* random_digits);
+void random_mod_order_B_SIGKp376(unsigned char* random_digits);
+void random_mod_order_C_SIGKp376(unsigned char* random_digits);
+
+int EphemeralKeyGeneration_A_SIGKp376(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+int EphemeralKeyGeneration_B_SIGKp376(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+int EphemeralKeyGeneration_C_SIGKp376(const unsigned char* PrivateKeyC, unsigned char* PublicKeyC);
+int BSharedPublicFromA_SIGKp376(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB);
+int CSharedSecretFromB_SIGKp376(const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret);
+int ASharedSecretFromC_SIGKp376(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+int BSharedSecretFromA_SIGKp376(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+
+// Resumable operations, an operation started by these functions must be advanced with sigk_step_SIGKp376()
+int sigk_start_EphemeralKeyGeneration_A_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+int sigk_start_EphemeralKeyGeneration_B_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+int sigk_start_EphemeralKeyGeneration_C_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyC, unsigned char* PublicKeyC);
+int sigk_start_BSharedPublicFromA_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB);
+int sigk_start_CSharedSecretFromB_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret);
+int sigk_start_ASharedSecretFromC_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+int sigk_start_BSharedSecretFromA_SIGKp376(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+int sigk_step_SIGKp376(sigk_op_t* op, unsigned int budget);
+
+// Operations with a caller-provided workspace of sigk_workspace_size_SIGKp376(op) bytes
+size_t sigk_workspace_size_SIGKp376(unsigned int op);
+int EphemeralKeyGeneration_A_ws_SIGKp376(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, void* workspace);
+int EphemeralKeyGeneration_B_ws_SIGKp376(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, void* workspace);
+int EphemeralKeyGeneration_C_ws_SIGKp376(const unsigned char* PrivateKeyC, unsigned char* PublicKeyC, void* workspace);
+int BSharedPublicFromA_ws_SIGKp376(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB, void* workspace);
+int CSharedSecretFromB_ws_SIGKp376(const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret, void* workspace);
+int ASharedSecretFromC_ws_SIGKp376(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+int BSharedSecretFromA_ws_SIGKp376(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+
+// Message framing, see api.h. The headers of this set carry its field size, so its messages are refused by the other sets.
+#define SIGK_PASS1_BYTES_SIGKp376            (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES_SIGKp376)
+#define SIGK_PASS2_BYTES_SIGKp376            (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES_SIGKp376 + CRYPTO_SHAREDPUBLICBYTES_SIGKp376)
+#define SIGK_PASS3_BYTES_SIGKp376            (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES_SIGKp376 + CRYPTO_SHAREDPUBLICBYTES_SIGKp376)
+#define SIGK_PASS4_BYTES_SIGKp376            (SIGK_FRAME_HEADER_BYTES + CRYPTO_SHAREDPUBLICBYTES_SIGKp376)
+
+size_t sigk_frame_bytes_SIGKp376(unsigned int pass);
+int sigk_frame_init_SIGKp376(unsigned int pass, unsigned char* msg, unsigned char** PublicKey, unsigned char** SharedPublic);
+int sigk_frame_parse_SIGKp376(unsigned int pass, const unsigned char* msg, size_t len, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+#if !defined(__WINDOWS__)
+int sigk_frame_iov_SIGKp376(unsigned int pass, unsigned char* header, unsigned char* PublicKey, unsigned char* SharedPublic, struct iovec* iov);
+int sigk_frame_parse_iov_SIGKp376(unsigned int pass, const struct iovec* iov, int iovcnt, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: internal header file for P376
+* Parameters of the set SIGKp376, laid out as in P747_internal.h
+*********************************************************************************************/
+
+#ifndef __P376_INTERNAL_H__
+#define __P376_INTERNAL_H__
+
+#include "P376_api.h"
+
+#if (TARGET == TARGET_AMD64)
+#define NWORDS_FIELD 6     // Number of words of a 376-bit field element
+#define PRIME_ZERO_WORDS 1 // Number of "0" digits in the least significant part of p376 + 1
+#elif (TARGET == TARGET_x86)
+#define NWORDS_FIELD 12
+#define PRIME_ZERO_WORDS 3
+#elif (TARGET == TARGET_ARM)
+#define NWORDS_FIELD 12
+#define PRIME_ZERO_WORDS 3
+#elif (TARGET == TARGET_ARM64)
+#define NWORDS_FIELD 6
+#define PRIME_ZERO_WORDS 1
+#endif
+
+// Basic constants
+
+#define SIGK_SET p376          // Suffix of the internal symbols
+#define SIGK_API_SET SIGKp376  // Suffix of the functions of api.h, see P376_api.h
+#define SIGK_SET_ALGNAME CRYPTO_ALGNAME_SIGKp376
+#define SIGK_SET_SECRETKEYBYTES CRYPTO_SECRETKEYBYTES_SIGKp376
+#define SIGK_SET_PUBLICKEYBYTES CRYPTO_PUBLICKEYBYTES_SIGKp376
+#define SIGK_SET_SHAREDPUBLICBYTES CRYPTO_SHAREDPUBLICBYTES_SIGKp376
+#define SIGK_SET_BYTES CRYPTO_BYTES_SIGKp376
+#define NBITS_FIELD 376
+#define MAXBITS_FIELD 384
+#define NBITS_ORDER 128
+#define OALICE_BITS 127
+#define OBOB_BITS 124
+#define OEVE_BITS 124
+#define OBOB_EXPON 78
+#define OEVE_EXPON 53
+#define MASK_ALICE 0x3F
+#define MASK_BOB 0x07
+#define MASK_EVE 0x07
+#define PRIME p376
+#define PRIMEp1 p376p1
+#define PRIMEx2 p376x2
+// Fixed parameters for isogeny tree computation
+#if defined(SIGK_SMALL_FOOTPRINT) // Strategies bounded to 5 stored points, see tools/gen_params.py --points
+#define MAX_INT_POINTS_ALICE 5
+#define MAX_INT_POINTS_BOB 5
+#define MAX_INT_POINTS_EVE 5
+#else
+#define MAX_INT_POINTS_ALICE 6
+#define MAX_INT_POINTS_BOB 8
+#define MAX_INT_POINTS_EVE 9
+#endif
+#define MAX_Alice 63
+#define MAX_Bob 78
+#define MAX_Eve 53
+#define MAX_INT_POINTS MAX_INT_POINTS_EVE // Maximum number of intermediate points over the three strategies
+
+#include "sigk_internal.h"
+
+#endif
@@ -0,0 +1,158 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: GF(p^2) multiplication with AVX2
+* The three products a0*b0, a1*b1 and (a0+a1)*(b0+b1) of a GF(p^2) multiplication run side by side in the 64-bit lanes
+* of AVX2 registers. The operands are split into 29-bit limbs, so that the 32x32-bit products of a column add up in
+* 64 bits without carries, and multiplied with one Karatsuba level. The exact products are joined back into 64-bit
+* words and reduced by rdc_mont(). The reduction, the squarings and the other field functions are those of the unrolled
+* backend of the set, included before this file by P747.c and P376.c in _AVX2_ builds, compiled with -mavx2. The two
+* products of a GF(p^2) squaring are faster as unrolled scalar code than in the lanes.
+*********************************************************************************************/
+
+#define SIGK_FP2_PRODUCTS
+#include <immintrin.h>
+
+#if !defined(__AVX2__) || !defined(UINT128_SUPPORT) || (RADIX != 64)
+#error -- "The AVX2 backend requires an x64 target and -mavx2"
+#endif
+#if !defined(SIGK_FP_MUL_RDC)
+#error -- "The AVX2 backend is included after the unrolled backend of the set"
+#endif
+
+#define LIMB_BITS 29
+#define NLIMBS_HALF ((NBITS_FIELD + 2 + 2*LIMB_BITS - 1) / (2*LIMB_BITS))   // Half the limbs of an operand below 4p
+#define NLIMBS_FIELD (2 * NLIMBS_HALF)                                       // 26 for p747
+#define NLIMBS_PRODUCT (2 * NLIMBS_FIELD)                                    // Limbs of a product, the last one holds the final carry
+
+#if (NLIMBS_FIELD >= 32)       // Column sums below NLIMBS_FIELD*2^58, middle product columns below NLIMBS_HALF*2^60
+#error -- "The column sums of the AVX2 backend do not fit in 64 bits"
+#endif
+#if ((2 * NWORDS_FIELD) % 4 != 0)
+#error -- "The AVX2 backend joins the words of the products four at a time"
+#endif
+
+
+static __inline void avx2_split(const digit_t* a0, const digit_t* a1, const digit_t* a2, __m256i* r)
+{ // Split the operands a0, a1 and a2 of NWORDS_FIELD words, each below 4p, into 29-bit limbs. Operand l goes to lane l.
+    const __m256i mask = _mm256_set1_epi64x(((int64_t)1 << LIMB_BITS) - 1);
+    __m256i w[NWORDS_FIELD + 1];
+    unsigned int i, k, o;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        w[i] = _mm256_set_epi64x(0, (int64_t)a2[i], (int64_t)a1[i], (int64_t)a0[i]);
+    }
+    w[NWORDS_FIELD] = _mm256_setzero_si256();
+
+    #pragma GCC unroll 32
+    for (k = 0; k < NLIMBS_FIELD; k++) {
+        i = (k * LIMB_BITS) / RADIX;
+        o = (k * LIMB_BITS) % RADIX;
+        r[k] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(w[i], (int)o), _mm256_slli_epi64(w[i + 1], (int)(RADIX - o))), mask);
+    }
+}
+
+
+static __inline void avx2_mul_half(const __m256i* a, const __m256i* b, __m256i* c)
+{ // Product scanning multiply of NLIMBS_HALF limbs of each lane. Column k gets the sum of a[i]*b[k-i].
+    unsigned int i, k;
+    __m256i acc;
+
+    #pragma GCC unroll 32
+    for (k = 0; k < 2*NLIMBS_HALF-1; k++) {
+        acc = _mm256_setzero_si256();
+        #pragma GCC unroll 16
+        for (i = (k < NLIMBS_HALF) ? 0 : k-NLIMBS_HALF+1; i <= k && i < NLIMBS_HALF; i++) {
+            acc = _mm256_add_epi64(acc, _mm256_mul_epu32(a[i], b[k-i]));
+        }
+        c[k] = acc;
+    }
+}
+
+
+static __inline void avx2_mul(const __m256i* a, const __m256i* b, __m256i* c)
+{ // Karatsuba multiply of the limbs of each lane, with one level on the column sums. Column k gets the sum of a[i]*b[k-i],
+  // below 2^63. The sums of the low and high halves have 30-bit limbs, the columns of their product fit in 64 bits, and
+  // each column of the middle product is at least the sum of the columns of the low and high products.
+    __m256i sa[NLIMBS_HALF], sb[NLIMBS_HALF], mid[2*NLIMBS_HALF-1];
+    unsigned int k;
+
+    #pragma GCC unroll 16
+    for (k = 0; k < NLIMBS_HALF; k++) {
+        sa[k] = _mm256_add_epi64(a[k], a[k + NLIMBS_HALF]);
+        sb[k] = _mm256_add_epi64(b[k], b[k + NLIMBS_HALF]);
+    }
+    avx2_mul_half(a, b, c);
+    avx2_mul_half(a + NLIMBS_HALF, b + NLIMBS_HALF, c + 2*NLIMBS_HALF);
+    avx2_mul_half(sa, sb, mid);
+    c[2*NLIMBS_HALF-1] = _mm256_setzero_si256();
+
+    #pragma GCC unroll 32
+    for (k = 0; k < 2*NLIMBS_HALF-1; k++) {
+        mid[k] = _mm256_sub_epi64(mid[k], _mm256_add_epi64(c[k], c[k + 2*NLIMBS_HALF]));
+    }
+    #pragma GCC unroll 32
+    for (k = 0; k < 2*NLIMBS_HALF-1; k++) {
+        c[k + NLIMBS_HALF] = _mm256_add_epi64(c[k + NLIMBS_HALF], mid[k]);
+    }
+}
+
+
+static __inline void avx2_join(const __m256i* c, digit_t* r0, digit_t* r1, digit_t* r2)
+{ // Propagate the carries of the column sums c of each lane into 29-bit limbs, then join the limbs of lane l into the
+  // 2*NWORDS_FIELD words of r_l, four words of the lanes at a time.
+    const __m256i mask = _mm256_set1_epi64x(((int64_t)1 << LIMB_BITS) - 1);
+    __m256i limb[NLIMBS_PRODUCT + 3], w[2*NWORDS_FIELD], carry = _mm256_setzero_si256(), t, u0, u1, u2, u3;
+    unsigned int j, k;
+
+    #pragma GCC unroll 64
+    for (k = 0; k < 2*NLIMBS_FIELD-1; k++) {
+        t = _mm256_add_epi64(c[k], carry);
+        limb[k] = _mm256_and_si256(t, mask);
+        carry = _mm256_srli_epi64(t, LIMB_BITS);
+    }
+    limb[NLIMBS_PRODUCT-1] = carry;         // The products are below 2^(2*NBITS_FIELD+4), no carry is left
+    for (k = NLIMBS_PRODUCT; k < NLIMBS_PRODUCT + 3; k++) {
+        limb[k] = _mm256_setzero_si256();
+    }
+
+    #pragma GCC unroll 32
+    for (j = 0; j < 2*NWORDS_FIELD; j++) {
+        // Word j holds the bits of at most four limbs, the first one starting below the word
+        k = (j * RADIX) / LIMB_BITS;
+        t = _mm256_srli_epi64(limb[k], (int)(j * RADIX - k * LIMB_BITS));
+        t = _mm256_or_si256(t, _mm256_slli_epi64(limb[k + 1], (int)((k + 1) * LIMB_BITS - j * RADIX)));
+        t = _mm256_or_si256(t, _mm256_slli_epi64(limb[k + 2], (int)((k + 2) * LIMB_BITS - j * RADIX)));
+        w[j] = _mm256_or_si256(t, _mm256_slli_epi64(limb[k + 3], (int)((k + 3) * LIMB_BITS - j * RADIX)));
+    }
+
+    #pragma GCC unroll 8
+    for (j = 0; j < 2*NWORDS_FIELD; j += 4) {
+        // Transpose the words j..j+3 of the lanes into four words of each lane
+        u0 = _mm256_unpacklo_epi64(w[j], w[j + 1]);
+        u1 = _mm256_unpackhi_epi64(w[j], w[j + 1]);
+        u2 = _mm256_unpacklo_epi64(w[j + 2], w[j + 3]);
+        u3 = _mm256_unpackhi_epi64(w[j + 2], w[j + 3]);
+        _mm256_storeu_si256((__m256i*)&r0[j], _mm256_permute2x128_si256(u0, u2, 0x20));
+        _mm256_storeu_si256((__m256i*)&r1[j], _mm256_permute2x128_si256(u1, u3, 0x20));
+        _mm256_storeu_si256((__m256i*)&r2[j], _mm256_permute2x128_si256(u0, u2, 0x31));
+    }
+}
+
+
+static void mp_mul_x3(const digit_t* a0, const digit_t* b0, const digit_t* a1, const digit_t* b1, const digit_t* a2, const digit_t* b2, digit_t* c0, digit_t* c1, digit_t* c2)
+{ // Three multiprecision products c_l = a_l*b_l side by side, where lng(a_l) = lng(b_l) = NWORDS_FIELD and a_l, b_l < 4p
+    __m256i x[NLIMBS_FIELD], y[NLIMBS_FIELD], z[2*NLIMBS_FIELD-1];
+
+    COUNT_OPS(mp_mul, 3);
+
+    avx2_split(a0, a1, a2, x);
+    avx2_split(b0, b1, b2, y);
+    avx2_mul(x, y, z);
+    avx2_join(z, c0, c1, c2);
+}
+
+#undef LIMB_BITS
+#undef NLIMBS_HALF
+#undef NLIMBS_FIELD
+#undef NLIMBS_PRODUCT
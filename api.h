@@ -12,6 +12,13 @@
 #define __P747_API_H__
 
 #include "config.h"
+#if !defined(__WINDOWS__)
+#include <sys/uio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /*********************** Group Key Agreement API ***********************/
 
@@ -85,4 +92,235 @@ int ASharedSecretFromC(const unsigned char* PrivateKeyA, const unsigned char* Pu
 // The shared secret key consists of one GF(p747^2) element encoded in 190 bytes.
 int BSharedSecretFromA(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
 
+/*********************** Resumable group key operations ***********************/
+// Each operation above can also be run as a resumable state machine. The operation is started with the matching
+// sigk_start_* function and then advanced with sigk_step(), which performs at most "budget" units of work and returns.
+// One unit is a setup or finalization stage, SIGK_LADDER_BITS_PER_UNIT bits of the 3-point ladder, or one row of the
+// isogeny strategy. Cooperative schedulers can thus interleave several operations on the same thread.
+// The buffers passed to sigk_start_* must stay valid and unchanged until sigk_step() returns SIGK_STEP_DONE.
+
+// Operation identifiers
+#define SIGK_OP_KEYGEN_A                    0
+#define SIGK_OP_KEYGEN_B                    1
+#define SIGK_OP_KEYGEN_C                    2
+#define SIGK_OP_B_SHARED_PUBLIC_FROM_A      3
+#define SIGK_OP_C_SHARED_SECRET_FROM_B      4
+#define SIGK_OP_A_SHARED_SECRET_FROM_C      5
+#define SIGK_OP_B_SHARED_SECRET_FROM_A      6
+#define SIGK_NUM_OPS                        7
+
+// Return values of sigk_step()
+#define SIGK_STEP_DONE                      0
+#define SIGK_STEP_PENDING                   1
+#define SIGK_STEP_ERROR                    -1
+
+#define SIGK_STEP_UNBOUNDED                 0xFFFFFFFF    // Budget running an operation to completion
+#define SIGK_LADDER_BITS_PER_UNIT           16
+#define SIGK_OP_STATEBYTES                  12288
+
+// Storage for the state of a resumable operation, aligned to cache lines. A sigk_op_t allocated on the heap must be
+// obtained from an aligned allocator such as aligned_alloc(CACHE_LINE_BYTES, sizeof(sigk_op_t)).
+typedef struct {
+    ALIGN_CACHE_LINE uint64_t opaque[SIGK_OP_STATEBYTES / 8];
+} sigk_op_t;
+
+// Start resumable versions of the operations above. The arguments are the same as for the corresponding function.
+// Return 0 on success and 1 if "op" is not aligned to CACHE_LINE_BYTES.
+int sigk_start_EphemeralKeyGeneration_A(sigk_op_t* op, const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+int sigk_start_EphemeralKeyGeneration_B(sigk_op_t* op, const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+int sigk_start_EphemeralKeyGeneration_C(sigk_op_t* op, const unsigned char* PrivateKeyC, unsigned char* PublicKeyC);
+int sigk_start_BSharedPublicFromA(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB);
+int sigk_start_CSharedSecretFromB(sigk_op_t* op, const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret);
+int sigk_start_ASharedSecretFromC(sigk_op_t* op, const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+int sigk_start_BSharedSecretFromA(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+
+// Advance a started operation by at most "budget" units of work.
+// Returns SIGK_STEP_PENDING if work remains, SIGK_STEP_DONE once the outputs have been written, and SIGK_STEP_ERROR if
+// "op" does not hold a started operation or is misaligned. Intermediate values are cleared from "op" when the operation completes.
+int sigk_step(sigk_op_t* op, unsigned int budget);
+
+/******************* Operations with a caller-provided workspace *******************/
+// The functions above keep all their intermediate values in a sigk_op_t on the stack. The _ws variants below keep
+// them in a caller-allocated workspace instead, which must be aligned to SIGK_WORKSPACE_ALIGN bytes and hold at least
+// sigk_workspace_size(op) bytes, op being the SIGK_OP_* identifier of the operation. The workspace can be reused once
+// the function returns, the intermediate values are cleared from it before returning. The stack used by these functions is then bounded by a few
+// kilobytes of field temporaries, see "make stack_report". random_mod_order_* use no temporaries and have no _ws variant.
+// Return 0 on success and 1 if the workspace is NULL or misaligned.
+
+#define SIGK_WORKSPACE_ALIGN                64
+
+// Size in bytes of the workspace of operation "op", a multiple of SIGK_WORKSPACE_ALIGN. Returns 0 for an unknown operation.
+size_t sigk_workspace_size(unsigned int op);
+
+int EphemeralKeyGeneration_A_ws(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, void* workspace);
+int EphemeralKeyGeneration_B_ws(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, void* workspace);
+int EphemeralKeyGeneration_C_ws(const unsigned char* PrivateKeyC, unsigned char* PublicKeyC, void* workspace);
+int BSharedPublicFromA_ws(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB, void* workspace);
+int CSharedSecretFromB_ws(const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret, void* workspace);
+int ASharedSecretFromC_ws(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+int BSharedSecretFromA_ws(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+
+/*********************** Operation counters ***********************/
+// When the library is built with -D SIGK_COUNT_OPS (make COUNT_OPS=1), each thread counts the calls it makes to the
+// field and curve primitives. The counters only grow, the cost of an operation is the difference of two snapshots.
+
+typedef struct {
+    // GF(p) arithmetic
+    uint64_t mp_mul, rdc_mont;                 // Integer products and Montgomery reductions, including those of GF(p^2) arithmetic
+    uint64_t fpadd, fpsub;
+    uint64_t fpmul, fpsqr, fpinv;
+    // GF(p^2) arithmetic
+    uint64_t fp2mul, fp2sqr, fp2inv;
+    // Curve arithmetic
+    uint64_t xDBL, xTPL, xQNTPL, xDBLADD, xDBLADD_AC24;
+    uint64_t get_4_isog, get_3_isog;
+    uint64_t eval_4_isog, eval_3_isog, eval_5_isog; // Points pushed through an isogeny
+    uint64_t get_A, get_A_projective, get_a_from_alpha, j_inv;
+    uint64_t inv_3_way, inv_6_way;
+} sigk_opcount_t;
+
+// Copy the counters of the calling thread to "counts".
+// Returns 0, or 1 with "counts" set to zero if the library was built without SIGK_COUNT_OPS.
+int sigk_opcount_snapshot(sigk_opcount_t* counts);
+
+/*********************** Phase tracing ***********************/
+// A hook registered with sigk_set_trace_hook() is called at the beginning and at the end of each phase of an operation,
+// with the SIGK_OP_* identifier of the operation, the phase, the event and a monotonic timestamp in nanoseconds.
+// Operations made of two walks report the phases of each walk. When an operation is run with sigk_step(), the time
+// between two steps is counted in the phase running at that point. Without a hook, each phase boundary costs one branch.
+// The hook is shared by all threads and is called on the thread running the operation. It must be set or cleared while no operation is running.
+
+// Phases of a walk
+#define SIGK_PHASE_DECODE                   0    // Decoding of the input points, or loading of the public generators for key generations
+#define SIGK_PHASE_GET_A                    1    // Recovery of the curve from the decoded kernel basis, not part of key generations
+#define SIGK_PHASE_LADDER                   2    // 3-point ladder computing the kernel point
+#define SIGK_PHASE_TRAVERSE                 3    // Traversal of the isogeny tree following the strategy, including the last isogeny
+#define SIGK_PHASE_NORMALIZE                4    // Simultaneous inversion (inv_3_way or inv_6_way) and normalization of the image points
+#define SIGK_PHASE_J_INV                    5    // j-invariant of the final curve of a shared secret
+#define SIGK_PHASE_ENCODE                   6    // Encoding of the output
+#define SIGK_NUM_PHASES                     7
+
+// Events of a phase
+#define SIGK_TRACE_BEGIN                    0
+#define SIGK_TRACE_END                      1
+
+typedef void (*sigk_trace_hook_t)(void* ctx, unsigned int op, unsigned int phase, unsigned int event, uint64_t timestamp_ns);
+
+// Register "hook", called with "ctx" as first argument. A NULL hook disables tracing.
+void sigk_set_trace_hook(sigk_trace_hook_t hook, void* ctx);
+
+/*********************** Parallel isogeny evaluation ***********************/
+// Worker threads started with sigk_set_workers() share the evaluations of the points pushed through the isogenies of each
+// operation, with the strategies chosen for that number of threads. The outputs are the same with or without workers.
+// The workers are shared by all threads and parameter sets and serve one operation at a time, the operations running
+// meanwhile evaluate their points on their own thread. With SIGK_COUNT_OPS, the evaluations run by a worker are counted
+// on the worker thread. Not available on Windows.
+
+#define SIGK_MAX_WORKERS                    7
+
+// Stop the running workers and start n new ones, n = 0 stops them. Must be called while no operation is running.
+// Returns 0, or 1 if n > SIGK_MAX_WORKERS or a thread could not be started.
+int sigk_set_workers(unsigned int n);
+
+/*********************** Message framing ***********************/
+// Each pass of the exchange carries one message made of a header followed by the keys of the pass:
+//   pass 1, A -> B: PublicKeyA
+//   pass 2, B -> C: PublicKeyB, SharedPublicAB
+//   pass 3, C -> A: PublicKeyC, SharedPublicBC
+//   pass 4, A -> B: SharedPublicAC
+// The header holds SIGK_FRAME_VERSION, the pass, the size of the field of the set in bits (2 bytes) and the number of
+// bytes of keys that follow (4 bytes), integers in little endian. Messages are built without copying the keys: the
+// operations write their outputs into a contiguous message at the places given by sigk_frame_init(), or the keys stay
+// in the caller's buffers and sigk_frame_iov() lists them after the header for writev() or sendmsg(). The padding bytes
+// past the encoded elements of the keys are cleared in both cases, and a received message is checked and parsed in place.
+
+#define SIGK_FRAME_VERSION                  1
+#define SIGK_FRAME_HEADER_BYTES             8
+#define SIGK_NUM_PASSES                     4
+#define SIGK_FRAME_MAX_IOV                  3    // Entries of an iovec array holding any message
+
+// Sizes of the messages of the default set
+#define SIGK_PASS1_BYTES                    (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES)
+#define SIGK_PASS2_BYTES                    (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES + CRYPTO_SHAREDPUBLICBYTES)
+#define SIGK_PASS3_BYTES                    (SIGK_FRAME_HEADER_BYTES + CRYPTO_PUBLICKEYBYTES + CRYPTO_SHAREDPUBLICBYTES)
+#define SIGK_PASS4_BYTES                    (SIGK_FRAME_HEADER_BYTES + CRYPTO_SHAREDPUBLICBYTES)
+
+// Size in bytes of the message of pass "pass" (1 to SIGK_NUM_PASSES), or 0 for an unknown pass
+size_t sigk_frame_bytes(unsigned int pass);
+
+// Write the header of pass "pass" at the start of "msg", a buffer of sigk_frame_bytes(pass) bytes, and clear the padding of its keys.
+// PublicKey and SharedPublic receive the places of the keys in "msg", to be passed as outputs to the operations, or NULL if
+// the pass does not carry that key. Either pointer may be NULL. Returns 0 on success and 1 for an unknown pass.
+int sigk_frame_init(unsigned int pass, unsigned char* msg, unsigned char** PublicKey, unsigned char** SharedPublic);
+
+// Check a received message of pass "pass" of "len" bytes. PublicKey and SharedPublic receive the places of its keys in "msg",
+// or NULL if the pass does not carry that key, and may be NULL. Returns 0 if the header matches the pass and the set, and
+// every key holds reduced GF(p^2) elements and zero padding, and 1 otherwise.
+int sigk_frame_parse(unsigned int pass, const unsigned char* msg, size_t len, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+
+#if !defined(__WINDOWS__)
+// Write the header of pass "pass" to "header" (SIGK_FRAME_HEADER_BYTES bytes), clear the padding of the keys and list the
+// header and the keys of the pass in "iov", which has room for SIGK_FRAME_MAX_IOV entries. The key not carried by the pass
+// is ignored and may be NULL. Returns the number of entries written, or 0 for an unknown pass or a missing key.
+int sigk_frame_iov(unsigned int pass, unsigned char* header, unsigned char* PublicKey, unsigned char* SharedPublic, struct iovec* iov);
+
+// Check a message of pass "pass" received in the layout of sigk_frame_iov(), for instance by readv(): the header in iov[0],
+// then each key of the pass in one entry of its exact size. Outputs and return value are those of sigk_frame_parse().
+int sigk_frame_parse_iov(unsigned int pass, const struct iovec* iov, int iovcnt, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+#endif
+
+/*********************** Parameter sets ***********************/
+// The functions above run the default set SIGKp747. Other sets have the same functions with the set name as suffix,
+// declared in their own header (P376_api.h for SIGKp376), and all the sets are listed in a registry to choose one at run time.
+// The operation identifiers, the step interface and the hooks are shared by all sets, but an operation started by a set
+// must be stepped by the same set and a workspace is sized for one set.
+
+typedef struct {
+    const char* name;                                  // CRYPTO_ALGNAME of the set
+    size_t secretkey_bytes, publickey_bytes, sharedpublic_bytes, bytes;
+    void (*random_A)(unsigned char* random_digits);
+    void (*random_B)(unsigned char* random_digits);
+    void (*random_C)(unsigned char* random_digits);
+    int (*keygen_A)(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+    int (*keygen_B)(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+    int (*keygen_C)(const unsigned char* PrivateKeyC, unsigned char* PublicKeyC);
+    int (*B_shared_public_from_A)(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB);
+    int (*C_shared_secret_from_B)(const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret);
+    int (*A_shared_secret_from_C)(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+    int (*B_shared_secret_from_A)(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+    int (*start_keygen_A)(sigk_op_t* op, const unsigned char* PrivateKeyA, unsigned char* PublicKeyA);
+    int (*start_keygen_B)(sigk_op_t* op, const unsigned char* PrivateKeyB, unsigned char* PublicKeyB);
+    int (*start_keygen_C)(sigk_op_t* op, const unsigned char* PrivateKeyC, unsigned char* PublicKeyC);
+    int (*start_B_shared_public_from_A)(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB);
+    int (*start_C_shared_secret_from_B)(sigk_op_t* op, const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret);
+    int (*start_A_shared_secret_from_C)(sigk_op_t* op, const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+    int (*start_B_shared_secret_from_A)(sigk_op_t* op, const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret);
+    int (*step)(sigk_op_t* op, unsigned int budget);
+    size_t (*workspace_size)(unsigned int op);
+    int (*keygen_A_ws)(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, void* workspace);
+    int (*keygen_B_ws)(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, void* workspace);
+    int (*keygen_C_ws)(const unsigned char* PrivateKeyC, unsigned char* PublicKeyC, void* workspace);
+    int (*B_shared_public_from_A_ws)(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedPublicAB, void* workspace);
+    int (*C_shared_secret_from_B_ws)(const unsigned char* PrivateKeyC, const unsigned char* PublicKeyB, const unsigned char* SharedPublicAB, unsigned char* SharedPublicBC, unsigned char* SharedSecret, void* workspace);
+    int (*A_shared_secret_from_C_ws)(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyC, const unsigned char* SharedPublicBC, unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+    int (*B_shared_secret_from_A_ws)(const unsigned char* PrivateKeyB, const unsigned char* SharedPublicAC, unsigned char* SharedSecret, void* workspace);
+    size_t (*frame_bytes)(unsigned int pass);
+    int (*frame_init)(unsigned int pass, unsigned char* msg, unsigned char** PublicKey, unsigned char** SharedPublic);
+    int (*frame_parse)(unsigned int pass, const unsigned char* msg, size_t len, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+#if !defined(__WINDOWS__)
+    int (*frame_iov)(unsigned int pass, unsigned char* header, unsigned char* PublicKey, unsigned char* SharedPublic, struct iovec* iov);
+    int (*frame_parse_iov)(unsigned int pass, const struct iovec* iov, int iovcnt, const unsigned char** PublicKey, const unsigned char** SharedPublic);
+#endif
+} sigk_params_t;
+
+// Set named "name" ("SIGKp747", "SIGKp376"), or NULL if there is none
+const sigk_params_t* sigk_params_get(const char* name);
+
+// Set number "index" in the registry, the default set first, or NULL past the last set
+const sigk_params_t* sigk_params_at(unsigned int index);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
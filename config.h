@@ -83,6 +83,12 @@
     #define GENERIC_IMPLEMENTATION
 #elif defined(_FAST_)                      
     #define FAST_IMPLEMENTATION
+#elif defined(_UNSATURATED_)
+    #define UNSATURATED_IMPLEMENTATION
+#elif defined(_UNROLLED_)
+    #define UNROLLED_IMPLEMENTATION
+#elif defined(_AVX2_)
+    #define AVX2_IMPLEMENTATION
 #endif
 
 
@@ -113,6 +119,14 @@
 // Macro to avoid compiler warnings when detecting unreferenced parameters
 #define UNREFERENCED_PARAMETER(PAR) ((void)(PAR))
 
+// Alignment of data structures to cache lines
+#define CACHE_LINE_BYTES            64
+#if (COMPILER == COMPILER_VC)
+    #define ALIGN_CACHE_LINE        __declspec(align(CACHE_LINE_BYTES))
+#else
+    #define ALIGN_CACHE_LINE        __attribute__((aligned(CACHE_LINE_BYTES)))
+#endif
+
 
 /********************** Constant-time unsigned comparisons ***********************/
 
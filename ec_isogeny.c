@@ -8,7 +8,7 @@
 *   Modified by Amir Jalali             ajalali2016@fau.edu
 *********************************************************************************************/
 
-#include "P747_internal.h"
+#include "sigk_internal.h"
 
 void xDBL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24)
 { // Doubling of a Montgomery point in projective coordinates (X:Z).
@@ -16,6 +16,8 @@ void xDBL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2e
     // Output: projective Montgomery x-coordinates Q = 2*P = (X2:Z2).
     f2elm_t t0, t1;
 
+    COUNT_OP(xDBL);
+
     fp2sub(P->X, P->Z, t0);       // t0 = X1-Z1
     fp2add(P->X, P->Z, t1);       // t1 = X1+Z1
     fp2sqr_mont(t0, t0);          // t0 = (X1-Z1)^2
@@ -47,6 +49,7 @@ void get_4_isog(const point_proj_t P, f2elm_t A24plus, f2elm_t C24, f2elm_t *coe
     // Input:  projective point of order four P = (X4:Z4).
     // Output: the 4-isogenous Montgomery curve with projective coefficients A+2C/4C and the 3 coefficients
     //         that are used to evaluate the isogeny at a point in eval_4_isog().
+    COUNT_OP(get_4_isog);
 
     fp2sub(P->X, P->Z, coeff[1]);         // coeff[1] = X4-Z4
     fp2add(P->X, P->Z, coeff[2]);         // coeff[2] = X4+Z4
@@ -66,6 +69,8 @@ void eval_4_isog(point_proj_t P, f2elm_t *coeff)
     // Output: the projective point P = phi(P) = (X:Z) in the codomain.
     f2elm_t t0, t1;
 
+    COUNT_OP(eval_4_isog);
+
     fp2add(P->X, P->Z, t0);          // t0 = X+Z
     fp2sub(P->X, P->Z, t1);          // t1 = X-Z
     fp2mul_mont(t0, coeff[1], P->X); // X = (X+Z)*coeff[1]
@@ -82,12 +87,66 @@ void eval_4_isog(point_proj_t P, f2elm_t *coeff)
     fp2mul_mont(P->Z, t0, P->Z);     // Zfinal
 }
 
+void eval_4_isog_multi(point_block *pts, const unsigned int n, const f2elm_t *coeff)
+{ // Evaluates the 4-isogeny defined by coeff at the points 0, ..., n-1 of the array of blocks pts.
+    // The formulas are those of eval_4_isog(), applied one operation at a time to all the points of a block so that
+    // consecutive multiplications are independent of each other.
+    f2elm_t t0[EVAL_BLOCK], t1[EVAL_BLOCK];
+    unsigned int i, k, b;
+
+    COUNT_OPS(eval_4_isog, n);
+
+    for (b = 0; b * EVAL_BLOCK < n; b++)
+    {
+        f2elm_t *X = pts[b].X, *Z = pts[b].Z;
+        k = (n - b * EVAL_BLOCK < EVAL_BLOCK) ? n - b * EVAL_BLOCK : EVAL_BLOCK;
+
+        for (i = 0; i < k; i++)
+        {
+            fp2add(X[i], Z[i], t0[i]); // t0 = X+Z
+            fp2sub(X[i], Z[i], t1[i]); // t1 = X-Z
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(t0[i], coeff[1], X[i]); // X = (X+Z)*coeff[1]
+            fp2mul_mont(t1[i], coeff[2], Z[i]); // Z = (X-Z)*coeff[2]
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(t0[i], t1[i], t0[i]); // t0 = (X+Z)*(X-Z)
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(t0[i], coeff[0], t0[i]); // t0 = coeff[0]*(X+Z)*(X-Z)
+            fp2add(X[i], Z[i], t1[i]);           // t1 = (X-Z)*coeff[2] + (X+Z)*coeff[1]
+            fp2sub(X[i], Z[i], Z[i]);            // Z = (X-Z)*coeff[2] - (X+Z)*coeff[1]
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2sqr_mont(t1[i], t1[i]); // t1 = [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+            fp2sqr_mont(Z[i], Z[i]);   // Z = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2add(t1[i], t0[i], X[i]); // X = coeff[0]*(X+Z)*(X-Z) + [(X-Z)*coeff[2] + (X+Z)*coeff[1]]^2
+            fp2sub(Z[i], t0[i], t0[i]); // t0 = [(X-Z)*coeff[2] - (X+Z)*coeff[1]]^2 - coeff[0]*(X+Z)*(X-Z)
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(X[i], t1[i], X[i]); // Xfinal
+            fp2mul_mont(Z[i], t0[i], Z[i]); // Zfinal
+        }
+    }
+}
+
 void xTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2elm_t A24plus)
 { // Tripling of a Montgomery point in projective coordinates (X:Z).
     // Input: projective Montgomery x-coordinates P = (X:Z), where x=X/Z and Montgomery curve constants A24plus = A+2C and A24minus = A-2C.
     // Output: projective Montgomery x-coordinates Q = 3*P = (X3:Z3).
     f2elm_t t0, t1, t2, t3, t4, t5, t6;
 
+    COUNT_OP(xTPL);
+
     fp2sub(P->X, P->Z, t0);        // t0 = X-Z
     fp2sqr_mont(t0, t2);           // t2 = (X-Z)^2
     fp2add(P->X, P->Z, t1);        // t1 = X+Z
@@ -132,6 +191,8 @@ void get_3_isog(const point_proj_t P, f2elm_t A24minus, f2elm_t A24plus, f2elm_t
     // Output: the 3-isogenous Montgomery curve with projective coefficient A/C.
     f2elm_t t0, t1, t2, t3, t4;
 
+    COUNT_OP(get_3_isog);
+
     fp2sub(P->X, P->Z, coeff[0]);   // coeff0 = X-Z
     fp2sqr_mont(coeff[0], t0);      // t0 = (X-Z)^2
     fp2add(P->X, P->Z, coeff[1]);   // coeff1 = X+Z
@@ -161,6 +222,8 @@ void eval_3_isog(point_proj_t Q, const f2elm_t *coeff)
     // Output: the projective point Q <- phi(Q) = (X3:Z3).
     f2elm_t t0, t1, t2;
 
+    COUNT_OP(eval_3_isog);
+
     fp2add(Q->X, Q->Z, t0);        // t0 = X+Z
     fp2sub(Q->X, Q->Z, t1);        // t1 = X-Z
     fp2mul_mont(t0, coeff[0], t0); // t0 = coeff0*(X+Z)
@@ -173,12 +236,56 @@ void eval_3_isog(point_proj_t Q, const f2elm_t *coeff)
     fp2mul_mont(Q->Z, t0, Q->Z);   // Z3final = Z*[coeff0*(X-Z) - coeff1*(X+Z)]^2
 }
 
+void eval_3_isog_multi(point_block *pts, const unsigned int n, const f2elm_t *coeff)
+{ // Evaluates the 3-isogeny defined by coeff at the points 0, ..., n-1 of the array of blocks pts.
+    // Same formulas as eval_3_isog(), applied one operation at a time to all the points of a block.
+    f2elm_t t0[EVAL_BLOCK], t1[EVAL_BLOCK], t2;
+    unsigned int i, k, b;
+
+    COUNT_OPS(eval_3_isog, n);
+
+    for (b = 0; b * EVAL_BLOCK < n; b++)
+    {
+        f2elm_t *X = pts[b].X, *Z = pts[b].Z;
+        k = (n - b * EVAL_BLOCK < EVAL_BLOCK) ? n - b * EVAL_BLOCK : EVAL_BLOCK;
+
+        for (i = 0; i < k; i++)
+        {
+            fp2add(X[i], Z[i], t0[i]); // t0 = X+Z
+            fp2sub(X[i], Z[i], t1[i]); // t1 = X-Z
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(t0[i], coeff[0], t0[i]); // t0 = coeff0*(X+Z)
+            fp2mul_mont(t1[i], coeff[1], t1[i]); // t1 = coeff1*(X-Z)
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2add(t0[i], t1[i], t2);    // t2 = coeff0*(X-Z) + coeff1*(X+Z)
+            fp2sub(t1[i], t0[i], t0[i]); // t0 = coeff0*(X-Z) - coeff1*(X+Z)
+            fp2copy(t2, t1[i]);          // t1 = t2
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2sqr_mont(t1[i], t1[i]); // t1 = [coeff0*(X-Z) + coeff1*(X+Z)]^2
+            fp2sqr_mont(t0[i], t0[i]); // t0 = [coeff0*(X-Z) - coeff1*(X+Z)]^2
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(X[i], t1[i], X[i]); // X3final = X*[coeff0*(X-Z) + coeff1*(X+Z)]^2
+            fp2mul_mont(Z[i], t0[i], Z[i]); // Z3final = Z*[coeff0*(X-Z) - coeff1*(X+Z)]^2
+        }
+    }
+}
+
 void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3)
 { // 3-way simultaneous inversion
     // Input:  z1,z2,z3
     // Output: 1/z1,1/z2,1/z3 (override inputs).
     f2elm_t t0, t1, t2, t3;
 
+    COUNT_OP(inv_3_way);
+
     fp2mul_mont(z1, z2, t0); // t0 = z1*z2
     fp2mul_mont(z3, t0, t1); // t1 = z1*z2*z3
     fp2inv_mont(t1);         // t1 = 1/(z1*z2*z3)
@@ -193,28 +300,32 @@ void inv_6_way(f2elm_t z1, f2elm_t z2, f2elm_t z3, f2elm_t z4, f2elm_t z5, f2elm
 { // 6-way simultaneous inversion
     // Input:  z1,z2,z3, z4, z5, z6
     // Output: 1/z1,1/z2,1/z3,1/z4,1/z5,1/z6 (override inputs).
-    f2elm_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10;
-    fp2mul_mont(z1, z2, t0);  // t0 = z1*z2
-    fp2mul_mont(z3, t0, t1);  // t1 = z1*z2*z3
-    fp2mul_mont(z4, t1, t2);  // t2 = z1*z2*z3*z4
-    fp2mul_mont(z5, t2, t3);  // t3 = z1*z2*z3*z4*z5
-    fp2mul_mont(z6, t3, t4);  // t4 = z1*z2*z3*z4*z5*z6
-    fp2inv_mont(t4);          // t4 = 1/(z1*z2*z3*z4*z5*z6)
-    fp2mul_mont(t4, t3, t5);  // t5 = 1/z6
-    fp2mul_mont(t4, z6, t4);  // t4 = 1/(z1*z2*z3*z4*z5)
-    fp2mul_mont(t4, t2, t6);  // t6 = 1/z5
-    fp2mul_mont(t4, z5, t4);  // t4 = 1/(z1*z2*z3*z4)
-    fp2mul_mont(t4, t1, t8);  // t8 = 1/z4
-    fp2mul_mont(t4, z4, t4);  // t4 = 1/(z1*z2*z3)
-    fp2mul_mont(t4, t0, t9);  // t9 = 1/z3
-    fp2mul_mont(t4, z3, t4);  // t4 = 1/(z1*z2)
-    fp2mul_mont(t4, z2, t10); // t10 = 1/z1
-    fp2mul_mont(t4, z1, z2);  // z2 = 1/z2
-    fp2copy(t10, z1);         // z1 = 1/z1
-    fp2copy(t9, z3);          // z3 = 1/z3
-    fp2copy(t8, z4);          // z4 = 1/z4
-    fp2copy(t6, z5);          // z5 = 1/z5
-    fp2copy(t5, z6);          // z6 = 1/z6
+    // The prefix products t0..t3 are overwritten by the inverses once they are no longer needed.
+    f2elm_t t0, t1, t2, t3, t4;
+
+    COUNT_OP(inv_6_way);
+
+    fp2mul_mont(z1, z2, t0); // t0 = z1*z2
+    fp2mul_mont(z3, t0, t1); // t1 = z1*z2*z3
+    fp2mul_mont(z4, t1, t2); // t2 = z1*z2*z3*z4
+    fp2mul_mont(z5, t2, t3); // t3 = z1*z2*z3*z4*z5
+    fp2mul_mont(z6, t3, t4); // t4 = z1*z2*z3*z4*z5*z6
+    fp2inv_mont(t4);         // t4 = 1/(z1*z2*z3*z4*z5*z6)
+    fp2mul_mont(t4, t3, t3); // t3 = 1/z6
+    fp2mul_mont(t4, z6, t4); // t4 = 1/(z1*z2*z3*z4*z5)
+    fp2copy(t3, z6);         // z6 = 1/z6
+    fp2mul_mont(t4, t2, t2); // t2 = 1/z5
+    fp2mul_mont(t4, z5, t4); // t4 = 1/(z1*z2*z3*z4)
+    fp2copy(t2, z5);         // z5 = 1/z5
+    fp2mul_mont(t4, t1, t1); // t1 = 1/z4
+    fp2mul_mont(t4, z4, t4); // t4 = 1/(z1*z2*z3)
+    fp2copy(t1, z4);         // z4 = 1/z4
+    fp2mul_mont(t4, t0, t0); // t0 = 1/z3
+    fp2mul_mont(t4, z3, t4); // t4 = 1/(z1*z2)
+    fp2copy(t0, z3);         // z3 = 1/z3
+    fp2mul_mont(t4, z2, t0); // t0 = 1/z1
+    fp2mul_mont(t4, z1, z2); // z2 = 1/z2
+    fp2copy(t0, z1);         // z1 = 1/z1
 }
 
 void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
@@ -223,6 +334,8 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
     // Output: the coefficient A corresponding to the curve E_A: y^2=x^3+A*x^2+x.
     f2elm_t t0, t1, one = {0};
 
+    COUNT_OP(get_A);
+
     fpcopy((digit_t *)&Montgomery_one, one[0]);
     fp2add(xP, xQ, t1);      // t1 = xP+xQ
     fp2mul_mont(xP, xQ, t0); // t0 = xP*xQ
@@ -245,6 +358,8 @@ void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
     // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
     f2elm_t t0, t1;
 
+    COUNT_OP(j_inv);
+
     fp2sqr_mont(A, jinv);        // jinv = A^2
     fp2sqr_mont(C, t1);          // t1 = C^2
     fp2add(t1, t1, t0);          // t0 = t1+t1
@@ -269,6 +384,8 @@ void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A2
     // Output: projective Montgomery points P <- 2*P = (X2P:Z2P) such that x(2P)=X2P/Z2P, and Q <- P+Q = (XQP:ZQP) such that = x(Q+P)=XQP/ZQP.
     f2elm_t t0, t1, t2;
 
+    COUNT_OP(xDBLADD);
+
     fp2add(P->X, P->Z, t0); // t0 = XP+ZP
     fp2sub(P->X, P->Z, t1); // t1 = XP-ZP
     fp2sqr_mont(t0, P->X);  // XP = (XP+ZP)^2
@@ -296,6 +413,8 @@ void xDBLADD_AC24(point_proj_t P, point_proj_t Q, const point_proj_t PQ, const f
     // Output: projective Montgomery points P <- 2*P = (X2P:Z2P) and Q <- P+Q = (XQP:ZQP)
     f2elm_t t0, t1, t2, pz, px;
 
+    COUNT_OP(xDBLADD_AC24);
+
     fp2copy(PQ->X, px);
     fp2copy(PQ->Z, pz);
     fp2add(P->X, P->Z, t0); // t0 = XP+ZP
@@ -322,50 +441,64 @@ void xDBLADD_AC24(point_proj_t P, point_proj_t Q, const point_proj_t PQ, const f
     fp2mul_mont(Q->Z, px, Q->Z);    // ZQ = XPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
 }
 
-static void swap_points(point_proj_t P, point_proj_t Q, const digit_t option)
-{ // Swap points.
-    // If option = 0 then P <- P and Q <- Q, else if option = 0xFF...FF then P <- Q and Q <- P
-    digit_t temp;
+static __inline void ladder_swap(point_proj_t P, point_proj_t Q, const digit_t mask)
+{ // Constant-time swap of the points P and Q if mask = 0xFF...FF, no change if mask = 0.
+    digit_t *p = (digit_t *)P, *q = (digit_t *)Q, t;
     unsigned int i;
 
-    for (i = 0; i < NWORDS_FIELD; i++)
+    for (i = 0; i < sizeof(point_proj) / sizeof(digit_t); i++)
     {
-        temp = option & (P->X[0][i] ^ Q->X[0][i]);
-        P->X[0][i] = temp ^ P->X[0][i];
-        Q->X[0][i] = temp ^ Q->X[0][i];
-        temp = option & (P->Z[0][i] ^ Q->Z[0][i]);
-        P->Z[0][i] = temp ^ P->Z[0][i];
-        Q->Z[0][i] = temp ^ Q->Z[0][i];
-        temp = option & (P->X[1][i] ^ Q->X[1][i]);
-        P->X[1][i] = temp ^ P->X[1][i];
-        Q->X[1][i] = temp ^ Q->X[1][i];
-        temp = option & (P->Z[1][i] ^ Q->Z[1][i]);
-        P->Z[1][i] = temp ^ P->Z[1][i];
-        Q->Z[1][i] = temp ^ Q->Z[1][i];
+        t = mask & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
     }
 }
 
-void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t *m, const unsigned int AliceOrBobOrEve, point_proj_t R, const f2elm_t A)
-{
-    point_proj_t R0 = {0}, R2 = {0};
-    f2elm_t A24 = {0};
-    digit_t mask;
-    int i, nbits, bit, swap, prevbit = 0;
+static __inline void ladder_step(point_proj_t R0, point_proj_t R2, point_proj_t R, const f2elm_t A24, const digit_t mask)
+{ // One step of the 3-point ladder: R and R2 are swapped if mask = 0xFF...FF, then R0 <- 2*R0 and R2 <- R0+R2, where R = R2-R0.
+    // Fuses the swap, xDBLADD() and the multiplication by ZR of the projective difference, with the intermediate values in
+    // local variables and each coordinate of R0 and R2 written once. A24 = NULL selects the base curve E0, where A24 = 1/2.
+    f2elm_t t0, t1, t2, t3, x2, z2;
 
-    if (AliceOrBobOrEve == ALICE)
-    {
-        nbits = OALICE_BITS;
-    }
-    else if (AliceOrBobOrEve == BOB)
+    COUNT_OP(xDBLADD);
+
+    ladder_swap(R, R2, mask);
+    fp2add(R0->X, R0->Z, t0); // t0 = X0+Z0
+    fp2sub(R0->X, R0->Z, t1); // t1 = X0-Z0
+    fp2sub(R2->X, R2->Z, t2); // t2 = X2-Z2
+    fp2correction(t2);
+    fp2add(R2->X, R2->Z, t3); // t3 = X2+Z2
+    fp2sqr_mont(t0, x2);      // x2 = (X0+Z0)^2
+    fp2sqr_mont(t1, z2);      // z2 = (X0-Z0)^2
+    fp2mul_mont(t0, t2, t0);  // t0 = (X0+Z0)*(X2-Z2)
+    fp2mul_mont(t1, t3, t1);  // t1 = (X0-Z0)*(X2+Z2)
+    fp2sub(x2, z2, t2);       // t2 = (X0+Z0)^2-(X0-Z0)^2
+    fp2mul_mont(x2, z2, R0->X); // X0 = (X0+Z0)^2*(X0-Z0)^2
+    if (A24 == NULL)
     {
-        nbits = OBOB_BITS;
+        fp2div2(t2, t3); // t3 = [(X0+Z0)^2-(X0-Z0)^2]/2
     }
     else
     {
-        nbits = OEVE_BITS;
+        fp2mul_mont(t2, A24, t3); // t3 = A24*[(X0+Z0)^2-(X0-Z0)^2]
     }
+    fp2add(t3, z2, z2);         // z2 = A24*[(X0+Z0)^2-(X0-Z0)^2]+(X0-Z0)^2
+    fp2mul_mont(z2, t2, R0->Z); // Z0 = [A24*[(X0+Z0)^2-(X0-Z0)^2]+(X0-Z0)^2]*[(X0+Z0)^2-(X0-Z0)^2]
+    fp2add(t0, t1, x2);         // x2 = (X0+Z0)*(X2-Z2)+(X0-Z0)*(X2+Z2)
+    fp2sub(t0, t1, z2);         // z2 = (X0+Z0)*(X2-Z2)-(X0-Z0)*(X2+Z2)
+    fp2sqr_mont(x2, x2);
+    fp2sqr_mont(z2, z2);
+    fp2mul_mont(x2, R->Z, R2->X); // X2 = ZR*[(X0+Z0)*(X2-Z2)+(X0-Z0)*(X2+Z2)]^2
+    fp2mul_mont(z2, R->X, R2->Z); // Z2 = XR*[(X0+Z0)*(X2-Z2)-(X0-Z0)*(X2+Z2)]^2
+}
+
+void LADDER3PT_init(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const f2elm_t A, point_proj_t R0, point_proj_t R2, point_proj_t R, f2elm_t A24)
+{ // Initialization of the 3-point ladder state.
+    // Input:  affine x-coordinates xP, xQ and xPQ of the basis points and the curve coefficient A.
+    // Output: projective ladder points R0 = (xQ:1), R2 = (xPQ:1), R = (xP:1) and the constant A24 = (A+2)/4.
 
     // Initializing constant
+    fp2zero(A24);
     fpcopy((digit_t *)&Montgomery_one, A24[0]);
     fp2add(A24, A24, A24);
     fp2add(A, A24, A24);
@@ -374,25 +507,62 @@ void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digi
 
     // Initializing points
     fp2copy(xQ, R0->X);
+    fp2zero(R0->Z);
     fpcopy((digit_t *)&Montgomery_one, (digit_t *)R0->Z);
     fp2copy(xPQ, R2->X);
+    fp2zero(R2->Z);
     fpcopy((digit_t *)&Montgomery_one, (digit_t *)R2->Z);
     fp2copy(xP, R->X);
     fpcopy((digit_t *)&Montgomery_one, (digit_t *)R->Z);
     fpzero((digit_t *)(R->Z)[1]);
+}
+
+void LADDER3PT_bits(const digit_t *m, const unsigned int first, const unsigned int last, point_proj_t R0, point_proj_t R2, point_proj_t R, const f2elm_t A24)
+{ // Processes the bits first, ..., last-1 of the scalar m on a ladder state set up by LADDER3PT_init().
+    // The ladder can be advanced in several calls as long as consecutive calls cover consecutive bit ranges.
+    // A24 = NULL runs the ladder on E0.
+    digit_t mask;
+    unsigned int i;
+    int bit, swap, prevbit = 0;
+
+    if (first > 0)
+    {
+        prevbit = (m[(first - 1) >> LOG2RADIX] >> ((first - 1) & (RADIX - 1))) & 1;
+    }
 
     // Main loop
-    for (i = 0; i < nbits; i++)
+    for (i = first; i < last; i++)
     {
         bit = (m[i >> LOG2RADIX] >> (i & (RADIX - 1))) & 1;
         swap = bit ^ prevbit;
         prevbit = bit;
         mask = 0 - (digit_t)swap;
 
-        swap_points(R, R2, mask);
-        xDBLADD(R0, R2, R->X, A24);
-        fp2mul_mont(R2->X, R->Z, R2->X);
+        ladder_step(R0, R2, R, A24, mask);
+    }
+}
+
+void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t *m, const unsigned int AliceOrBobOrEve, point_proj_t R, const f2elm_t A)
+{
+    point_proj_t R0 = {0}, R2 = {0};
+    f2elm_t A24 = {0};
+    unsigned int nbits;
+
+    if (AliceOrBobOrEve == ALICE)
+    {
+        nbits = OALICE_BITS;
+    }
+    else if (AliceOrBobOrEve == BOB)
+    {
+        nbits = OBOB_BITS;
     }
+    else
+    {
+        nbits = OEVE_BITS;
+    }
+
+    LADDER3PT_init(xP, xQ, xPQ, A, R0, R2, R, A24);
+    LADDER3PT_bits(m, 0, nbits, R0, R2, R, A24);
 }
 
 void xQNTPL(const point_proj_t P, point_proj_t R, const f2elm_t A24plus, const f2elm_t C24)
@@ -401,6 +571,8 @@ void xQNTPL(const point_proj_t P, point_proj_t R, const f2elm_t A24plus, const f
     // output: a projective point Q, where Q = [5]P
     point_proj_t Q, R0;
 
+    COUNT_OP(xQNTPL);
+
     fp2copy(P->X, R0->X);
     fp2copy(P->Z, R0->Z);
     xDBL(R0, Q, A24plus, C24);            // Q = 2*P
@@ -428,6 +600,8 @@ void eval_5_isog(const point_proj_t P, const point_proj_t Pdbl, point_proj_t Q)
     // Output: the image of the point Q on the isogenous curve Q <- phi5(Q)
     f2elm_t X_hat, Z_hat, t0, t1, t2, t3, t4, t5;
 
+    COUNT_OP(eval_5_isog);
+
     fp2add(P->X, P->Z, t2);
     fp2sub(P->X, P->Z, t3);
     fp2add(Pdbl->X, Pdbl->Z, t4);
@@ -444,12 +618,81 @@ void eval_5_isog(const point_proj_t P, const point_proj_t Pdbl, point_proj_t Q)
     fp2mul_mont(t1, Q->Z, Q->Z);
 }
 
+void eval_5_isog_multi(const point_proj_t P, const point_proj_t Pdbl, point_block *pts, const unsigned int n)
+{ // Evaluates the 5-isogeny with kernel <P>, where Pdbl = [2]P, at the points 0, ..., n-1 of the array of blocks pts.
+    // Same formulas as eval_5_isog(), the sums and differences of the kernel points are computed once for all points
+    // and the criss cross products are applied one operation at a time to all the points of a block.
+    f2elm_t p0, p1, d0, d1, t;
+    f2elm_t X_hat[EVAL_BLOCK], Z_hat[EVAL_BLOCK], u0[EVAL_BLOCK], u1[EVAL_BLOCK];
+    unsigned int i, k, b;
+
+    COUNT_OPS(eval_5_isog, n);
+
+    fp2add(P->X, P->Z, p0);
+    fp2sub(P->X, P->Z, p1);
+    fp2add(Pdbl->X, Pdbl->Z, d0);
+    fp2sub(Pdbl->X, Pdbl->Z, d1);
+
+    for (b = 0; b * EVAL_BLOCK < n; b++)
+    {
+        f2elm_t *X = pts[b].X, *Z = pts[b].Z;
+        k = (n - b * EVAL_BLOCK < EVAL_BLOCK) ? n - b * EVAL_BLOCK : EVAL_BLOCK;
+
+        for (i = 0; i < k; i++)
+        {
+            fp2add(X[i], Z[i], X_hat[i]);
+            fp2sub(X[i], Z[i], Z_hat[i]);
+        }
+        // criss_cross(p0, p1, X_hat, Z_hat) into u0, u1
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(p0, Z_hat[i], u0[i]);
+            fp2mul_mont(p1, X_hat[i], u1[i]);
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2add(u0[i], u1[i], t);
+            fp2sub(u0[i], u1[i], u1[i]);
+            fp2copy(t, u0[i]);
+        }
+        // criss_cross(d0, d1, X_hat, Z_hat) in place
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(d0, Z_hat[i], Z_hat[i]);
+            fp2mul_mont(d1, X_hat[i], X_hat[i]);
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2add(Z_hat[i], X_hat[i], t);
+            fp2sub(Z_hat[i], X_hat[i], Z_hat[i]);
+            fp2copy(t, X_hat[i]);
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(X_hat[i], u0[i], u0[i]);
+            fp2mul_mont(Z_hat[i], u1[i], u1[i]);
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2sqr_mont(u0[i], u0[i]);
+            fp2sqr_mont(u1[i], u1[i]);
+        }
+        for (i = 0; i < k; i++)
+        {
+            fp2mul_mont(u0[i], X[i], X[i]);
+            fp2mul_mont(u1[i], Z[i], Z[i]);
+        }
+    }
+}
+
 void get_a_from_alpha(const point_proj_t alpha, f2elm_t A24plus, f2elm_t C24)
 { // Compute the curve coefficient A24plus = (A + 2C) and C24 = 4C using
     // 2-torsion point alpha on the curve E. This function is used to retrieve
     // curve coefficients from the image of 2-torsion points on the new curve
     // Input: the projective coordinates of alpha
     // Output: Curve coefficients Aplus = (A + 2C), C24 = 4C
+    COUNT_OP(get_a_from_alpha);
+
     fp2sub(alpha->X, alpha->Z, A24plus); // A24plus = (Xalpha - Zalpha)
     fp2sqr_mont(A24plus, A24plus);       // A24plus = (Xalpha - Zalpha)^2
     fp2correction(A24plus);
@@ -464,6 +707,9 @@ void get_A_projective(const point_proj_t P, const point_proj_t Q, const point_pr
     // three projective points P, Q, and R where R = Q - P
     // This is the projective version of get_A function
     f2elm_t t0, t1, t2, t3, t4, t5, t6, t7, t8;
+
+    COUNT_OP(get_A_projective);
+
     fp2mul_mont(P->X, Q->X, t0); // t0 = XP*XQ
     fp2mul_mont(t0, R->X, t0);   // t0 = XP*XQ*XR
     fp2mul_mont(P->Z, Q->Z, t1); // t1 = ZP*ZQ
@@ -510,3 +756,142 @@ void xQNTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const
         xQNTPL(Q, Q, A24plus, C24);
     }
 }
+
+// Formulas on the base curve E0: y^2 = x^3 + x, where A = 0 and C = 1. The curve constants of the generic formulas are
+// A24plus = 1 and C24 = 2 for doublings and quintuplings, A24plus = 2 and A24minus = -2 for triplings, and A24 = 1/2 in the ladder.
+// The products by these constants become additions, copies or halvings. The outputs are the same projective points.
+
+static void xDBL_E0(const point_proj_t P, point_proj_t Q)
+{ // Doubling of a Montgomery point on E0 in projective coordinates (X:Z), Q = 2*P.
+    f2elm_t t0, t1;
+
+    COUNT_OP(xDBL);
+
+    fp2sub(P->X, P->Z, t0);      // t0 = X1-Z1
+    fp2add(P->X, P->Z, t1);      // t1 = X1+Z1
+    fp2sqr_mont(t0, t0);         // t0 = (X1-Z1)^2
+    fp2sqr_mont(t1, t1);         // t1 = (X1+Z1)^2
+    fp2add(t0, t0, Q->Z);        // Z2 = 2*(X1-Z1)^2
+    fp2mul_mont(t1, Q->Z, Q->X); // X2 = 2*(X1-Z1)^2*(X1+Z1)^2
+    fp2sub(t1, t0, t1);          // t1 = (X1+Z1)^2-(X1-Z1)^2
+    fp2add(Q->Z, t1, Q->Z);      // Z2 = [(X1+Z1)^2-(X1-Z1)^2] + 2*(X1-Z1)^2
+    fp2mul_mont(Q->Z, t1, Q->Z); // Z2 = [[(X1+Z1)^2-(X1-Z1)^2] + 2*(X1-Z1)^2]*[(X1+Z1)^2-(X1-Z1)^2]
+}
+
+void xDBLe_E0(const point_proj_t P, point_proj_t Q, const int e)
+{ // Computes [2^e](X:Z) on E0 via e repeated doublings.
+    int i;
+
+    copy_words((digit_t *)P, (digit_t *)Q, 2 * 2 * NWORDS_FIELD);
+
+    for (i = 0; i < e; i++)
+    {
+        xDBL_E0(Q, Q);
+    }
+}
+
+static void xTPL_E0(const point_proj_t P, point_proj_t Q)
+{ // Tripling of a Montgomery point on E0 in projective coordinates (X:Z), Q = 3*P.
+    // With A24plus = 2 and A24minus = -2, the term A24minus*(X-Z)^4 - A24plus*(X+Z)^4 of xTPL() is -t3 below.
+    f2elm_t t0, t1, t2, t3, t4, t5, t6;
+
+    COUNT_OP(xTPL);
+
+    fp2sub(P->X, P->Z, t0);  // t0 = X-Z
+    fp2sqr_mont(t0, t2);     // t2 = (X-Z)^2
+    fp2add(P->X, P->Z, t1);  // t1 = X+Z
+    fp2sqr_mont(t1, t3);     // t3 = (X+Z)^2
+    fp2add(t0, t1, t4);      // t4 = 2*X
+    fp2sub(t1, t0, t0);      // t0 = 2*Z
+    fp2sqr_mont(t4, t1);     // t1 = 4*X^2
+    fp2sub(t1, t3, t1);      // t1 = 4*X^2 - (X+Z)^2
+    fp2sub(t1, t2, t1);      // t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
+    fp2add(t3, t3, t5);      // t5 = 2*(X+Z)^2
+    fp2mul_mont(t3, t5, t3); // t3 = 2*(X+Z)^4
+    fp2add(t2, t2, t6);      // t6 = 2*(X-Z)^2
+    fp2mul_mont(t2, t6, t2); // t2 = 2*(X-Z)^4
+    fp2add(t2, t3, t3);      // t3 = 2*(X-Z)^4 + 2*(X+Z)^4
+    fp2add(t5, t6, t2);      // t2 = 2*(X+Z)^2 + 2*(X-Z)^2
+    fp2mul_mont(t1, t2, t1); // t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[2*(X+Z)^2 + 2*(X-Z)^2]
+    fp2sub(t1, t3, t2);      // t2 = t1 - t3
+    fp2sqr_mont(t2, t2);     // t2 = t2^2
+    fp2mul_mont(t4, t2, Q->X); // X3 = 2*X*t2
+    fp2add(t3, t1, t1);      // t1 = t3 + t1
+    fp2sqr_mont(t1, t1);     // t1 = t1^2
+    fp2mul_mont(t0, t1, Q->Z); // Z3 = 2*Z*t1
+}
+
+void xTPLe_E0(const point_proj_t P, point_proj_t Q, const int e)
+{ // Computes [3^e](X:Z) on E0 via e repeated triplings.
+    int i;
+
+    copy_words((digit_t *)P, (digit_t *)Q, 2 * 2 * NWORDS_FIELD);
+
+    for (i = 0; i < e; i++)
+    {
+        xTPL_E0(Q, Q);
+    }
+}
+
+static void xDBLADD_AC24_E0(point_proj_t P, point_proj_t Q, const point_proj_t PQ)
+{ // Simultaneous doubling and differential addition on E0, P <- 2*P and Q <- P+Q, where PQ = Q - P.
+    f2elm_t t0, t1, t2, pz, px;
+
+    COUNT_OP(xDBLADD_AC24);
+
+    fp2copy(PQ->X, px);
+    fp2copy(PQ->Z, pz);
+    fp2add(P->X, P->Z, t0); // t0 = XP+ZP
+    fp2sub(P->X, P->Z, t1); // t1 = XP-ZP
+    fp2sqr_mont(t0, P->X);  // XP = (XP+ZP)^2
+    fp2sub(Q->X, Q->Z, t2); // t2 = XQ-ZQ
+    fp2correction(t2);
+    fp2add(Q->X, Q->Z, Q->X);      // XQ = XQ+ZQ
+    fp2mul_mont(t0, t2, t0);       // t0 = (XP+ZP)*(XQ-ZQ)
+    fp2sqr_mont(t1, P->Z);         // ZP = (XP-ZP)^2
+    fp2mul_mont(t1, Q->X, t1);     // t1 = (XP-ZP)*(XQ+ZQ)
+    fp2sub(P->X, P->Z, t2);        // t2 = (XP+ZP)^2-(XP-ZP)^2
+    fp2mul_mont(P->X, P->Z, P->X); // XP = (XP+ZP)^2*(XP-ZP)^2
+    fp2add(P->X, P->X, P->X);      // XP = 2*(XP+ZP)^2*(XP-ZP)^2
+    fp2sub(t0, t1, Q->Z);          // ZQ = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    fp2add(P->Z, P->Z, P->Z);      // ZP = 2*(XP-ZP)^2
+    fp2add(t2, P->Z, P->Z);        // ZP = [(XP+ZP)^2-(XP-ZP)^2]+2*(XP-ZP)^2
+    fp2add(t0, t1, Q->X);          // XQ = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    fp2mul_mont(P->Z, t2, P->Z);   // ZP = [[(XP+ZP)^2-(XP-ZP)^2]+2*(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+    fp2sqr_mont(Q->Z, Q->Z);       // ZQ = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2sqr_mont(Q->X, Q->X);       // XQ = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(Q->X, pz, Q->X);   // XQ = ZPQ*[(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(Q->Z, px, Q->Z);   // ZQ = XPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+}
+
+static void xQNTPL_E0(const point_proj_t P, point_proj_t R)
+{ // Quintupling of a Montgomery point on E0, R = [5]P
+    point_proj_t Q, R0;
+
+    COUNT_OP(xQNTPL);
+
+    fp2copy(P->X, R0->X);
+    fp2copy(P->Z, R0->Z);
+    xDBL_E0(R0, Q);            // Q = 2*P
+    xDBLADD_AC24_E0(R0, Q, P); // R0 = 2*P, Q = 3*P
+    xDBLADD_AC24_E0(R0, Q, P); // R0 = 4*P, Q = 5*P
+    fp2copy(Q->X, R->X);
+    fp2copy(Q->Z, R->Z);
+}
+
+void xQNTPLe_E0(const point_proj_t P, point_proj_t Q, const int e)
+{ // Computes [5^e](X:Z) on E0 via e repeated quintuplings.
+    int i;
+
+    copy_words((digit_t *)P, (digit_t *)Q, 2 * 2 * NWORDS_FIELD);
+
+    for (i = 0; i < e; i++)
+    {
+        xQNTPL_E0(Q, Q);
+    }
+}
+
+void LADDER3PT_bits_E0(const digit_t *m, const unsigned int first, const unsigned int last, point_proj_t R0, point_proj_t R2, point_proj_t R)
+{ // Processes the bits first, ..., last-1 of the scalar m on a ladder state of E0 set up by LADDER3PT_init(), see LADDER3PT_bits().
+    LADDER3PT_bits(m, first, last, R0, R2, R, NULL);
+}
@@ -3,12 +3,12 @@
 *
 * Abstract: core functions over GF(p) and GF(p^2)
 * This file is the modified version of fpx.c from the SIKE library developed by Microsoft Research
-* The modifications are based on the p747 prime
+* The modifications are based on the p747 prime. The file is included by each parameter set, see sigk_internal.h
 *
 * Modified by Amir Jalali               ajalali2016@fau.edu
 *********************************************************************************************/
 
-#include "P747_internal.h"
+#include "sigk_internal.h"
 
 __inline void fpcopy(const felm_t a, felm_t c)
 { // Copy a field element, c = a.
@@ -37,10 +37,11 @@ void to_mont(const felm_t a, felm_t mc)
 void from_mont(const felm_t ma, felm_t c)
 {   // Conversion from Montgomery representation to standard representation,
     // c = ma*R^(-1) mod p = a mod p, where ma in [0, p-1].
-    digit_t one[NWORDS_FIELD] = {0};
+    // The product of ma by 1 is ma itself, so that the conversion is the Montgomery reduction of ma alone.
+    dfelm_t t = {0};
 
-    one[0] = 1;
-    fpmul_mont(ma, one, c);
+    fpcopy(ma, t);
+    rdc_mont(t, c);
     fpcorrection(c);
 }
 
@@ -58,6 +59,8 @@ void fpmul_mont(const felm_t ma, const felm_t mb, felm_t mc)
 { // Multiprecision multiplication, c = a*b mod p.
     dfelm_t temp = {0};
 
+    COUNT_OP(fpmul);
+
     mp_mul(ma, mb, temp, NWORDS_FIELD);
     rdc_mont(temp, mc);
 }
@@ -66,6 +69,8 @@ void fpsqr_mont(const felm_t ma, felm_t mc)
 { // Multiprecision squaring, c = a^2 mod p.
     dfelm_t temp = {0};
 
+    COUNT_OP(fpsqr);
+
     mp_mul(ma, ma, temp, NWORDS_FIELD);
     rdc_mont(temp, mc);
 }
@@ -137,6 +142,8 @@ void fp2sqr_mont(const f2elm_t a, f2elm_t c)
     // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1]
     felm_t t1, t2, t3;
 
+    COUNT_OP(fp2sqr);
+
     mp_addfast(a[0], a[1], t1); // t1 = a0+a1
     fpsub(a[0], a[1], t2);      // t2 = a0-a1
     mp_addfast(a[0], a[0], t3); // t3 = 2a0
@@ -172,6 +179,22 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
     digit_t mask;
     unsigned int i, borrow = 0;
 
+    COUNT_OP(fp2mul);
+
+#if defined(SIGK_FP2_PRODUCTS)  // The backend computes the three products side by side
+    mp_addfast(a[0], a[1], t1);            // t1 = a0+a1
+    mp_addfast(b[0], b[1], t2);            // t2 = b0+b1
+    mp_mul_x3(a[0], b[0], a[1], b[1], t1, t2, tt1, tt2, tt3); // tt1 = a0*b0, tt2 = a1*b1, tt3 = (a0+a1)*(b0+b1)
+    mp_subfast(tt3, tt1, tt3);             // tt3 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mp_subfast(tt3, tt2, tt3);
+    rdc_mont(tt3, c[1]);                   // c[1] = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mask = mp_subfast(tt1, tt2, tt3);      // tt3 = a0*b0 - a1*b1. If tt3 < 0 then mask = 0xFF..F, else if tt3 >= 0 then mask = 0x00..0
+    for (i = 0; i < NWORDS_FIELD; i++)
+    {
+        ADDC(borrow, tt3[NWORDS_FIELD + i], ((digit_t *)PRIME)[i] & mask, borrow, tt3[NWORDS_FIELD + i]);
+    }
+    rdc_mont(tt3, c[0]);                   // c[0] = a0*b0 - a1*b1
+#else
     mp_mul(a[0], b[0], tt1, NWORDS_FIELD); // tt1 = a0*b0
     mp_mul(a[1], b[1], tt2, NWORDS_FIELD); // tt2 = a1*b1
     mp_addfast(a[0], a[1], t1);            // t1 = a0+a1
@@ -186,13 +209,17 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
     mp_mul(t1, t2, tt2, NWORDS_FIELD); // tt2 = (a0+a1)*(b0+b1)
     mp_subfast(tt2, tt1, tt2);         // tt2 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
     rdc_mont(tt2, c[1]);               // c[1] = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+#endif
 }
 
 void fpinv_chain_mont(felm_t a)
 { // Chain to compute a^(p-2) using Montgomery arithmetic.
     unsigned int i, j;
+#if (NBITS_FIELD == 747)
     felm_t t[29], tt;
 
+    COUNT_OP(fpinv);
+
     // Precomputed table
     fpsqr_mont(a, tt);
     fpmul_mont(a, tt, t[0]);
@@ -423,6 +450,133 @@ void fpinv_chain_mont(felm_t a)
     for (i = 0; i < 4; i++)
         fpsqr_mont(tt, tt);
     fpmul_mont(t[4], tt, tt);
+#elif (NBITS_FIELD == 376)
+    felm_t t[31], tt;
+
+    COUNT_OP(fpinv);
+
+    // Precomputed table
+    fpsqr_mont(a, tt);
+    fpmul_mont(a, tt, t[0]);
+    for (i = 0; i <= 29; i++)
+        fpmul_mont(t[i], tt, t[i + 1]);
+
+    fpcopy(t[21], tt);
+    for (i = 0; i < 7; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[28], tt, tt);
+    for (i = 0; i < 3; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 10; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[22], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[30], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[20], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[18], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[12], tt, tt);
+    for (i = 0; i < 7; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[10], tt, tt);
+    for (i = 0; i < 2; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 11; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[26], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[18], tt, tt);
+    for (i = 0; i < 5; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[8], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[21], tt, tt);
+    for (i = 0; i < 4; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[6], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[25], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[11], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[16], tt, tt);
+    for (i = 0; i < 8; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[28], tt, tt);
+    for (i = 0; i < 4; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[3], tt, tt);
+    for (i = 0; i < 5; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(a, tt, tt);
+    for (i = 0; i < 15; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[30], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[25], tt, tt);
+    for (i = 0; i < 5; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 7; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[21], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[14], tt, tt);
+    for (i = 0; i < 6; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+    for (i = 0; i < 10; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[22], tt, tt);
+    for (i = 0; i < 11; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[28], tt, tt);
+    for (i = 0; i < 5; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 10; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[19], tt, tt);
+    for (i = 0; i < 3; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[2], tt, tt);
+    for (i = 0; i < 9; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[25], tt, tt);
+    for (j = 0; j < 20; j++)
+    {
+        for (i = 0; i < 6; i++)
+            fpsqr_mont(tt, tt);
+        fpmul_mont(t[30], tt, tt);
+    }
+    for (i = 0; i < 5; i++)
+        fpsqr_mont(tt, tt);
+    fpmul_mont(t[13], tt, tt);
+#endif
 
     fpcopy(tt, a);
 }
@@ -431,6 +585,8 @@ void fp2inv_mont(f2elm_t a)
 { // GF(p^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2).
     f2elm_t t1;
 
+    COUNT_OP(fp2inv);
+
     fpsqr_mont(a[0], t1[0]);    // t10 = a0^2
     fpsqr_mont(a[1], t1[1]);    // t11 = a1^2
     fpadd(t1[0], t1[1], t1[0]); // t10 = a0^2+a1^2
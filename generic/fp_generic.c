@@ -1,50 +1,47 @@
 /********************************************************************************************
 * Supersingular Isogeny Group Key Agreement Library
 *
-* Abstract: portable modular arithmetic for P747
+* Abstract: portable modular arithmetic
 * This file is copied from the SIKE library developed by Microsoft Research.
+* It is included by the file of each parameter set, after the constants PRIME, PRIMEp1 and PRIMEx2 of the set.
 *********************************************************************************************/
 
-#include "../P747_internal.h"
 
-
-// Global constants
-extern const uint64_t p747[NWORDS_FIELD];
-extern const uint64_t p747p1[NWORDS_FIELD]; 
-extern const uint64_t p747x2[NWORDS_FIELD]; 
-
-
-__inline void fpadd747(const digit_t* a, const digit_t* b, digit_t* c)
-{ // Modular addition, c = a+b mod p747.
-  // Inputs: a, b in [0, 2*p747-1] 
-  // Output: c in [0, 2*p747-1] 
+__inline void fpadd(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Modular addition, c = a+b mod p.
+  // Inputs: a, b in [0, 2*p-1] 
+  // Output: c in [0, 2*p-1] 
     unsigned int i, carry = 0;
     digit_t mask;
 
+    COUNT_OP(fpadd);
+
     for (i = 0; i < NWORDS_FIELD; i++) {
         ADDC(carry, a[i], b[i], carry, c[i]); 
     }
 
     carry = 0;
     for (i = 0; i < NWORDS_FIELD; i++) {
-        SUBC(carry, c[i], ((digit_t*)p747x2)[i], carry, c[i]); 
+        SUBC(carry, c[i], ((digit_t*)PRIMEx2)[i], carry, c[i]); 
     }
     mask = 0 - (digit_t)carry;
 
     carry = 0;
     for (i = 0; i < NWORDS_FIELD; i++) {
-        ADDC(carry, c[i], ((digit_t*)p747x2)[i] & mask, carry, c[i]); 
+        ADDC(carry, c[i], ((digit_t*)PRIMEx2)[i] & mask, carry, c[i]); 
     }
 } 
 
 
-__inline void fpsub747(const digit_t* a, const digit_t* b, digit_t* c)
-{ // Modular subtraction, c = a-b mod p747.
-  // Inputs: a, b in [0, 2*p747-1] 
-  // Output: c in [0, 2*p747-1] 
+__inline void fpsub(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Modular subtraction, c = a-b mod p.
+  // Inputs: a, b in [0, 2*p-1] 
+  // Output: c in [0, 2*p-1] 
     unsigned int i, borrow = 0;
     digit_t mask;
 
+    COUNT_OP(fpsub);
+
     for (i = 0; i < NWORDS_FIELD; i++) {
         SUBC(borrow, a[i], b[i], borrow, c[i]); 
     }
@@ -52,51 +49,51 @@ __inline void fpsub747(const digit_t* a, const digit_t* b, digit_t* c)
 
     borrow = 0;
     for (i = 0; i < NWORDS_FIELD; i++) {
-        ADDC(borrow, c[i], ((digit_t*)p747x2)[i] & mask, borrow, c[i]); 
+        ADDC(borrow, c[i], ((digit_t*)PRIMEx2)[i] & mask, borrow, c[i]); 
     }
 }
 
 
-__inline void fpneg747(digit_t* a)
-{ // Modular negation, a = -a mod p747.
-  // Input/output: a in [0, 2*p747-1] 
+__inline void fpneg(digit_t* a)
+{ // Modular negation, a = -a mod p.
+  // Input/output: a in [0, 2*p-1] 
     unsigned int i, borrow = 0;
 
     for (i = 0; i < NWORDS_FIELD; i++) {
-        SUBC(borrow, ((digit_t*)p747x2)[i], a[i], borrow, a[i]); 
+        SUBC(borrow, ((digit_t*)PRIMEx2)[i], a[i], borrow, a[i]); 
     }
 }
 
 
-void fpdiv2_747(const digit_t* a, digit_t* c)
-{ // Modular division by two, c = a/2 mod p747.
-  // Input : a in [0, 2*p747-1] 
-  // Output: c in [0, 2*p747-1] 
+void fpdiv2(const digit_t* a, digit_t* c)
+{ // Modular division by two, c = a/2 mod p.
+  // Input : a in [0, 2*p-1] 
+  // Output: c in [0, 2*p-1] 
     unsigned int i, carry = 0;
     digit_t mask;
         
-    mask = 0 - (digit_t)(a[0] & 1);    // If a is odd compute a+p747
+    mask = 0 - (digit_t)(a[0] & 1);    // If a is odd compute a+p
     for (i = 0; i < NWORDS_FIELD; i++) {
-        ADDC(carry, a[i], ((digit_t*)p747)[i] & mask, carry, c[i]); 
+        ADDC(carry, a[i], ((digit_t*)PRIME)[i] & mask, carry, c[i]); 
     }
 
     mp_shiftr1(c, NWORDS_FIELD);
 } 
 
 
-void fpcorrection747(digit_t* a)
-{ // Modular correction to reduce field element a in [0, 2*p747-1] to [0, p747-1].
+void fpcorrection(digit_t* a)
+{ // Modular correction to reduce field element a in [0, 2*p-1] to [0, p-1].
     unsigned int i, borrow = 0;
     digit_t mask;
 
     for (i = 0; i < NWORDS_FIELD; i++) {
-        SUBC(borrow, a[i], ((digit_t*)p747)[i], borrow, a[i]); 
+        SUBC(borrow, a[i], ((digit_t*)PRIME)[i], borrow, a[i]); 
     }
     mask = 0 - (digit_t)borrow;
 
     borrow = 0;
     for (i = 0; i < NWORDS_FIELD; i++) {
-        ADDC(borrow, a[i], ((digit_t*)p747)[i] & mask, borrow, a[i]); 
+        ADDC(borrow, a[i], ((digit_t*)PRIME)[i] & mask, borrow, a[i]); 
     }
 }
 
@@ -134,12 +131,16 @@ void digit_x_digit(const digit_t a, const digit_t b, digit_t* c)
     c[1] ^= (ahbh & mask_high) + carry;       // C11
 }
 
+#if !defined(SIGK_FP_MUL_RDC)    // Backends defining SIGK_FP_MUL_RDC provide their own multiplication and reduction
+
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision comba multiply, c = a*b, where lng(a) = lng(b) = nwords.   
     unsigned int i, j;
     digit_t t = 0, u = 0, v = 0, UV[2];
     unsigned int carry = 0;
     
+    COUNT_OP(mp_mul);
+
     for (i = 0; i < nwords; i++) {
         for (j = 0; j <= i; j++) {
             MUL(a[j], b[i-j], UV+1, UV[0]); 
@@ -170,21 +171,23 @@ void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int n
 
 
 void rdc_mont(const dfelm_t ma, felm_t mc)
-{ // Efficient Montgomery reduction using comba and exploiting the special form of the prime p747.
-  // mc = ma*R^-1 mod p747x2, where R = 2^768.
-  // If ma < 2^768*p747, the output mc is in the range [0, 2*p747-1].
+{ // Efficient Montgomery reduction using comba and exploiting the special form of the prime p.
+  // mc = ma*R^-1 mod 2p, where R = 2^(RADIX*NWORDS_FIELD).
+  // If ma < 2^(RADIX*NWORDS_FIELD)*p, the output mc is in the range [0, 2*p-1].
   // ma is assumed to be in Montgomery representation.
-    unsigned int i, j, carry, count = p747_ZERO_WORDS;
+    unsigned int i, j, carry, count = PRIME_ZERO_WORDS;
     digit_t UV[2], t = 0, u = 0, v = 0;
 
+    COUNT_OP(rdc_mont);
+
     for (i = 0; i < NWORDS_FIELD; i++) {
         mc[i] = 0;
     }
 
     for (i = 0; i < NWORDS_FIELD; i++) {
         for (j = 0; j < i; j++) {
-            if (j < (i-p747_ZERO_WORDS+1)) { 
-                MUL(mc[j], ((digit_t*)p747p1)[i-j], UV+1, UV[0]);
+            if (j < (i-PRIME_ZERO_WORDS+1)) { 
+                MUL(mc[j], ((digit_t*)PRIMEp1)[i-j], UV+1, UV[0]);
                 ADDC(0, UV[0], v, carry, v); 
                 ADDC(carry, UV[1], u, carry, u); 
                 t += carry; 
@@ -205,7 +208,7 @@ void rdc_mont(const dfelm_t ma, felm_t mc)
         }
         for (j = i-NWORDS_FIELD+1; j < NWORDS_FIELD; j++) {
             if (j < (NWORDS_FIELD-count)) { 
-                MUL(mc[j], ((digit_t*)p747p1)[i-j], UV+1, UV[0]);
+                MUL(mc[j], ((digit_t*)PRIMEp1)[i-j], UV+1, UV[0]);
                 ADDC(0, UV[0], v, carry, v); 
                 ADDC(carry, UV[1], u, carry, u); 
                 t += carry;
@@ -222,3 +225,5 @@ void rdc_mont(const dfelm_t ma, felm_t mc)
     ADDC(0, v, ma[2*NWORDS_FIELD-1], carry, v); 
     mc[NWORDS_FIELD-1] = v;
 }
+
+#endif
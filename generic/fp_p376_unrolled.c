@@ -0,0 +1,229 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: unrolled modular multiplication for P376
+* Generated by tools/gen_fp_unrolled.py 126 78 53 7, do not edit.
+* Straight-line product scanning multiplication, squaring and Montgomery reduction on 64-bit words, with
+* the words of p376+1 as literals. The other field functions are those of the portable implementation.
+* Included by P376.c in _UNROLLED_ builds.
+*********************************************************************************************/
+
+#define SIGK_FP_MUL_RDC
+#include "fp_generic.c"
+
+#if !defined(UINT128_SUPPORT) || (RADIX != 64) || (NWORDS_FIELD != 6)
+#error -- "The unrolled backend of P376 requires 64-bit digits and 128-bit integers"
+#endif
+
+// Accumulator of a column: the 192-bit value t:acc
+#define MULACC(x, y) { uv = (uint128_t)(x) * (y); acc += uv; t += (acc < uv); }
+#define ADDACC(x) { acc += (x); t += (acc < (x)); }
+#define SHLACC(x, n) { uv = (uint128_t)(x) << (n); acc += uv; t += (acc < uv); }
+// Store the low word of the column and shift the accumulator to the next column
+#define COLUMN(out) { (out) = (digit_t)acc; acc = (acc >> 64) | ((uint128_t)t << 64); t = 0; }
+// Products of a squaring summed in st:s, then doubled into the accumulator
+#define SQRACC(x, y) { uv = (uint128_t)(x) * (y); s += uv; st += (s < uv); }
+#define DOUBLEACC() { st = (st << 1) | (digit_t)(s >> 127); s <<= 1; acc += s; t += st + (acc < s); }
+
+
+static __inline void mul_unrolled(const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a*b, where lng(a) = lng(b) = NWORDS_FIELD
+    const digit_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5];
+    const digit_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4], b5 = b[5];
+    uint128_t acc = 0, uv;
+    digit_t t = 0;
+
+    MULACC(a0, b0);
+    COLUMN(c[0]);
+    MULACC(a0, b1);
+    MULACC(a1, b0);
+    COLUMN(c[1]);
+    MULACC(a0, b2);
+    MULACC(a1, b1);
+    MULACC(a2, b0);
+    COLUMN(c[2]);
+    MULACC(a0, b3);
+    MULACC(a1, b2);
+    MULACC(a2, b1);
+    MULACC(a3, b0);
+    COLUMN(c[3]);
+    MULACC(a0, b4);
+    MULACC(a1, b3);
+    MULACC(a2, b2);
+    MULACC(a3, b1);
+    MULACC(a4, b0);
+    COLUMN(c[4]);
+    MULACC(a0, b5);
+    MULACC(a1, b4);
+    MULACC(a2, b3);
+    MULACC(a3, b2);
+    MULACC(a4, b1);
+    MULACC(a5, b0);
+    COLUMN(c[5]);
+    MULACC(a1, b5);
+    MULACC(a2, b4);
+    MULACC(a3, b3);
+    MULACC(a4, b2);
+    MULACC(a5, b1);
+    COLUMN(c[6]);
+    MULACC(a2, b5);
+    MULACC(a3, b4);
+    MULACC(a4, b3);
+    MULACC(a5, b2);
+    COLUMN(c[7]);
+    MULACC(a3, b5);
+    MULACC(a4, b4);
+    MULACC(a5, b3);
+    COLUMN(c[8]);
+    MULACC(a4, b5);
+    MULACC(a5, b4);
+    COLUMN(c[9]);
+    MULACC(a5, b5);
+    COLUMN(c[10]);
+    c[11] = (digit_t)acc;
+}
+
+
+static __inline void sqr_unrolled(const digit_t* a, digit_t* c)
+{ // c = a^2, where lng(a) = NWORDS_FIELD. The products a[i]*a[j], i < j, are summed once and doubled
+    const digit_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5];
+    uint128_t acc = 0, uv, s;
+    digit_t t = 0, st;
+
+    MULACC(a0, a0);
+    COLUMN(c[0]);
+    s = 0; st = 0;
+    SQRACC(a0, a1);
+    DOUBLEACC();
+    COLUMN(c[1]);
+    s = 0; st = 0;
+    SQRACC(a0, a2);
+    DOUBLEACC();
+    MULACC(a1, a1);
+    COLUMN(c[2]);
+    s = 0; st = 0;
+    SQRACC(a0, a3);
+    SQRACC(a1, a2);
+    DOUBLEACC();
+    COLUMN(c[3]);
+    s = 0; st = 0;
+    SQRACC(a0, a4);
+    SQRACC(a1, a3);
+    DOUBLEACC();
+    MULACC(a2, a2);
+    COLUMN(c[4]);
+    s = 0; st = 0;
+    SQRACC(a0, a5);
+    SQRACC(a1, a4);
+    SQRACC(a2, a3);
+    DOUBLEACC();
+    COLUMN(c[5]);
+    s = 0; st = 0;
+    SQRACC(a1, a5);
+    SQRACC(a2, a4);
+    DOUBLEACC();
+    MULACC(a3, a3);
+    COLUMN(c[6]);
+    s = 0; st = 0;
+    SQRACC(a2, a5);
+    SQRACC(a3, a4);
+    DOUBLEACC();
+    COLUMN(c[7]);
+    s = 0; st = 0;
+    SQRACC(a3, a5);
+    DOUBLEACC();
+    MULACC(a4, a4);
+    COLUMN(c[8]);
+    s = 0; st = 0;
+    SQRACC(a4, a5);
+    DOUBLEACC();
+    COLUMN(c[9]);
+    MULACC(a5, a5);
+    COLUMN(c[10]);
+    c[11] = (digit_t)acc;
+}
+
+
+void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{ // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords = NWORDS_FIELD
+    UNREFERENCED_PARAMETER(nwords);
+    COUNT_OP(mp_mul);
+
+    if (a == b) {
+        sqr_unrolled(a, c);
+    } else {
+        mul_unrolled(a, b, c);
+    }
+}
+
+
+void rdc_mont(const digit_t* ma, digit_t* mc)
+{ // Montgomery reduction exploiting the special form of the prime, mc = ma*R^-1 mod 2p, where R = 2^384.
+  // If ma < 2^384*p, the output mc is in the range [0, 2*p-1].
+    digit_t q0, q1, q2, q3, q4, q5;
+    uint128_t acc = 0, uv;
+    digit_t t = 0;
+
+    COUNT_OP(rdc_mont);
+
+    ADDACC(ma[0]);
+    COLUMN(q0);
+    MULACC(q0, 0xC000000000000000);
+    ADDACC(ma[1]);
+    COLUMN(q1);
+    MULACC(q0, 0x5AFBA1783B3853C6);
+    MULACC(q1, 0xC000000000000000);
+    ADDACC(ma[2]);
+    COLUMN(q2);
+    MULACC(q0, 0x6AC919DC8401FEBF);
+    MULACC(q1, 0x5AFBA1783B3853C6);
+    MULACC(q2, 0xC000000000000000);
+    ADDACC(ma[3]);
+    COLUMN(q3);
+    MULACC(q0, 0xEB9DB2E8379E65BE);
+    MULACC(q1, 0x6AC919DC8401FEBF);
+    MULACC(q2, 0x5AFBA1783B3853C6);
+    MULACC(q3, 0xC000000000000000);
+    ADDACC(ma[4]);
+    COLUMN(q4);
+    MULACC(q0, 0x00B49879D9074BCF);
+    MULACC(q1, 0xEB9DB2E8379E65BE);
+    MULACC(q2, 0x6AC919DC8401FEBF);
+    MULACC(q3, 0x5AFBA1783B3853C6);
+    MULACC(q4, 0xC000000000000000);
+    ADDACC(ma[5]);
+    COLUMN(q5);
+    MULACC(q1, 0x00B49879D9074BCF);
+    MULACC(q2, 0xEB9DB2E8379E65BE);
+    MULACC(q3, 0x6AC919DC8401FEBF);
+    MULACC(q4, 0x5AFBA1783B3853C6);
+    MULACC(q5, 0xC000000000000000);
+    ADDACC(ma[6]);
+    COLUMN(mc[0]);
+    MULACC(q2, 0x00B49879D9074BCF);
+    MULACC(q3, 0xEB9DB2E8379E65BE);
+    MULACC(q4, 0x6AC919DC8401FEBF);
+    MULACC(q5, 0x5AFBA1783B3853C6);
+    ADDACC(ma[7]);
+    COLUMN(mc[1]);
+    MULACC(q3, 0x00B49879D9074BCF);
+    MULACC(q4, 0xEB9DB2E8379E65BE);
+    MULACC(q5, 0x6AC919DC8401FEBF);
+    ADDACC(ma[8]);
+    COLUMN(mc[2]);
+    MULACC(q4, 0x00B49879D9074BCF);
+    MULACC(q5, 0xEB9DB2E8379E65BE);
+    ADDACC(ma[9]);
+    COLUMN(mc[3]);
+    MULACC(q5, 0x00B49879D9074BCF);
+    ADDACC(ma[10]);
+    COLUMN(mc[4]);
+    mc[5] = (digit_t)acc + ma[11];
+}
+
+#undef MULACC
+#undef ADDACC
+#undef SHLACC
+#undef COLUMN
+#undef SQRACC
+#undef DOUBLEACC
@@ -0,0 +1,532 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: unrolled modular multiplication for P747
+* Generated by tools/gen_fp_unrolled.py 260 153 105 1, do not edit.
+* Straight-line product scanning multiplication, squaring and Montgomery reduction on 64-bit words, with
+* the words of p747+1 as literals. The other field functions are those of the portable implementation.
+* Included by P747.c in _UNROLLED_ builds.
+*********************************************************************************************/
+
+#define SIGK_FP_MUL_RDC
+#include "fp_generic.c"
+
+#if !defined(UINT128_SUPPORT) || (RADIX != 64) || (NWORDS_FIELD != 12)
+#error -- "The unrolled backend of P747 requires 64-bit digits and 128-bit integers"
+#endif
+
+// Accumulator of a column: the 192-bit value t:acc
+#define MULACC(x, y) { uv = (uint128_t)(x) * (y); acc += uv; t += (acc < uv); }
+#define ADDACC(x) { acc += (x); t += (acc < (x)); }
+#define SHLACC(x, n) { uv = (uint128_t)(x) << (n); acc += uv; t += (acc < uv); }
+// Store the low word of the column and shift the accumulator to the next column
+#define COLUMN(out) { (out) = (digit_t)acc; acc = (acc >> 64) | ((uint128_t)t << 64); t = 0; }
+// Products of a squaring summed in st:s, then doubled into the accumulator
+#define SQRACC(x, y) { uv = (uint128_t)(x) * (y); s += uv; st += (s < uv); }
+#define DOUBLEACC() { st = (st << 1) | (digit_t)(s >> 127); s <<= 1; acc += s; t += st + (acc < s); }
+
+
+static __inline void mul_unrolled(const digit_t* a, const digit_t* b, digit_t* c)
+{ // c = a*b, where lng(a) = lng(b) = NWORDS_FIELD
+    const digit_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9], a10 = a[10], a11 = a[11];
+    const digit_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4], b5 = b[5], b6 = b[6], b7 = b[7], b8 = b[8], b9 = b[9], b10 = b[10], b11 = b[11];
+    uint128_t acc = 0, uv;
+    digit_t t = 0;
+
+    MULACC(a0, b0);
+    COLUMN(c[0]);
+    MULACC(a0, b1);
+    MULACC(a1, b0);
+    COLUMN(c[1]);
+    MULACC(a0, b2);
+    MULACC(a1, b1);
+    MULACC(a2, b0);
+    COLUMN(c[2]);
+    MULACC(a0, b3);
+    MULACC(a1, b2);
+    MULACC(a2, b1);
+    MULACC(a3, b0);
+    COLUMN(c[3]);
+    MULACC(a0, b4);
+    MULACC(a1, b3);
+    MULACC(a2, b2);
+    MULACC(a3, b1);
+    MULACC(a4, b0);
+    COLUMN(c[4]);
+    MULACC(a0, b5);
+    MULACC(a1, b4);
+    MULACC(a2, b3);
+    MULACC(a3, b2);
+    MULACC(a4, b1);
+    MULACC(a5, b0);
+    COLUMN(c[5]);
+    MULACC(a0, b6);
+    MULACC(a1, b5);
+    MULACC(a2, b4);
+    MULACC(a3, b3);
+    MULACC(a4, b2);
+    MULACC(a5, b1);
+    MULACC(a6, b0);
+    COLUMN(c[6]);
+    MULACC(a0, b7);
+    MULACC(a1, b6);
+    MULACC(a2, b5);
+    MULACC(a3, b4);
+    MULACC(a4, b3);
+    MULACC(a5, b2);
+    MULACC(a6, b1);
+    MULACC(a7, b0);
+    COLUMN(c[7]);
+    MULACC(a0, b8);
+    MULACC(a1, b7);
+    MULACC(a2, b6);
+    MULACC(a3, b5);
+    MULACC(a4, b4);
+    MULACC(a5, b3);
+    MULACC(a6, b2);
+    MULACC(a7, b1);
+    MULACC(a8, b0);
+    COLUMN(c[8]);
+    MULACC(a0, b9);
+    MULACC(a1, b8);
+    MULACC(a2, b7);
+    MULACC(a3, b6);
+    MULACC(a4, b5);
+    MULACC(a5, b4);
+    MULACC(a6, b3);
+    MULACC(a7, b2);
+    MULACC(a8, b1);
+    MULACC(a9, b0);
+    COLUMN(c[9]);
+    MULACC(a0, b10);
+    MULACC(a1, b9);
+    MULACC(a2, b8);
+    MULACC(a3, b7);
+    MULACC(a4, b6);
+    MULACC(a5, b5);
+    MULACC(a6, b4);
+    MULACC(a7, b3);
+    MULACC(a8, b2);
+    MULACC(a9, b1);
+    MULACC(a10, b0);
+    COLUMN(c[10]);
+    MULACC(a0, b11);
+    MULACC(a1, b10);
+    MULACC(a2, b9);
+    MULACC(a3, b8);
+    MULACC(a4, b7);
+    MULACC(a5, b6);
+    MULACC(a6, b5);
+    MULACC(a7, b4);
+    MULACC(a8, b3);
+    MULACC(a9, b2);
+    MULACC(a10, b1);
+    MULACC(a11, b0);
+    COLUMN(c[11]);
+    MULACC(a1, b11);
+    MULACC(a2, b10);
+    MULACC(a3, b9);
+    MULACC(a4, b8);
+    MULACC(a5, b7);
+    MULACC(a6, b6);
+    MULACC(a7, b5);
+    MULACC(a8, b4);
+    MULACC(a9, b3);
+    MULACC(a10, b2);
+    MULACC(a11, b1);
+    COLUMN(c[12]);
+    MULACC(a2, b11);
+    MULACC(a3, b10);
+    MULACC(a4, b9);
+    MULACC(a5, b8);
+    MULACC(a6, b7);
+    MULACC(a7, b6);
+    MULACC(a8, b5);
+    MULACC(a9, b4);
+    MULACC(a10, b3);
+    MULACC(a11, b2);
+    COLUMN(c[13]);
+    MULACC(a3, b11);
+    MULACC(a4, b10);
+    MULACC(a5, b9);
+    MULACC(a6, b8);
+    MULACC(a7, b7);
+    MULACC(a8, b6);
+    MULACC(a9, b5);
+    MULACC(a10, b4);
+    MULACC(a11, b3);
+    COLUMN(c[14]);
+    MULACC(a4, b11);
+    MULACC(a5, b10);
+    MULACC(a6, b9);
+    MULACC(a7, b8);
+    MULACC(a8, b7);
+    MULACC(a9, b6);
+    MULACC(a10, b5);
+    MULACC(a11, b4);
+    COLUMN(c[15]);
+    MULACC(a5, b11);
+    MULACC(a6, b10);
+    MULACC(a7, b9);
+    MULACC(a8, b8);
+    MULACC(a9, b7);
+    MULACC(a10, b6);
+    MULACC(a11, b5);
+    COLUMN(c[16]);
+    MULACC(a6, b11);
+    MULACC(a7, b10);
+    MULACC(a8, b9);
+    MULACC(a9, b8);
+    MULACC(a10, b7);
+    MULACC(a11, b6);
+    COLUMN(c[17]);
+    MULACC(a7, b11);
+    MULACC(a8, b10);
+    MULACC(a9, b9);
+    MULACC(a10, b8);
+    MULACC(a11, b7);
+    COLUMN(c[18]);
+    MULACC(a8, b11);
+    MULACC(a9, b10);
+    MULACC(a10, b9);
+    MULACC(a11, b8);
+    COLUMN(c[19]);
+    MULACC(a9, b11);
+    MULACC(a10, b10);
+    MULACC(a11, b9);
+    COLUMN(c[20]);
+    MULACC(a10, b11);
+    MULACC(a11, b10);
+    COLUMN(c[21]);
+    MULACC(a11, b11);
+    COLUMN(c[22]);
+    c[23] = (digit_t)acc;
+}
+
+
+static __inline void sqr_unrolled(const digit_t* a, digit_t* c)
+{ // c = a^2, where lng(a) = NWORDS_FIELD. The products a[i]*a[j], i < j, are summed once and doubled
+    const digit_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5], a6 = a[6], a7 = a[7], a8 = a[8], a9 = a[9], a10 = a[10], a11 = a[11];
+    uint128_t acc = 0, uv, s;
+    digit_t t = 0, st;
+
+    MULACC(a0, a0);
+    COLUMN(c[0]);
+    s = 0; st = 0;
+    SQRACC(a0, a1);
+    DOUBLEACC();
+    COLUMN(c[1]);
+    s = 0; st = 0;
+    SQRACC(a0, a2);
+    DOUBLEACC();
+    MULACC(a1, a1);
+    COLUMN(c[2]);
+    s = 0; st = 0;
+    SQRACC(a0, a3);
+    SQRACC(a1, a2);
+    DOUBLEACC();
+    COLUMN(c[3]);
+    s = 0; st = 0;
+    SQRACC(a0, a4);
+    SQRACC(a1, a3);
+    DOUBLEACC();
+    MULACC(a2, a2);
+    COLUMN(c[4]);
+    s = 0; st = 0;
+    SQRACC(a0, a5);
+    SQRACC(a1, a4);
+    SQRACC(a2, a3);
+    DOUBLEACC();
+    COLUMN(c[5]);
+    s = 0; st = 0;
+    SQRACC(a0, a6);
+    SQRACC(a1, a5);
+    SQRACC(a2, a4);
+    DOUBLEACC();
+    MULACC(a3, a3);
+    COLUMN(c[6]);
+    s = 0; st = 0;
+    SQRACC(a0, a7);
+    SQRACC(a1, a6);
+    SQRACC(a2, a5);
+    SQRACC(a3, a4);
+    DOUBLEACC();
+    COLUMN(c[7]);
+    s = 0; st = 0;
+    SQRACC(a0, a8);
+    SQRACC(a1, a7);
+    SQRACC(a2, a6);
+    SQRACC(a3, a5);
+    DOUBLEACC();
+    MULACC(a4, a4);
+    COLUMN(c[8]);
+    s = 0; st = 0;
+    SQRACC(a0, a9);
+    SQRACC(a1, a8);
+    SQRACC(a2, a7);
+    SQRACC(a3, a6);
+    SQRACC(a4, a5);
+    DOUBLEACC();
+    COLUMN(c[9]);
+    s = 0; st = 0;
+    SQRACC(a0, a10);
+    SQRACC(a1, a9);
+    SQRACC(a2, a8);
+    SQRACC(a3, a7);
+    SQRACC(a4, a6);
+    DOUBLEACC();
+    MULACC(a5, a5);
+    COLUMN(c[10]);
+    s = 0; st = 0;
+    SQRACC(a0, a11);
+    SQRACC(a1, a10);
+    SQRACC(a2, a9);
+    SQRACC(a3, a8);
+    SQRACC(a4, a7);
+    SQRACC(a5, a6);
+    DOUBLEACC();
+    COLUMN(c[11]);
+    s = 0; st = 0;
+    SQRACC(a1, a11);
+    SQRACC(a2, a10);
+    SQRACC(a3, a9);
+    SQRACC(a4, a8);
+    SQRACC(a5, a7);
+    DOUBLEACC();
+    MULACC(a6, a6);
+    COLUMN(c[12]);
+    s = 0; st = 0;
+    SQRACC(a2, a11);
+    SQRACC(a3, a10);
+    SQRACC(a4, a9);
+    SQRACC(a5, a8);
+    SQRACC(a6, a7);
+    DOUBLEACC();
+    COLUMN(c[13]);
+    s = 0; st = 0;
+    SQRACC(a3, a11);
+    SQRACC(a4, a10);
+    SQRACC(a5, a9);
+    SQRACC(a6, a8);
+    DOUBLEACC();
+    MULACC(a7, a7);
+    COLUMN(c[14]);
+    s = 0; st = 0;
+    SQRACC(a4, a11);
+    SQRACC(a5, a10);
+    SQRACC(a6, a9);
+    SQRACC(a7, a8);
+    DOUBLEACC();
+    COLUMN(c[15]);
+    s = 0; st = 0;
+    SQRACC(a5, a11);
+    SQRACC(a6, a10);
+    SQRACC(a7, a9);
+    DOUBLEACC();
+    MULACC(a8, a8);
+    COLUMN(c[16]);
+    s = 0; st = 0;
+    SQRACC(a6, a11);
+    SQRACC(a7, a10);
+    SQRACC(a8, a9);
+    DOUBLEACC();
+    COLUMN(c[17]);
+    s = 0; st = 0;
+    SQRACC(a7, a11);
+    SQRACC(a8, a10);
+    DOUBLEACC();
+    MULACC(a9, a9);
+    COLUMN(c[18]);
+    s = 0; st = 0;
+    SQRACC(a8, a11);
+    SQRACC(a9, a10);
+    DOUBLEACC();
+    COLUMN(c[19]);
+    s = 0; st = 0;
+    SQRACC(a9, a11);
+    DOUBLEACC();
+    MULACC(a10, a10);
+    COLUMN(c[20]);
+    s = 0; st = 0;
+    SQRACC(a10, a11);
+    DOUBLEACC();
+    COLUMN(c[21]);
+    MULACC(a11, a11);
+    COLUMN(c[22]);
+    c[23] = (digit_t)acc;
+}
+
+
+void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{ // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords = NWORDS_FIELD
+    UNREFERENCED_PARAMETER(nwords);
+    COUNT_OP(mp_mul);
+
+    if (a == b) {
+        sqr_unrolled(a, c);
+    } else {
+        mul_unrolled(a, b, c);
+    }
+}
+
+
+void rdc_mont(const digit_t* ma, digit_t* mc)
+{ // Montgomery reduction exploiting the special form of the prime, mc = ma*R^-1 mod 2p, where R = 2^768.
+  // If ma < 2^768*p, the output mc is in the range [0, 2*p-1].
+    digit_t q0, q1, q2, q3, q4, q5, q6, q7, q8, q9, q10, q11;
+    uint128_t acc = 0, uv;
+    digit_t t = 0;
+
+    COUNT_OP(rdc_mont);
+
+    ADDACC(ma[0]);
+    COLUMN(q0);
+    ADDACC(ma[1]);
+    COLUMN(q1);
+    ADDACC(ma[2]);
+    COLUMN(q2);
+    ADDACC(ma[3]);
+    COLUMN(q3);
+    MULACC(q0, 0xA047C05513A78CF0);
+    ADDACC(ma[4]);
+    COLUMN(q4);
+    MULACC(q0, 0xB26D38D6F3B27CC3);
+    MULACC(q1, 0xA047C05513A78CF0);
+    ADDACC(ma[5]);
+    COLUMN(q5);
+    MULACC(q0, 0x0B40709FDFCF993C);
+    MULACC(q1, 0xB26D38D6F3B27CC3);
+    MULACC(q2, 0xA047C05513A78CF0);
+    ADDACC(ma[6]);
+    COLUMN(q6);
+    MULACC(q0, 0x7B53A41A27D10162);
+    MULACC(q1, 0x0B40709FDFCF993C);
+    MULACC(q2, 0xB26D38D6F3B27CC3);
+    MULACC(q3, 0xA047C05513A78CF0);
+    ADDACC(ma[7]);
+    COLUMN(q7);
+    MULACC(q0, 0xA4DC87C4B86348CC);
+    MULACC(q1, 0x7B53A41A27D10162);
+    MULACC(q2, 0x0B40709FDFCF993C);
+    MULACC(q3, 0xB26D38D6F3B27CC3);
+    MULACC(q4, 0xA047C05513A78CF0);
+    ADDACC(ma[8]);
+    COLUMN(q8);
+    MULACC(q0, 0x5F33FCB0E1016AA2);
+    MULACC(q1, 0xA4DC87C4B86348CC);
+    MULACC(q2, 0x7B53A41A27D10162);
+    MULACC(q3, 0x0B40709FDFCF993C);
+    MULACC(q4, 0xB26D38D6F3B27CC3);
+    MULACC(q5, 0xA047C05513A78CF0);
+    ADDACC(ma[9]);
+    COLUMN(q9);
+    MULACC(q0, 0xD42A27A9491431BC);
+    MULACC(q1, 0x5F33FCB0E1016AA2);
+    MULACC(q2, 0xA4DC87C4B86348CC);
+    MULACC(q3, 0x7B53A41A27D10162);
+    MULACC(q4, 0x0B40709FDFCF993C);
+    MULACC(q5, 0xB26D38D6F3B27CC3);
+    MULACC(q6, 0xA047C05513A78CF0);
+    ADDACC(ma[10]);
+    COLUMN(q10);
+    MULACC(q0, 0x000004EE30756B8B);
+    MULACC(q1, 0xD42A27A9491431BC);
+    MULACC(q2, 0x5F33FCB0E1016AA2);
+    MULACC(q3, 0xA4DC87C4B86348CC);
+    MULACC(q4, 0x7B53A41A27D10162);
+    MULACC(q5, 0x0B40709FDFCF993C);
+    MULACC(q6, 0xB26D38D6F3B27CC3);
+    MULACC(q7, 0xA047C05513A78CF0);
+    ADDACC(ma[11]);
+    COLUMN(q11);
+    MULACC(q1, 0x000004EE30756B8B);
+    MULACC(q2, 0xD42A27A9491431BC);
+    MULACC(q3, 0x5F33FCB0E1016AA2);
+    MULACC(q4, 0xA4DC87C4B86348CC);
+    MULACC(q5, 0x7B53A41A27D10162);
+    MULACC(q6, 0x0B40709FDFCF993C);
+    MULACC(q7, 0xB26D38D6F3B27CC3);
+    MULACC(q8, 0xA047C05513A78CF0);
+    ADDACC(ma[12]);
+    COLUMN(mc[0]);
+    MULACC(q2, 0x000004EE30756B8B);
+    MULACC(q3, 0xD42A27A9491431BC);
+    MULACC(q4, 0x5F33FCB0E1016AA2);
+    MULACC(q5, 0xA4DC87C4B86348CC);
+    MULACC(q6, 0x7B53A41A27D10162);
+    MULACC(q7, 0x0B40709FDFCF993C);
+    MULACC(q8, 0xB26D38D6F3B27CC3);
+    MULACC(q9, 0xA047C05513A78CF0);
+    ADDACC(ma[13]);
+    COLUMN(mc[1]);
+    MULACC(q3, 0x000004EE30756B8B);
+    MULACC(q4, 0xD42A27A9491431BC);
+    MULACC(q5, 0x5F33FCB0E1016AA2);
+    MULACC(q6, 0xA4DC87C4B86348CC);
+    MULACC(q7, 0x7B53A41A27D10162);
+    MULACC(q8, 0x0B40709FDFCF993C);
+    MULACC(q9, 0xB26D38D6F3B27CC3);
+    MULACC(q10, 0xA047C05513A78CF0);
+    ADDACC(ma[14]);
+    COLUMN(mc[2]);
+    MULACC(q4, 0x000004EE30756B8B);
+    MULACC(q5, 0xD42A27A9491431BC);
+    MULACC(q6, 0x5F33FCB0E1016AA2);
+    MULACC(q7, 0xA4DC87C4B86348CC);
+    MULACC(q8, 0x7B53A41A27D10162);
+    MULACC(q9, 0x0B40709FDFCF993C);
+    MULACC(q10, 0xB26D38D6F3B27CC3);
+    MULACC(q11, 0xA047C05513A78CF0);
+    ADDACC(ma[15]);
+    COLUMN(mc[3]);
+    MULACC(q5, 0x000004EE30756B8B);
+    MULACC(q6, 0xD42A27A9491431BC);
+    MULACC(q7, 0x5F33FCB0E1016AA2);
+    MULACC(q8, 0xA4DC87C4B86348CC);
+    MULACC(q9, 0x7B53A41A27D10162);
+    MULACC(q10, 0x0B40709FDFCF993C);
+    MULACC(q11, 0xB26D38D6F3B27CC3);
+    ADDACC(ma[16]);
+    COLUMN(mc[4]);
+    MULACC(q6, 0x000004EE30756B8B);
+    MULACC(q7, 0xD42A27A9491431BC);
+    MULACC(q8, 0x5F33FCB0E1016AA2);
+    MULACC(q9, 0xA4DC87C4B86348CC);
+    MULACC(q10, 0x7B53A41A27D10162);
+    MULACC(q11, 0x0B40709FDFCF993C);
+    ADDACC(ma[17]);
+    COLUMN(mc[5]);
+    MULACC(q7, 0x000004EE30756B8B);
+    MULACC(q8, 0xD42A27A9491431BC);
+    MULACC(q9, 0x5F33FCB0E1016AA2);
+    MULACC(q10, 0xA4DC87C4B86348CC);
+    MULACC(q11, 0x7B53A41A27D10162);
+    ADDACC(ma[18]);
+    COLUMN(mc[6]);
+    MULACC(q8, 0x000004EE30756B8B);
+    MULACC(q9, 0xD42A27A9491431BC);
+    MULACC(q10, 0x5F33FCB0E1016AA2);
+    MULACC(q11, 0xA4DC87C4B86348CC);
+    ADDACC(ma[19]);
+    COLUMN(mc[7]);
+    MULACC(q9, 0x000004EE30756B8B);
+    MULACC(q10, 0xD42A27A9491431BC);
+    MULACC(q11, 0x5F33FCB0E1016AA2);
+    ADDACC(ma[20]);
+    COLUMN(mc[8]);
+    MULACC(q10, 0x000004EE30756B8B);
+    MULACC(q11, 0xD42A27A9491431BC);
+    ADDACC(ma[21]);
+    COLUMN(mc[9]);
+    MULACC(q11, 0x000004EE30756B8B);
+    ADDACC(ma[22]);
+    COLUMN(mc[10]);
+    mc[11] = (digit_t)acc + ma[23];
+}
+
+#undef MULACC
+#undef ADDACC
+#undef SHLACC
+#undef COLUMN
+#undef SQRACC
+#undef DOUBLEACC
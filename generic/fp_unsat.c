@@ -0,0 +1,139 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: portable modular arithmetic with 56-bit limbs
+* Field elements keep the 64-bit word format of felm_t. Multiplication and Montgomery reduction split their
+* operands into unsaturated 56-bit limbs and accumulate the products of each column in 128 bits, so that the
+* carries are propagated once per column instead of once per product. The other field functions are those of
+* the portable implementation. Included by the file of each parameter set in _UNSATURATED_ builds.
+*********************************************************************************************/
+
+#define SIGK_FP_MUL_RDC
+#include "fp_generic.c"
+
+#if !defined(UINT128_SUPPORT) || (RADIX != 64)
+#error -- "The unsaturated backend requires 64-bit digits and 128-bit integers"
+#endif
+#if (PRIME_ZERO_WORDS < 1)
+#error -- "The unsaturated backend requires p = -1 mod 2^64"
+#endif
+
+#define LIMB_BITS 56
+#define LIMB_MASK (((uint64_t)1 << LIMB_BITS) - 1)
+#define NLIMBS_FIELD ((NWORDS_FIELD * RADIX + LIMB_BITS - 1) / LIMB_BITS)  // Number of limbs of a field element, 14 for p747
+#define LIMB_SHIFT (NLIMBS_FIELD * LIMB_BITS - NWORDS_FIELD * RADIX)       // Bits between R = 2^(RADIX*NWORDS_FIELD) and 2^(LIMB_BITS*NLIMBS_FIELD)
+#define PRIME_ZERO_LIMBS ((PRIME_ZERO_WORDS * RADIX) / LIMB_BITS)           // Number of "0" limbs in the least significant part of p + 1
+
+
+static __inline void unsat_split(const digit_t* a, uint64_t* r, const unsigned int nwords, const unsigned int nlimbs, const unsigned int shift)
+{ // Split a, where lng(a) = nwords, into nlimbs limbs of 56 bits holding a*2^shift, with shift < 56.
+    unsigned int k, w, o;
+    uint64_t v;
+
+    r[0] = (a[0] << shift) & LIMB_MASK;
+    for (k = 1; k < nlimbs; k++) {
+        w = (k * LIMB_BITS - shift) / RADIX;
+        o = (k * LIMB_BITS - shift) % RADIX;
+        v = (w < nwords) ? (a[w] >> o) : 0;
+        if (o > RADIX - LIMB_BITS && w + 1 < nwords) {
+            v |= a[w + 1] << (RADIX - o);
+        }
+        r[k] = v & LIMB_MASK;
+    }
+}
+
+
+static __inline void unsat_join(const uint64_t* r, digit_t* c, const unsigned int nlimbs, const unsigned int nwords)
+{ // Join nlimbs limbs of 56 bits into c, where lng(c) = nwords. Bits of r above nwords words must be zero.
+    unsigned int k, w = 0, nbits = 0;
+    uint128_t acc = 0;
+
+    for (k = 0; k < nlimbs && w < nwords; k++) {
+        acc |= (uint128_t)r[k] << nbits;
+        nbits += LIMB_BITS;
+        if (nbits >= RADIX) {
+            c[w++] = (digit_t)acc;
+            acc >>= RADIX;
+            nbits -= RADIX;
+        }
+    }
+    for (; w < nwords; w++) {
+        c[w] = (digit_t)acc;
+        acc >>= RADIX;
+    }
+}
+
+
+void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{ // Multiprecision product scanning multiply, c = a*b, where lng(a) = lng(b) = nwords = NWORDS_FIELD.
+  // A squaring (a == b) only computes the products a[i]*a[j] with i <= j.
+    uint64_t al[NLIMBS_FIELD], bl[NLIMBS_FIELD], cl[2*NLIMBS_FIELD];
+    uint128_t acc = 0, s;
+    unsigned int i, k;
+
+    UNREFERENCED_PARAMETER(nwords);
+    COUNT_OP(mp_mul);
+
+    unsat_split(a, al, NWORDS_FIELD, NLIMBS_FIELD, 0);
+    if (a == b) {
+        for (k = 0; k < 2*NLIMBS_FIELD-1; k++) {
+            s = 0;
+            for (i = (k < NLIMBS_FIELD) ? 0 : k-NLIMBS_FIELD+1; 2*i < k; i++) {
+                s += (uint128_t)al[i] * al[k-i];
+            }
+            acc += s << 1;
+            if ((k & 1) == 0) {
+                acc += (uint128_t)al[k/2] * al[k/2];
+            }
+            cl[k] = (uint64_t)acc & LIMB_MASK;
+            acc >>= LIMB_BITS;
+        }
+    } else {
+        unsat_split(b, bl, NWORDS_FIELD, NLIMBS_FIELD, 0);
+        for (k = 0; k < 2*NLIMBS_FIELD-1; k++) {
+            for (i = (k < NLIMBS_FIELD) ? 0 : k-NLIMBS_FIELD+1; i <= k && i < NLIMBS_FIELD; i++) {
+                acc += (uint128_t)al[i] * bl[k-i];
+            }
+            cl[k] = (uint64_t)acc & LIMB_MASK;
+            acc >>= LIMB_BITS;
+        }
+    }
+    cl[2*NLIMBS_FIELD-1] = (uint64_t)acc;
+    unsat_join(cl, c, 2*NLIMBS_FIELD, 2*NWORDS_FIELD);
+}
+
+
+void rdc_mont(const dfelm_t ma, felm_t mc)
+{ // Montgomery reduction with 56-bit limbs exploiting the special form of the prime p.
+  // mc = ma*R^-1 mod 2p, where R = 2^(RADIX*NWORDS_FIELD).
+  // If ma < 2^(RADIX*NWORDS_FIELD)*p, the output mc is in the range [0, 2*p-1].
+  // The reduction divides ma*2^LIMB_SHIFT by 2^(LIMB_BITS*NLIMBS_FIELD), which is the same as dividing ma by R.
+  // Since p = -1 mod 2^56, the quotient limb of each step is the current limb and q*p = q*(p+1) - q, where
+  // the low limbs of p+1 are zero.
+    uint64_t t[2*NLIMBS_FIELD], p1[NLIMBS_FIELD], q[NLIMBS_FIELD], r[NLIMBS_FIELD];
+    uint128_t acc = 0;
+    unsigned int j, k;
+
+    COUNT_OP(rdc_mont);
+
+    unsat_split(ma, t, 2*NWORDS_FIELD, 2*NLIMBS_FIELD, LIMB_SHIFT);
+    unsat_split((digit_t*)PRIMEp1, p1, NWORDS_FIELD, NLIMBS_FIELD, 0);
+
+    for (k = 0; k < NLIMBS_FIELD; k++) {
+        acc += t[k];
+        for (j = 0; j + PRIME_ZERO_LIMBS <= k; j++) {
+            acc += (uint128_t)q[j] * p1[k-j];
+        }
+        q[k] = (uint64_t)acc & LIMB_MASK;      // Adding q*(p+1) - q clears the limb
+        acc >>= LIMB_BITS;
+    }
+    for (k = NLIMBS_FIELD; k < 2*NLIMBS_FIELD; k++) {
+        acc += t[k];
+        for (j = k-NLIMBS_FIELD+1; j < NLIMBS_FIELD && j + PRIME_ZERO_LIMBS <= k; j++) {
+            acc += (uint128_t)q[j] * p1[k-j];
+        }
+        r[k-NLIMBS_FIELD] = (uint64_t)acc & LIMB_MASK;
+        acc >>= LIMB_BITS;
+    }
+    unsat_join(r, mc, NLIMBS_FIELD, NWORDS_FIELD);
+}
@@ -8,8 +8,17 @@
  *  Modified and created by Amir Jalali             ajalali2016@fau.edu 
  ******************************************************************************************************/
 
-#include "P747_internal.h"
+#include "sigk_internal.h"
 #include "random.h"
+#include "sigk_sdt.h"
+
+// Static probes of the "sigk" provider at the entry and return of the functions of api.h
+#define PROBE_ENTRY(fn) PROBE_ENTRY_(fn)
+#define PROBE_EXIT(fn) PROBE_EXIT_(fn)
+#define PROBE_RETURN(fn, ret) PROBE_RETURN_(fn, ret)
+#define PROBE_ENTRY_(fn) SIGK_PROBE0(sigk, fn##__entry)
+#define PROBE_EXIT_(fn) SIGK_PROBE0(sigk, fn##__return)
+#define PROBE_RETURN_(fn, ret) SIGK_PROBE1(sigk, fn##__return, ret)
 
 static void clear_words(void *mem, digit_t nwords)
 {   // Clear digits from memory. "nwords" indicates the number of digits to be zeroed.
@@ -34,37 +43,89 @@ static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
     fpcopy(gen + 4 * NWORDS_FIELD, XR[1]);
 }
 
-static void init_alpha(digit_t *alpha, f2elm_t Alpha)
-{ // Initialization of alpha aka 2-torsion point on the base curve
+static void init_alpha(f2elm_t Alpha)
+{ // Initialization of alpha aka 2-torsion point (0 + i) on the base curve, in Montgomery representation
     fpzero(Alpha[0]);
-    fpcopy(alpha, Alpha[1]);
+    fpcopy((digit_t *)&Montgomery_one, Alpha[1]);
 }
 
-static void fp2_encode(const f2elm_t x, unsigned char *enc)
-{ // Conversion of GF(p^2) element from Montgomery to standard representation, and encoding by removing leading 0 bytes
-    unsigned int i;
-    f2elm_t t;
+static void fp_pack(const felm_t a, unsigned char *enc)
+{ // Little-endian encoding of a field element in standard representation into FP2_ENCODED_BYTES/2 bytes, a word at a time
+    const unsigned int nbytes = FP2_ENCODED_BYTES / 2, wbytes = RADIX / 8;
+    unsigned int i, k;
 
-    from_fp2mont(x, t);
-    for (i = 0; i < FP2_ENCODED_BYTES / 2; i++)
+    for (i = 0; i < nbytes / wbytes; i++)
     {
-        enc[i] = ((unsigned char *)t)[i];
-        enc[i + FP2_ENCODED_BYTES / 2] = ((unsigned char *)t)[i + MAXBITS_FIELD / 8];
+        for (k = 0; k < wbytes; k++)
+        {
+            enc[i * wbytes + k] = (unsigned char)(a[i] >> (8 * k));
+        }
+    }
+    for (k = 0; k < nbytes % wbytes; k++)
+    {
+        enc[i * wbytes + k] = (unsigned char)(a[i] >> (8 * k));
     }
 }
 
-static void fp2_decode(const unsigned char *enc, f2elm_t x)
-{ // Parse byte sequence back into GF(p^2) element, and conversion to Montgomery representation
-    unsigned int i;
+static void fp_unpack(const unsigned char *enc, felm_t a)
+{ // Decoding of a field element encoded by fp_pack(), a word at a time. The words above the encoding are cleared.
+    const unsigned int nbytes = FP2_ENCODED_BYTES / 2, wbytes = RADIX / 8;
+    unsigned int i, k;
+    digit_t d;
 
-    for (i = 0; i < 2 * (MAXBITS_FIELD / 8); i++)
-        ((unsigned char *)x)[i] = 0;
-    for (i = 0; i < FP2_ENCODED_BYTES / 2; i++)
+    for (i = 0; i < nbytes / wbytes; i++)
     {
-        ((unsigned char *)x)[i] = enc[i];
-        ((unsigned char *)x)[i + MAXBITS_FIELD / 8] = enc[i + FP2_ENCODED_BYTES / 2];
+        d = 0;
+        for (k = 0; k < wbytes; k++)
+        {
+            d |= (digit_t)enc[i * wbytes + k] << (8 * k);
+        }
+        a[i] = d;
     }
-    to_fp2mont(x, x);
+    d = 0;
+    for (k = 0; k < nbytes % wbytes; k++)
+    {
+        d |= (digit_t)enc[i * wbytes + k] << (8 * k);
+    }
+    for (; i < NWORDS_FIELD; i++)
+    {
+        a[i] = d;
+        d = 0;
+    }
+}
+
+static void fp2_encode(const f2elm_t x, unsigned char *enc)
+{ // Conversion of GF(p^2) element from Montgomery to standard representation, and encoding by removing leading 0 bytes.
+  // Each half is converted with a single Montgomery reduction and packed straight into enc.
+    felm_t t;
+
+    from_mont(x[0], t);
+    fp_pack(t, enc);
+    from_mont(x[1], t);
+    fp_pack(t, enc + FP2_ENCODED_BYTES / 2);
+}
+
+static void fp2_unpack(const unsigned char *enc, f2elm_t x)
+{ // Parse byte sequence back into GF(p^2) element in standard representation
+    fp_unpack(enc, x[0]);
+    fp_unpack(enc + FP2_ENCODED_BYTES / 2, x[1]);
+}
+
+static void fp2_decode(const unsigned char *enc, f2elm_t x)
+{ // Parse byte sequence back into GF(p^2) element, each half converted to Montgomery representation as soon as it is read
+    fp_unpack(enc, x[0]);
+    to_mont(x[0], x[0]);
+    fp_unpack(enc + FP2_ENCODED_BYTES / 2, x[1]);
+    to_mont(x[1], x[1]);
+}
+
+static unsigned int fp2_reduced(const unsigned char *enc)
+{ // Returns 1 if both halves of an encoded GF(p^2) element are in [0, p-1], as produced by fp2_encode()
+    f2elm_t x;
+    felm_t t;
+
+    fp2_unpack(enc, x);
+    return mp_sub(x[0], (digit_t *)PRIME, t, NWORDS_FIELD) & mp_sub(x[1], (digit_t *)PRIME, t, NWORDS_FIELD);
 }
 
 void random_mod_order_A(unsigned char *random_digits)
@@ -72,9 +133,11 @@ void random_mod_order_A(unsigned char *random_digits)
     // Outputs random value in [0, 2^eA - 1]
     unsigned long long nbytes = NBITS_TO_NBYTES(OALICE_BITS);
 
+    PROBE_ENTRY(random_mod_order_A);
     clear_words((void *)random_digits, MAXWORDS_ORDER);
     randombytes(random_digits, nbytes);
     random_digits[nbytes - 1] &= MASK_ALICE; // Masking last byte
+    PROBE_EXIT(random_mod_order_A);
 }
 
 void random_mod_order_B(unsigned char *random_digits)
@@ -82,9 +145,11 @@ void random_mod_order_B(unsigned char *random_digits)
     // Outputs random value in [0, 2^Floor(Log(2, oB)) - 1]
     unsigned long long nbytes = NBITS_TO_NBYTES(OBOB_BITS - 1);
 
+    PROBE_ENTRY(random_mod_order_B);
     clear_words((void *)random_digits, MAXWORDS_ORDER);
     randombytes(random_digits, nbytes);
     random_digits[nbytes - 1] &= MASK_BOB; // Masking last byte
+    PROBE_EXIT(random_mod_order_B);
 }
 
 void random_mod_order_C(unsigned char *random_digits)
@@ -92,711 +157,1101 @@ void random_mod_order_C(unsigned char *random_digits)
     // Outputs random value in [0, 2^Floor(Log(2, oC)) - 1]
     unsigned long long nbytes = NBITS_TO_NBYTES(OEVE_BITS - 1);
 
+    PROBE_ENTRY(random_mod_order_C);
     clear_words((void *)random_digits, MAXWORDS_ORDER);
     randombytes(random_digits, nbytes);
     random_digits[nbytes - 1] &= MASK_EVE; // Masking last byte
+    PROBE_EXIT(random_mod_order_C);
 }
 
-int EphemeralKeyGeneration_A(const unsigned char *PrivateKeyA, unsigned char *PublicKeyA)
-{   // Alice's ephemeral public key generation
-    // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1].
-    // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiPB = {0}, phiQB = {0}, phiRB = {0}, phiPC = {0}, phiQC = {0}, phiRC = {0}, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
-
-    // Initialize basis points
-    init_basis((digit_t *)A_gen, XPA, XQA, XRA);
-    init_basis((digit_t *)B_gen, phiPB->X, phiQB->X, phiRB->X);
-    init_basis((digit_t *)C_gen, phiPC->X, phiQC->X, phiRC->X);
-    //init_alpha((digit_t*)E0_alpha, phiAlpha->X);
-
-    to_fp2mont(XPA, XPA);
-    to_fp2mont(XQA, XQA);
-    to_fp2mont(XRA, XRA);
-    to_fp2mont(phiPB->X, phiPB->X);
-    to_fp2mont(phiQB->X, phiQB->X);
-    to_fp2mont(phiRB->X, phiRB->X);
-    to_fp2mont(phiPC->X, phiPC->X);
-    to_fp2mont(phiQC->X, phiQC->X);
-    to_fp2mont(phiRC->X, phiRC->X);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiPB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiPC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRC->Z)[0]);
-
-    // Initialize constants
-    fpcopy((digit_t *)&Montgomery_one, A24plus[0]);
-    fp2add(A24plus, A24plus, C24);
-
-    // Retrieve kernel point
-    LADDER3PT(XPA, XQA, XRA, (digit_t *)PrivateKeyA, ALICE, R, A);
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Alice; row++)
-    {
-        while (index < MAX_Alice - row)
-        {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[MAX_Alice - index - row];
-            xDBLe(R, R, A24plus, C24, (int)(2 * m));
-            index += m;
-        }
+// Stages of a resumable operation
+#define STAGE_SETUP 0    // Initialization of the basis, the tracked points and the curve constants of a walk
+#define STAGE_LADDER 1   // Computation of the kernel point with the 3-point ladder
+#define STAGE_TRAVERSE 2 // Traversal of the isogeny tree following the strategy
+#define STAGE_FINISH 3   // Last isogeny and formatting of the output of a walk
+#define STAGE_DONE 4
+
+// The state of an operation is kept inside the caller-provided sigk_op_t
+typedef char op_state_fits_in_sigk_op_t[(sizeof(op_state) <= sizeof(sigk_op_t)) ? 1 : -1];
+typedef char op_state_alignment_fits_workspaces[(SIGK_WORKSPACE_ALIGN % CACHE_LINE_BYTES == 0) ? 1 : -1];
+
+// Coordinates of the point of index i in the pool of a walk
+#define POOL_X(w, i) ((w)->pool[(i) / EVAL_BLOCK].X[(i) % EVAL_BLOCK])
+#define POOL_Z(w, i) ((w)->pool[(i) / EVAL_BLOCK].Z[(i) % EVAL_BLOCK])
+
+// Party running the walks of each operation
+static const unsigned int op_role[SIGK_NUM_OPS] = {ALICE, BOB, EVE, BOB, EVE, ALICE, BOB};
+
+// Without a hook, a phase boundary costs the test of sigk_trace_hook. The "phase" probe reports it to attached tracers.
+#define TRACE(id, phase_id, event)                        \
+    do                                                    \
+    {                                                     \
+        SIGK_PROBE3(sigk, phase, id, phase_id, event);    \
+        if (sigk_trace_hook != NULL)                      \
+        {                                                 \
+            sigk_trace_event((id), (phase_id), (event));  \
+        }                                                 \
+    } while (0)
+
+static size_t walk_bytes(const unsigned int role)
+{ // Size of the part of a walk_state used by a walk of the given role, the stored points are limited by its strategy
+    unsigned int npts = MAX_INT_POINTS_EVE;
+
+    if (role == ALICE)
+    {
+        npts = MAX_INT_POINTS_ALICE;
+    }
+    else if (role == BOB)
+    {
+        npts = MAX_INT_POINTS_BOB;
+    }
+    return offsetof(walk_state, pool) + POINT_BLOCKS(npts) * sizeof(point_block);
+}
 
-        get_4_isog(R, A24plus, C24, coeff);
+static void track_basis(walk_state *w, const digit_t *gen)
+{ // Add the basis {XP, XQ, XR} of another party, expressed in Montgomery representation, to the tracked points of a walk
+    unsigned int i;
 
-        for (i = 0; i < npts; i++)
-        {
-            eval_4_isog(pts[i], coeff);
-        }
-        eval_4_isog(phiPB, coeff);
-        eval_4_isog(phiQB, coeff);
-        eval_4_isog(phiRB, coeff);
-        eval_4_isog(phiPC, coeff);
-        eval_4_isog(phiQC, coeff);
-        eval_4_isog(phiRC, coeff);
-
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
-    }
-
-    get_4_isog(R, A24plus, C24, coeff);
-    eval_4_isog(phiPB, coeff);
-    eval_4_isog(phiQB, coeff);
-    eval_4_isog(phiRB, coeff);
-    eval_4_isog(phiPC, coeff);
-    eval_4_isog(phiQC, coeff);
-    eval_4_isog(phiRC, coeff);
-
-    inv_6_way(phiPB->Z, phiQB->Z, phiRB->Z, phiPC->Z, phiQC->Z, phiRC->Z);
-    fp2mul_mont(phiPB->X, phiPB->Z, phiPB->X);
-    fp2mul_mont(phiQB->X, phiQB->Z, phiQB->X);
-    fp2mul_mont(phiRB->X, phiRB->Z, phiRB->X);
-    fp2mul_mont(phiPC->X, phiPC->Z, phiPC->X);
-    fp2mul_mont(phiQC->X, phiQC->Z, phiQC->X);
-    fp2mul_mont(phiRC->X, phiRC->Z, phiRC->X);
-
-    // Format public key
-    fp2_encode(phiPB->X, PublicKeyA);
-    fp2_encode(phiQB->X, PublicKeyA + FP2_ENCODED_BYTES);
-    fp2_encode(phiRB->X, PublicKeyA + 2 * FP2_ENCODED_BYTES);
-    fp2_encode(phiPC->X, PublicKeyA + 3 * FP2_ENCODED_BYTES);
-    fp2_encode(phiQC->X, PublicKeyA + 4 * FP2_ENCODED_BYTES);
-    fp2_encode(phiRC->X, PublicKeyA + 5 * FP2_ENCODED_BYTES);
+    init_basis((digit_t *)gen, POOL_X(w, w->nphi), POOL_X(w, w->nphi + 1), POOL_X(w, w->nphi + 2));
+    for (i = w->nphi; i < w->nphi + 3; i++)
+    {
+        fpcopy((digit_t *)&Montgomery_one, POOL_Z(w, i)[0]);
+    }
+    w->nphi += 3;
+}
 
-    return 0;
+static void track_encoded(walk_state *w, const unsigned char *enc)
+{ // Add three encoded x-coordinates to the tracked points of a walk
+    unsigned int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        fp2_decode(enc + i * FP2_ENCODED_BYTES, POOL_X(w, w->nphi));
+        fpcopy((digit_t *)&Montgomery_one, POOL_Z(w, w->nphi)[0]);
+        w->nphi += 1;
+    }
 }
 
-int EphemeralKeyGeneration_B(const unsigned char *PrivateKeyB, unsigned char *PublicKeyB)
-{   // Bob's ephemeral public key generation
-    // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1].
-    // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiPA = {0}, phiQA = {0}, phiRA = {0}, phiPC = {0}, phiQC = {0}, phiRC = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-
-    // Initialize basis points
-    init_basis((digit_t *)B_gen, XPB, XQB, XRB);
-    init_basis((digit_t *)A_gen, phiPA->X, phiQA->X, phiRA->X);
-    init_basis((digit_t *)C_gen, phiPC->X, phiQC->X, phiRC->X);
-
-    to_fp2mont(XPB, XPB);
-    to_fp2mont(XQB, XQB);
-    to_fp2mont(XRB, XRB);
-    to_fp2mont(phiPA->X, phiPA->X);
-    to_fp2mont(phiQA->X, phiQA->X);
-    to_fp2mont(phiRA->X, phiRA->X);
-    to_fp2mont(phiPC->X, phiPC->X);
-    to_fp2mont(phiQC->X, phiQC->X);
-    to_fp2mont(phiRC->X, phiRC->X);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiPA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiPC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRC->Z)[0]);
-
-    // Initialize constants
-    fpcopy((digit_t *)&Montgomery_one, A24plus[0]);
-    fp2add(A24plus, A24plus, A24plus);
-    fp2copy(A24plus, A24minus);
-    fp2neg(A24minus);
-
-    // Retrieve kernel point
-    LADDER3PT(XPB, XQB, XRB, (digit_t *)PrivateKeyB, BOB, R, A);
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Bob; row++)
-    {
-        while (index < MAX_Bob - row)
+static void encode_images(const walk_state *w, unsigned char *out)
+{ // Encode the normalized tracked images of a walk into consecutive elements of out, a whole public key or shared public key
+    unsigned int i;
+
+    for (i = 0; i < w->nphi; i++)
+    {
+        fp2_encode(POOL_X(w, i), out + i * FP2_ENCODED_BYTES);
+    }
+}
+
+static void kernel_basis_gen(walk_state *w, const digit_t *gen)
+{ // Initialize the kernel basis of a key generation from the public generators on the base curve E0.
+    // The ladder and the first row of the traversal use the formulas for A = 0, the constants below serve the remaining E0 computations.
+    init_basis((digit_t *)gen, w->xP, w->xQ, w->xPQ);
+    w->e0 = 1;
+
+    fpcopy((digit_t *)&Montgomery_one, (digit_t *)w->A24plus);
+    if (w->role == BOB)
+    { // A24plus = 2, A24minus = -2
+        fp2add(w->A24plus, w->A24plus, w->A24plus);
+        fp2copy(w->A24plus, w->A24minus);
+        fp2neg(w->A24minus);
+    }
+    else
+    { // A24plus = 1, C24 = 2
+        fp2add(w->A24plus, w->A24plus, w->C24);
+    }
+}
+
+static void kernel_basis_encoded(walk_state *w, const unsigned char *enc)
+{ // Initialize the kernel basis from three encoded x-coordinates
+    fp2_decode(enc, w->xP);
+    fp2_decode(enc + FP2_ENCODED_BYTES, w->xQ);
+    fp2_decode(enc + 2 * FP2_ENCODED_BYTES, w->xPQ);
+}
+
+static void kernel_curve(walk_state *w)
+{ // Retrieve the curve a decoded kernel basis lies on
+    get_A(w->xP, w->xQ, w->xPQ, w->A);
+    if (w->role == BOB)
+    { // A24plus = A+2, A24minus = A-2
+        fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, (digit_t *)w->A24minus);
+        fp2add(w->A, w->A24minus, w->A24plus);
+        fp2sub(w->A, w->A24minus, w->A24minus);
+    }
+    else
+    { // A24plus = A+2, C24 = 4
+        fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, (digit_t *)w->C24);
+        fp2add(w->A, w->C24, w->A24plus);
+        fpadd(w->C24[0], w->C24[0], w->C24[0]);
+    }
+}
+
+static const unsigned int *walk_splits(const unsigned int role, const unsigned int cores)
+{ // Strategy listed in traversal order used by a walk of the given role sharing its evaluations between cores threads,
+  // or NULL for the size-indexed strategy of the role
+#if defined(SIGK_SMALL_FOOTPRINT)
+    UNREFERENCED_PARAMETER(cores);
+    return (role == ALICE) ? strat_Alice : (role == BOB) ? strat_Bob : strat_Eve;
+#else
+    if (cores >= 4)
+    {
+        return (role == ALICE) ? strat_Alice_4cores : (role == BOB) ? strat_Bob_4cores : strat_Eve_4cores;
+    }
+    else if (cores >= 2)
+    {
+        return (role == ALICE) ? strat_Alice_2cores : (role == BOB) ? strat_Bob_2cores : strat_Eve_2cores;
+    }
+    return NULL;
+#endif
+}
+
+static void setup_walk(op_state *s)
+{ // Initialization of the current walk of an operation
+    walk_state *w = &s->w;
+
+    clear_words((void *)w, walk_bytes(op_role[s->op]) / sizeof(digit_t));
+    w->role = op_role[s->op];
+    w->cores = sigk_workers_cores();
+    w->splits = walk_splits(w->role, w->cores);
+
+    TRACE(s->op, SIGK_PHASE_DECODE, SIGK_TRACE_BEGIN);
+    switch (s->op)
+    {
+    case SIGK_OP_KEYGEN_A:
+        kernel_basis_gen(w, (digit_t *)A_gen);
+        track_basis(w, (digit_t *)B_gen);
+        track_basis(w, (digit_t *)C_gen);
+        break;
+    case SIGK_OP_KEYGEN_B:
+        kernel_basis_gen(w, (digit_t *)B_gen);
+        track_basis(w, (digit_t *)A_gen);
+        track_basis(w, (digit_t *)C_gen);
+        break;
+    case SIGK_OP_KEYGEN_C:
+        kernel_basis_gen(w, (digit_t *)C_gen);
+        track_basis(w, (digit_t *)A_gen);
+        track_basis(w, (digit_t *)B_gen);
+        // alpha is a point of order 2 on the base curve, its images give the codomain curves
+        init_alpha(POOL_X(w, w->nphi));
+        fpcopy((digit_t *)&Montgomery_one, POOL_Z(w, w->nphi)[0]);
+        w->use_alpha = 1;
+        break;
+    case SIGK_OP_B_SHARED_PUBLIC_FROM_A:
+        kernel_basis_encoded(w, s->in[0]);                  // E_A
+        track_encoded(w, s->in[0] + 3 * FP2_ENCODED_BYTES); // phi_A(PC), phi_A(QC), phi_A(RC)
+        break;
+    case SIGK_OP_C_SHARED_SECRET_FROM_B:
+        if (s->walk == 0)
         {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[MAX_Bob - index - row];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
+            kernel_basis_encoded(w, s->in[0] + 3 * FP2_ENCODED_BYTES); // E_B
+            track_encoded(w, s->in[0]);                                // phi_B(PA), phi_B(QA), phi_B(RA)
         }
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++)
+        else
+        {
+            kernel_basis_encoded(w, s->in[1]); // E_AB, the images of its basis give the codomain curves
+            track_encoded(w, s->in[1]);
+            w->jinv = 1;
+        }
+        break;
+    case SIGK_OP_A_SHARED_SECRET_FROM_C:
+        if (s->walk == 0)
+        {
+            kernel_basis_encoded(w, s->in[0]);                  // E_C
+            track_encoded(w, s->in[0] + 3 * FP2_ENCODED_BYTES); // phi_C(PB), phi_C(QB), phi_C(RB)
+        }
+        else
         {
-            eval_3_isog(pts[i], coeff);
+            kernel_basis_encoded(w, s->in[1]); // E_BC
+            w->jinv = 1;
         }
-        eval_3_isog(phiPA, coeff);
-        eval_3_isog(phiQA, coeff);
-        eval_3_isog(phiRA, coeff);
-        eval_3_isog(phiPC, coeff);
-        eval_3_isog(phiQC, coeff);
-        eval_3_isog(phiRC, coeff);
-
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
-    }
-    get_3_isog(R, A24minus, A24plus, coeff);
-    eval_3_isog(phiPA, coeff);
-    eval_3_isog(phiQA, coeff);
-    eval_3_isog(phiRA, coeff);
-    eval_3_isog(phiPC, coeff);
-    eval_3_isog(phiQC, coeff);
-    eval_3_isog(phiRC, coeff);
-
-    inv_6_way(phiPA->Z, phiQA->Z, phiRA->Z, phiPC->Z, phiQC->Z, phiRC->Z);
-    fp2mul_mont(phiPA->X, phiPA->Z, phiPA->X);
-    fp2mul_mont(phiQA->X, phiQA->Z, phiQA->X);
-    fp2mul_mont(phiRA->X, phiRA->Z, phiRA->X);
-    fp2mul_mont(phiPC->X, phiPC->Z, phiPC->X);
-    fp2mul_mont(phiQC->X, phiQC->Z, phiQC->X);
-    fp2mul_mont(phiRC->X, phiRC->Z, phiRC->X);
-
-    // Format public key
-    fp2_encode(phiPA->X, PublicKeyB);
-    fp2_encode(phiQA->X, PublicKeyB + FP2_ENCODED_BYTES);
-    fp2_encode(phiRA->X, PublicKeyB + 2 * FP2_ENCODED_BYTES);
-    fp2_encode(phiPC->X, PublicKeyB + 3 * FP2_ENCODED_BYTES);
-    fp2_encode(phiQC->X, PublicKeyB + 4 * FP2_ENCODED_BYTES);
-    fp2_encode(phiRC->X, PublicKeyB + 5 * FP2_ENCODED_BYTES);
+        break;
+    case SIGK_OP_B_SHARED_SECRET_FROM_A:
+        kernel_basis_encoded(w, s->in[0]); // E_AC
+        w->jinv = 1;
+        break;
+    }
+    TRACE(s->op, SIGK_PHASE_DECODE, SIGK_TRACE_END);
 
-    return 0;
+    if (s->op > SIGK_OP_KEYGEN_C)
+    { // The kernel basis of the other operations was decoded from an input
+        TRACE(s->op, SIGK_PHASE_GET_A, SIGK_TRACE_BEGIN);
+        kernel_curve(w);
+        TRACE(s->op, SIGK_PHASE_GET_A, SIGK_TRACE_END);
+    }
+
+    if (w->role == ALICE)
+    {
+        w->nbits = OALICE_BITS;
+    }
+    else if (w->role == BOB)
+    {
+        w->nbits = OBOB_BITS;
+    }
+    else
+    {
+        w->nbits = OEVE_BITS;
+    }
+    TRACE(s->op, SIGK_PHASE_LADDER, SIGK_TRACE_BEGIN);
+    LADDER3PT_init(w->xP, w->xQ, w->xPQ, w->A, w->R0, w->R2, w->R, w->A24);
+    w->base = w->nphi + w->use_alpha;
+    w->row = 1;
 }
 
-int EphemeralKeyGeneration_C(const unsigned char *PrivateKeyC, unsigned char *PublicKeyC)
-{   // Eve's ephemral public key generation
-    // Input: a private key PrivateKeyC in the range [0, 2^Floor(Log(2,oC)) - 1].
-    // Output: the public key PublicKeyC consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+static void load_point(const walk_state *w, const unsigned int i, point_proj_t P)
+{ // Copy the point of index i of the pool
+    fp2copy(POOL_X(w, i), P->X);
+    fp2copy(POOL_Z(w, i), P->Z);
+}
+
+static void curve_from_basis(walk_state *w, point_proj_t T)
+{ // Recover the current curve from the images of the first tracked basis, after the kernel points have been used.
+    // The ladder points R0 and R2 are not used during the traversal and hold two of the basis points, T holds the third.
+    load_point(w, 0, w->R0);
+    load_point(w, 1, w->R2);
+    load_point(w, 2, T);
+    get_A_projective(w->R0, w->R2, T, w->A24plus, w->C24);
+}
+
+static void push_point(walk_state *w)
+{ // Store the current point of the traversal before moving it down the tree
+    fp2copy(w->R->X, POOL_X(w, w->base + w->npts));
+    fp2copy(w->R->Z, POOL_Z(w, w->base + w->npts));
+    w->pts_index[w->npts++] = w->index;
+}
+
+static void pop_point(walk_state *w)
+{ // Restore the last stored point as the kernel point of the next isogeny
+    load_point(w, w->base + w->npts - 1, w->R);
+    w->index = w->pts_index[w->npts - 1];
+    w->npts -= 1;
+}
 
-    // alpha is a point of order 2 on the base curve
-    point_proj_t phiAlpha = {0}, R, R_2, phiPA = {0}, phiQA = {0}, phiRA = {0}, phiPB = {0}, phiQB = {0}, phiRB = {0}, pts[MAX_INT_POINTS_EVE];
-    f2elm_t XPC, XQC, XRC, A24plus = {0}, C24 = {0}, A24pluscpy = {0}, C24cpy = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_EVE], npts = 0, ii = 0;
-
-    // Initialized basis points
-    init_basis((digit_t *)C_gen, XPC, XQC, XRC);
-    init_basis((digit_t *)A_gen, phiPA->X, phiQA->X, phiRA->X);
-    init_basis((digit_t *)B_gen, phiPB->X, phiQB->X, phiRB->X);
-    init_alpha((digit_t *)E0_alpha, phiAlpha->X);
-
-    to_fp2mont(phiAlpha->X, phiAlpha->X);
-    to_fp2mont(XPC, XPC);
-    to_fp2mont(XQC, XQC);
-    to_fp2mont(XRC, XRC);
-    to_fp2mont(phiPB->X, phiPB->X);
-    to_fp2mont(phiQB->X, phiQB->X);
-    to_fp2mont(phiRB->X, phiRB->X);
-    to_fp2mont(phiPA->X, phiPA->X);
-    to_fp2mont(phiQA->X, phiQA->X);
-    to_fp2mont(phiRA->X, phiRA->X);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiPA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiPB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiQB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiRB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiAlpha->Z)[0]);
-
-    // Initialize constants
-    fpcopy((digit_t *)&Montgomery_one, A24plus[0]);
-    fp2add(A24plus, A24plus, C24);
-
-    // Retrieve kernel point
-    LADDER3PT(XPC, XQC, XRC, (digit_t *)PrivateKeyC, EVE, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Eve; row++)
-    {
-        while (index < MAX_Eve - row)
+static unsigned int walk_rows(const walk_state *w)
+{ // Number of isogenies computed in a walk
+    if (w->role == ALICE)
+    {
+        return MAX_Alice;
+    }
+    else if (w->role == BOB)
+    {
+        return MAX_Bob;
+    }
+    return MAX_Eve;
+}
+
+static unsigned int next_split(walk_state *w, const unsigned int *strat, const unsigned int max)
+{ // Number of multiplications moving the current point down the tree, read from the strategy of the walk or from the
+  // size-indexed strategy strat of a walk of max rows
+    if (w->splits != NULL)
+    {
+        return w->splits[w->split++];
+    }
+    return strat[max - w->index - w->row];
+}
+
+typedef struct
+{
+    walk_state *w;
+    const point_proj *R, *R2;
+    unsigned int n;
+} eval_job;
+
+static void eval_part(void *ctx, const unsigned int part, const unsigned int nparts)
+{ // Evaluation of the isogeny of the current row at the blocks of one part of the first n points of the pool
+    const eval_job *job = (const eval_job *)ctx;
+    walk_state *w = job->w;
+    const unsigned int nblocks = (job->n + EVAL_BLOCK - 1) / EVAL_BLOCK;
+    const unsigned int first = (part * nblocks) / nparts, last = ((part + 1) * nblocks) / nparts;
+    const unsigned int n = ((last * EVAL_BLOCK < job->n) ? last * EVAL_BLOCK : job->n) - first * EVAL_BLOCK;
+
+    if (w->role == ALICE)
+    {
+        eval_4_isog_multi(&w->pool[first], n, w->coeff);
+    }
+    else if (w->role == BOB)
+    {
+        eval_3_isog_multi(&w->pool[first], n, w->coeff);
+    }
+    else
+    {
+        eval_5_isog_multi(job->R, job->R2, &w->pool[first], n);
+    }
+}
+
+static void eval_pool(walk_state *w, const unsigned int n, const point_proj *R2)
+{ // Evaluation of the isogeny of the current row at the first n points of the pool, shared by up to w->cores threads.
+  // Each thread takes whole blocks. R2 = [2]R for Eve's 5-isogeny, unused otherwise.
+    eval_job job;
+    const unsigned int nblocks = (n + EVAL_BLOCK - 1) / EVAL_BLOCK;
+
+    job.w = w;
+    job.R = w->R;
+    job.R2 = R2;
+    job.n = n;
+    if (w->cores < 2 || nblocks < 2)
+    {
+        eval_part(&job, 0, 1);
+        return;
+    }
+    sigk_workers_run(eval_part, &job, (nblocks < w->cores) ? nblocks : w->cores);
+}
+
+static void walk_row(walk_state *w)
+{ // One row of the traversal: move the current point down to a leaf of the tree, compute the isogeny with the leaf as kernel,
+  // push the stored points and the tracked images through it, and continue with the last stored point.
+    point_proj_t R_2;
+    unsigned int m;
+
+    if (w->role == ALICE)
+    {
+        while (w->index < MAX_Alice - w->row)
+        {
+            push_point(w);
+            m = next_split(w, strat_Alice, MAX_Alice);
+            if (w->e0)
+            {
+                xDBLe_E0(w->R, w->R, (int)(2 * m));
+            }
+            else
+            {
+                xDBLe(w->R, w->R, w->A24plus, w->C24, (int)(2 * m));
+            }
+            w->index += m;
+        }
+        get_4_isog(w->R, w->A24plus, w->C24, w->coeff);
+        eval_pool(w, w->base + w->npts, NULL);
+    }
+    else if (w->role == BOB)
+    {
+        while (w->index < MAX_Bob - w->row)
+        {
+            push_point(w);
+            m = next_split(w, strat_Bob, MAX_Bob);
+            if (w->e0)
+            {
+                xTPLe_E0(w->R, w->R, (int)m);
+            }
+            else
+            {
+                xTPLe(w->R, w->R, w->A24minus, w->A24plus, (int)m);
+            }
+            w->index += m;
+        }
+        get_3_isog(w->R, w->A24minus, w->A24plus, w->coeff);
+        eval_pool(w, w->base + w->npts, NULL);
+    }
+    else
+    {
+        while (w->index < MAX_Eve - w->row)
         {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Eve[MAX_Eve - index - row];
-            xQNTPLe(R, R, A24plus, C24, (int)m);
-            index += m;
+            push_point(w);
+            m = next_split(w, strat_Eve, MAX_Eve);
+            if (w->e0)
+            {
+                xQNTPLe_E0(w->R, w->R, (int)m);
+            }
+            else
+            {
+                xQNTPLe(w->R, w->R, w->A24plus, w->C24, (int)m);
+            }
+            w->index += m;
         }
-        xDBL(R, R_2, A24plus, C24);
-        eval_5_isog(R, R_2, phiAlpha);
+        xDBL(w->R, R_2, w->A24plus, w->C24);
+        eval_pool(w, w->base + w->npts, R_2);
 
-        for (i = 0; i < npts; i++)
+        // The 5-isogeny formulas do not output the codomain, it is recovered from the images of alpha or of a basis
+        if (w->use_alpha)
         {
-            eval_5_isog(R, R_2, pts[i]);
+            load_point(w, w->nphi, R_2);
+            get_a_from_alpha(R_2, w->A24plus, w->C24);
         }
-        eval_5_isog(R, R_2, phiPA);
-        eval_5_isog(R, R_2, phiQA);
-        eval_5_isog(R, R_2, phiRA);
-        eval_5_isog(R, R_2, phiPB);
-        eval_5_isog(R, R_2, phiQB);
-        eval_5_isog(R, R_2, phiRB);
-        get_a_from_alpha(phiAlpha, A24plus, C24);
-
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
-    }
-    xDBL(R, R_2, A24plus, C24);
-    eval_5_isog(R, R_2, phiPA);
-    eval_5_isog(R, R_2, phiQA);
-    eval_5_isog(R, R_2, phiRA);
-    eval_5_isog(R, R_2, phiPB);
-    eval_5_isog(R, R_2, phiQB);
-    eval_5_isog(R, R_2, phiRB);
-
-    inv_6_way(phiPA->Z, phiQA->Z, phiRA->Z, phiPB->Z, phiQB->Z, phiRB->Z);
-    fp2mul_mont(phiPA->X, phiPA->Z, phiPA->X);
-    fp2mul_mont(phiQA->X, phiQA->Z, phiQA->X);
-    fp2mul_mont(phiRA->X, phiRA->Z, phiRA->X);
-    fp2mul_mont(phiPB->X, phiPB->Z, phiPB->X);
-    fp2mul_mont(phiQB->X, phiQB->Z, phiQB->X);
-    fp2mul_mont(phiRB->X, phiRB->Z, phiRB->X);
-
-    // Format public key
-    fp2_encode(phiPA->X, PublicKeyC);
-    fp2_encode(phiQA->X, PublicKeyC + FP2_ENCODED_BYTES);
-    fp2_encode(phiRA->X, PublicKeyC + 2 * FP2_ENCODED_BYTES);
-    fp2_encode(phiPB->X, PublicKeyC + 3 * FP2_ENCODED_BYTES);
-    fp2_encode(phiQB->X, PublicKeyC + 4 * FP2_ENCODED_BYTES);
-    fp2_encode(phiRB->X, PublicKeyC + 5 * FP2_ENCODED_BYTES);
+        else
+        {
+            curve_from_basis(w, R_2);
+        }
+    }
 
-    return 0;
+    pop_point(w);
+    w->row += 1;
+    w->e0 = 0; // The walk left E0 with the isogeny of the row
 }
 
-int BSharedPublicFromA(const unsigned char *PrivateKeyB, const unsigned char *PublicKeyA, unsigned char *SharedPublicAB)
-{   // Bob's shared public key generation 
-    // It produces a shared public key constructed between Alice and Bob using Bob's private key and Alice's Public key
-    // The private key is an integer in the range [0, 2^Floor(Log(2,3^153)) - 1], stored in 48 bytes.  
-    // The shared public key consists of 3 GF(p747^2) elements encoded in 567 bytes.
-    point_proj_t R, phiA_PC = {0}, phiA_QC = {0}, phiA_RC = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKB[3];
-    f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-
-    // Initialize images of Alice's basis
-    fp2_decode(PublicKeyA, PKB[0]);
-    fp2_decode(PublicKeyA + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyA + 2 * FP2_ENCODED_BYTES, PKB[2]);
-    fp2_decode(PublicKeyA + 3 * FP2_ENCODED_BYTES, phiA_PC->X);
-    fp2_decode(PublicKeyA + 4 * FP2_ENCODED_BYTES, phiA_QC->X);
-    fp2_decode(PublicKeyA + 5 * FP2_ENCODED_BYTES, phiA_RC->X);
-    fpcopy((digit_t *)&Montgomery_one, (phiA_PC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiA_QC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiA_RC->Z)[0]);
-
-    // Initialize constants
-    get_A(PKB[0], PKB[1], PKB[2], A); // Retrieve E_A
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, A24minus[0]);
-    fp2add(A, A24minus, A24plus);
-    fp2sub(A, A24minus, A24minus);
-
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t *)PrivateKeyB, BOB, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Bob; row++)
-    {
-        while (index < MAX_Bob - row)
+static void finish_walk(op_state *s)
+{ // Last isogeny of the walk, followed by the encoding of the normalized images or of the j-invariant of the final curve
+    walk_state *w = &s->w;
+    unsigned char *out = s->out[s->walk];
+    point_proj_t R_2;
+    f2elm_t jinv;
+    unsigned int i;
+
+    if (w->role == ALICE)
+    {
+        get_4_isog(w->R, w->A24plus, w->C24, w->coeff);
+        eval_pool(w, w->nphi, NULL);
+    }
+    else if (w->role == BOB)
+    {
+        get_3_isog(w->R, w->A24minus, w->A24plus, w->coeff);
+        eval_pool(w, w->nphi, NULL);
+    }
+    else
+    {
+        xDBL(w->R, R_2, w->A24plus, w->C24);
+        eval_pool(w, w->nphi, R_2);
+    }
+    TRACE(s->op, SIGK_PHASE_TRAVERSE, SIGK_TRACE_END);
+
+    if (w->jinv == 0)
+    {
+        TRACE(s->op, SIGK_PHASE_NORMALIZE, SIGK_TRACE_BEGIN);
+        if (w->nphi == 6)
         {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[MAX_Bob - index - row];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
+            inv_6_way(POOL_Z(w, 0), POOL_Z(w, 1), POOL_Z(w, 2), POOL_Z(w, 3), POOL_Z(w, 4), POOL_Z(w, 5));
         }
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++)
+        else
         {
-            eval_3_isog(pts[i], coeff);
+            inv_3_way(POOL_Z(w, 0), POOL_Z(w, 1), POOL_Z(w, 2));
         }
+        for (i = 0; i < w->nphi; i++)
+        {
+            fp2mul_mont(POOL_X(w, i), POOL_Z(w, i), POOL_X(w, i));
+        }
+        TRACE(s->op, SIGK_PHASE_NORMALIZE, SIGK_TRACE_END);
 
-        eval_3_isog(phiA_PC, coeff);
-        eval_3_isog(phiA_QC, coeff);
-        eval_3_isog(phiA_RC, coeff);
+        TRACE(s->op, SIGK_PHASE_ENCODE, SIGK_TRACE_BEGIN);
+        encode_images(w, out);
+        TRACE(s->op, SIGK_PHASE_ENCODE, SIGK_TRACE_END);
+        return;
+    }
 
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
+    TRACE(s->op, SIGK_PHASE_J_INV, SIGK_TRACE_BEGIN);
+    if (w->role == BOB)
+    { // A = 2*(A24plus+A24minus), C = A24plus-A24minus
+        fp2add(w->A24plus, w->A24minus, w->A);
+        fp2add(w->A, w->A, w->A);
+        fp2sub(w->A24plus, w->A24minus, w->A24plus);
+        j_inv(w->A, w->A24plus, jinv);
+    }
+    else
+    {
+        if (w->role == EVE)
+        {
+            curve_from_basis(w, R_2);
+        }
+        // A = A24plus-C24/2, C = C24/4
+        fp2div2(w->C24, w->C24);
+        fp2sub(w->A24plus, w->C24, w->A24plus);
+        fp2div2(w->C24, w->C24);
+        j_inv(w->A24plus, w->C24, jinv);
     }
-    get_3_isog(R, A24minus, A24plus, coeff);
-    eval_3_isog(phiA_PC, coeff);
-    eval_3_isog(phiA_QC, coeff);
-    eval_3_isog(phiA_RC, coeff);
+    TRACE(s->op, SIGK_PHASE_J_INV, SIGK_TRACE_END);
 
-    inv_3_way(phiA_PC->Z, phiA_QC->Z, phiA_RC->Z);
-    fp2mul_mont(phiA_PC->X, phiA_PC->Z, phiA_PC->X);
-    fp2mul_mont(phiA_QC->X, phiA_QC->Z, phiA_QC->X);
-    fp2mul_mont(phiA_RC->X, phiA_RC->Z, phiA_RC->X);
+    TRACE(s->op, SIGK_PHASE_ENCODE, SIGK_TRACE_BEGIN);
+    fp2_encode(jinv, out); // Format shared secret
+    TRACE(s->op, SIGK_PHASE_ENCODE, SIGK_TRACE_END);
+}
 
-    fp2_encode(phiA_PC->X, SharedPublicAB);                         // phi_AB(PC)
-    fp2_encode(phiA_QC->X, SharedPublicAB + FP2_ENCODED_BYTES);     // phi_AB(QC)
-    fp2_encode(phiA_RC->X, SharedPublicAB + 2 * FP2_ENCODED_BYTES); // phi_AB(RC)
+static int op_start(sigk_op_t *op, const unsigned int id, const unsigned char *sk, const unsigned char *in0, const unsigned char *in1, unsigned char *out0, unsigned char *out1)
+{ // Record the arguments of an operation and reset it to its first stage
+    op_state *s = (op_state *)op;
+
+    if (((uintptr_t)op & (CACHE_LINE_BYTES - 1)) != 0)
+    {
+        return 1;
+    }
+    s->op = id;
+    s->stage = STAGE_SETUP;
+    s->walk = 0;
+    s->nwalks = (id == SIGK_OP_C_SHARED_SECRET_FROM_B || id == SIGK_OP_A_SHARED_SECRET_FROM_C) ? 2 : 1;
+    s->sk = sk;
+    s->in[0] = in0;
+    s->in[1] = in1;
+    s->out[0] = out0;
+    s->out[1] = out1;
 
     return 0;
 }
 
-int CSharedSecretFromB(const unsigned char *PrivateKeyC, const unsigned char *PublicKeyB, const unsigned char *SharedPublicAB, unsigned char *SharedPublicBC, unsigned char *SharedSecret)
-{   // Eve's shared secret key generation 
-    // It produces a shared public key constructed between Eve and Bob using Eve's private key and Bob's Public key
-    // It also generates the shared secret key from Eve's point of view using Alice and Bob shared public key
-    // The private key is an integer in the range [0, 2^Floor(Log(2,5^105)) - 1], stored in 48 bytes.  
-    // The shared public key consists of 3 GF(p747^2) elements encoded in 567 bytes.
-    // The shared secret key consists of one GF(p747^2) element encoded in 190 bytes.
-    point_proj_t R, R_2 = {0}, phiAB_PC = {0}, phiAB_QC = {0}, phiAB_RC = {0}, phiB_PA = {0}, phiB_QA = {0}, phiB_RA = {0}, pts[MAX_INT_POINTS_EVE];
-    f2elm_t PKB[3], PKAB[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_EVE], npts = 0, ii = 0;
-
-    // Initialize images from B
-    fp2_decode(PublicKeyB, phiB_PA->X);
-    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, phiB_QA->X);
-    fp2_decode(PublicKeyB + 2 * FP2_ENCODED_BYTES, phiB_RA->X);
-    fp2_decode(PublicKeyB + 3 * FP2_ENCODED_BYTES, PKB[0]);
-    fp2_decode(PublicKeyB + 4 * FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyB + 5 * FP2_ENCODED_BYTES, PKB[2]);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiB_PA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiB_QA->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiB_RA->Z)[0]);
-
-    // Initialize images from AB
-    fp2_decode(SharedPublicAB, PKAB[0]);
-    fp2_decode(SharedPublicAB + FP2_ENCODED_BYTES, PKAB[1]);
-    fp2_decode(SharedPublicAB + 2 * FP2_ENCODED_BYTES, PKAB[2]);
-
-    get_A(PKB[0], PKB[1], PKB[2], A); // Retrieve E_B
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
-
-    // Retrieve kernel point
-    LADDER3PT(PKB[0], PKB[1], PKB[2], (digit_t *)PrivateKeyC, EVE, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Eve; row++)
-    {
-        while (index < MAX_Eve - row)
-        {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Eve[MAX_Eve - index - row];
-            xQNTPLe(R, R, A24plus, C24, (int)m);
-            index += m;
-        }
-        xDBL(R, R_2, A24plus, C24);
-        eval_5_isog(R, R_2, phiB_PA);
-        eval_5_isog(R, R_2, phiB_QA);
-        eval_5_isog(R, R_2, phiB_RA);
+static int op_step(sigk_op_t *op, unsigned int budget)
+{ // Advance a started operation by at most "budget" units of work
+    op_state *s = (op_state *)op;
+    walk_state *w = &s->w;
+    unsigned int last;
 
-        get_A_projective(phiB_PA, phiB_QA, phiB_RA, A24plus, C24);
+    if (((uintptr_t)op & (CACHE_LINE_BYTES - 1)) != 0 || s->op >= SIGK_NUM_OPS || s->stage > STAGE_DONE)
+    {
+        return SIGK_STEP_ERROR;
+    }
 
-        for (i = 0; i < npts; i++)
+    while (budget > 0 && s->stage != STAGE_DONE)
+    {
+        switch (s->stage)
         {
-            eval_5_isog(R, R_2, pts[i]);
+        case STAGE_SETUP:
+            setup_walk(s);
+            s->stage = STAGE_LADDER;
+            break;
+        case STAGE_LADDER:
+            last = w->bit + SIGK_LADDER_BITS_PER_UNIT;
+            if (last > w->nbits)
+            {
+                last = w->nbits;
+            }
+            if (w->e0)
+            {
+                LADDER3PT_bits_E0((digit_t *)s->sk, w->bit, last, w->R0, w->R2, w->R);
+            }
+            else
+            {
+                LADDER3PT_bits((digit_t *)s->sk, w->bit, last, w->R0, w->R2, w->R, w->A24);
+            }
+            w->bit = last;
+            if (w->bit == w->nbits)
+            {
+                TRACE(s->op, SIGK_PHASE_LADDER, SIGK_TRACE_END);
+                TRACE(s->op, SIGK_PHASE_TRAVERSE, SIGK_TRACE_BEGIN);
+                s->stage = STAGE_TRAVERSE;
+            }
+            break;
+        case STAGE_TRAVERSE:
+            walk_row(w);
+            if (w->row == walk_rows(w))
+            {
+                s->stage = STAGE_FINISH;
+            }
+            break;
+        case STAGE_FINISH:
+            finish_walk(s);
+            s->walk += 1;
+            if (s->walk < s->nwalks)
+            {
+                s->stage = STAGE_SETUP;
+            }
+            else
+            {
+                clear_words((void *)w, walk_bytes(w->role) / sizeof(digit_t));
+                s->stage = STAGE_DONE;
+            }
+            break;
         }
+        budget -= 1;
+    }
 
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
-    }
-    xDBL(R, R_2, A24plus, C24);
-    eval_5_isog(R, R_2, phiB_PA);
-    eval_5_isog(R, R_2, phiB_QA);
-    eval_5_isog(R, R_2, phiB_RA);
-
-    inv_3_way(phiB_PA->Z, phiB_QA->Z, phiB_RA->Z);
-    fp2mul_mont(phiB_PA->X, phiB_PA->Z, phiB_PA->X);
-    fp2mul_mont(phiB_QA->X, phiB_QA->Z, phiB_QA->X);
-    fp2mul_mont(phiB_RA->X, phiB_RA->Z, phiB_RA->X);
-
-    // Format public key
-    fp2_encode(phiB_PA->X, SharedPublicBC);                         // phic(phiB(PA))
-    fp2_encode(phiB_QA->X, SharedPublicBC + FP2_ENCODED_BYTES);     // phic(phiB(QA))
-    fp2_encode(phiB_RA->X, SharedPublicBC + 2 * FP2_ENCODED_BYTES); // phic(phiB(RA))
-
-    fp2zero(A);
-    fp2zero(A24plus);
-    fp2zero(C24);
-    // Computing the shared secret
-    get_A(PKAB[0], PKAB[1], PKAB[2], A); // Retrieve E_AB
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
-
-    // Retrieve kernel point
-    LADDER3PT(PKAB[0], PKAB[1], PKAB[2], (digit_t *)PrivateKeyC, EVE, R, A);
-
-    // Initialize the phiAB points
-    fp2copy(PKAB[0], phiAB_PC->X);
-    fp2copy(PKAB[1], phiAB_QC->X);
-    fp2copy(PKAB[2], phiAB_RC->X);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiAB_PC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiAB_QC->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiAB_RC->Z)[0]);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Eve; row++)
-    {
-        while (index < MAX_Eve - row)
-        {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Eve[MAX_Eve - index - row];
-            xQNTPLe(R, R, A24plus, C24, (int)(m));
-            index += m;
-        }
-        xDBL(R, R_2, A24plus, C24);
-        eval_5_isog(R, R_2, phiAB_PC);
-        eval_5_isog(R, R_2, phiAB_QC);
-        eval_5_isog(R, R_2, phiAB_RC);
-        get_A_projective(phiAB_PC, phiAB_QC, phiAB_RC, A24plus, C24);
+    return (s->stage == STAGE_DONE) ? SIGK_STEP_DONE : SIGK_STEP_PENDING;
+}
 
-        for (i = 0; i < npts; i++)
-        {
-            eval_5_isog(R, R_2, pts[i]);
-        }
+int sigk_step(sigk_op_t *op, unsigned int budget)
+{ // Advance a started operation by at most "budget" units of work
+    int ret;
+
+    PROBE_ENTRY(sigk_step);
+    ret = op_step(op, budget);
+    PROBE_RETURN(sigk_step, ret);
+    return ret;
+}
+
+static int op_run(sigk_op_t *op)
+{ // Run a started operation to completion
+    return (op_step(op, SIGK_STEP_UNBOUNDED) == SIGK_STEP_DONE) ? 0 : 1;
+}
+
+size_t sigk_workspace_size(unsigned int op)
+{ // Size of the workspace of an operation: the state up to the stored points of its walks, rounded up to the alignment
+    size_t bytes = 0;
 
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
+    PROBE_ENTRY(sigk_workspace_size);
+    if (op < SIGK_NUM_OPS)
+    {
+        bytes = offsetof(op_state, w) + walk_bytes(op_role[op]);
+        bytes = (bytes + SIGK_WORKSPACE_ALIGN - 1) & ~(size_t)(SIGK_WORKSPACE_ALIGN - 1);
     }
-    xDBL(R, R_2, A24plus, C24);
-    eval_5_isog(R, R_2, phiAB_PC);
-    eval_5_isog(R, R_2, phiAB_QC);
-    eval_5_isog(R, R_2, phiAB_RC);
-    get_A_projective(phiAB_PC, phiAB_QC, phiAB_RC, A24plus, C24);
+    PROBE_RETURN(sigk_workspace_size, bytes);
+    return bytes;
+}
 
-    fp2div2(C24, C24);
-    fp2sub(A24plus, C24, A24plus);
-    fp2div2(C24, C24);
-    j_inv(A24plus, C24, jinv);
-    fp2_encode(jinv, SharedSecret); // Format shared secret
+static int workspace_valid(const void *workspace)
+{ // Workspaces must be non-NULL and aligned to SIGK_WORKSPACE_ALIGN bytes
+    return (workspace != NULL) && (((uintptr_t)workspace & (SIGK_WORKSPACE_ALIGN - 1)) == 0);
+}
 
-    return 0;
+int sigk_start_EphemeralKeyGeneration_A(sigk_op_t *op, const unsigned char *PrivateKeyA, unsigned char *PublicKeyA)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_EphemeralKeyGeneration_A);
+    ret = op_start(op, SIGK_OP_KEYGEN_A, PrivateKeyA, NULL, NULL, PublicKeyA, NULL);
+    PROBE_RETURN(sigk_start_EphemeralKeyGeneration_A, ret);
+    return ret;
+}
+
+int sigk_start_EphemeralKeyGeneration_B(sigk_op_t *op, const unsigned char *PrivateKeyB, unsigned char *PublicKeyB)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_EphemeralKeyGeneration_B);
+    ret = op_start(op, SIGK_OP_KEYGEN_B, PrivateKeyB, NULL, NULL, PublicKeyB, NULL);
+    PROBE_RETURN(sigk_start_EphemeralKeyGeneration_B, ret);
+    return ret;
+}
+
+int sigk_start_EphemeralKeyGeneration_C(sigk_op_t *op, const unsigned char *PrivateKeyC, unsigned char *PublicKeyC)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_EphemeralKeyGeneration_C);
+    ret = op_start(op, SIGK_OP_KEYGEN_C, PrivateKeyC, NULL, NULL, PublicKeyC, NULL);
+    PROBE_RETURN(sigk_start_EphemeralKeyGeneration_C, ret);
+    return ret;
+}
+
+int sigk_start_BSharedPublicFromA(sigk_op_t *op, const unsigned char *PrivateKeyB, const unsigned char *PublicKeyA, unsigned char *SharedPublicAB)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_BSharedPublicFromA);
+    ret = op_start(op, SIGK_OP_B_SHARED_PUBLIC_FROM_A, PrivateKeyB, PublicKeyA, NULL, SharedPublicAB, NULL);
+    PROBE_RETURN(sigk_start_BSharedPublicFromA, ret);
+    return ret;
+}
+
+int sigk_start_CSharedSecretFromB(sigk_op_t *op, const unsigned char *PrivateKeyC, const unsigned char *PublicKeyB, const unsigned char *SharedPublicAB, unsigned char *SharedPublicBC, unsigned char *SharedSecret)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_CSharedSecretFromB);
+    ret = op_start(op, SIGK_OP_C_SHARED_SECRET_FROM_B, PrivateKeyC, PublicKeyB, SharedPublicAB, SharedPublicBC, SharedSecret);
+    PROBE_RETURN(sigk_start_CSharedSecretFromB, ret);
+    return ret;
+}
+
+int sigk_start_ASharedSecretFromC(sigk_op_t *op, const unsigned char *PrivateKeyA, const unsigned char *PublicKeyC, const unsigned char *SharedPublicBC, unsigned char *SharedPublicAC, unsigned char *SharedSecret)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_ASharedSecretFromC);
+    ret = op_start(op, SIGK_OP_A_SHARED_SECRET_FROM_C, PrivateKeyA, PublicKeyC, SharedPublicBC, SharedPublicAC, SharedSecret);
+    PROBE_RETURN(sigk_start_ASharedSecretFromC, ret);
+    return ret;
+}
+
+int sigk_start_BSharedSecretFromA(sigk_op_t *op, const unsigned char *PrivateKeyB, const unsigned char *SharedPublicAC, unsigned char *SharedSecret)
+{
+    int ret;
+
+    PROBE_ENTRY(sigk_start_BSharedSecretFromA);
+    ret = op_start(op, SIGK_OP_B_SHARED_SECRET_FROM_A, PrivateKeyB, SharedPublicAC, NULL, SharedSecret, NULL);
+    PROBE_RETURN(sigk_start_BSharedSecretFromA, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_A(const unsigned char *PrivateKeyA, unsigned char *PublicKeyA)
+{   // Alice's ephemeral public key generation
+    // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1].
+    // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(EphemeralKeyGeneration_A);
+    op_start(&op, SIGK_OP_KEYGEN_A, PrivateKeyA, NULL, NULL, PublicKeyA, NULL);
+    ret = op_run(&op);
+    PROBE_RETURN(EphemeralKeyGeneration_A, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_B(const unsigned char *PrivateKeyB, unsigned char *PublicKeyB)
+{   // Bob's ephemeral public key generation
+    // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1].
+    // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(EphemeralKeyGeneration_B);
+    op_start(&op, SIGK_OP_KEYGEN_B, PrivateKeyB, NULL, NULL, PublicKeyB, NULL);
+    ret = op_run(&op);
+    PROBE_RETURN(EphemeralKeyGeneration_B, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_C(const unsigned char *PrivateKeyC, unsigned char *PublicKeyC)
+{   // Eve's ephemral public key generation
+    // Input: a private key PrivateKeyC in the range [0, 2^Floor(Log(2,oC)) - 1].
+    // Output: the public key PublicKeyC consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(EphemeralKeyGeneration_C);
+    op_start(&op, SIGK_OP_KEYGEN_C, PrivateKeyC, NULL, NULL, PublicKeyC, NULL);
+    ret = op_run(&op);
+    PROBE_RETURN(EphemeralKeyGeneration_C, ret);
+    return ret;
+}
+
+int BSharedPublicFromA(const unsigned char *PrivateKeyB, const unsigned char *PublicKeyA, unsigned char *SharedPublicAB)
+{   // Bob's shared public key generation 
+    // It produces a shared public key constructed between Alice and Bob using Bob's private key and Alice's Public key
+    // The private key is an integer in the range [0, 2^Floor(Log(2,3^OBOB_EXPON)) - 1], stored in SIGK_SET_SECRETKEYBYTES bytes.  
+    // The shared public key consists of 3 GF(p^2) elements encoded in SIGK_SET_SHAREDPUBLICBYTES bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(BSharedPublicFromA);
+    op_start(&op, SIGK_OP_B_SHARED_PUBLIC_FROM_A, PrivateKeyB, PublicKeyA, NULL, SharedPublicAB, NULL);
+    ret = op_run(&op);
+    PROBE_RETURN(BSharedPublicFromA, ret);
+    return ret;
+}
+
+int CSharedSecretFromB(const unsigned char *PrivateKeyC, const unsigned char *PublicKeyB, const unsigned char *SharedPublicAB, unsigned char *SharedPublicBC, unsigned char *SharedSecret)
+{   // Eve's shared secret key generation 
+    // It produces a shared public key constructed between Eve and Bob using Eve's private key and Bob's Public key
+    // It also generates the shared secret key from Eve's point of view using Alice and Bob shared public key
+    // The private key is an integer in the range [0, 2^Floor(Log(2,5^OEVE_EXPON)) - 1], stored in SIGK_SET_SECRETKEYBYTES bytes.  
+    // The shared public key consists of 3 GF(p^2) elements encoded in SIGK_SET_SHAREDPUBLICBYTES bytes.
+    // The shared secret key consists of one GF(p^2) element encoded in SIGK_SET_BYTES bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(CSharedSecretFromB);
+    op_start(&op, SIGK_OP_C_SHARED_SECRET_FROM_B, PrivateKeyC, PublicKeyB, SharedPublicAB, SharedPublicBC, SharedSecret);
+    ret = op_run(&op);
+    PROBE_RETURN(CSharedSecretFromB, ret);
+    return ret;
 }
 
 int ASharedSecretFromC(const unsigned char *PrivateKeyA, const unsigned char *PublicKeyC, const unsigned char *SharedPublicBC, unsigned char *SharedPublicAC, unsigned char *SharedSecret)
 {   // Alice's shared secret key generation 
     // It produces a shared public key constructed between Alice and Eve using Alice's private key and Eve's Public key
     // It also generates the shared secret key from Alice's point of view using Bob and Eve shared public key
-    // The private key is an integer in the range [0, 2^260 - 1], stored in 48 bytes.  
-    // The shared public key consists of 3 GF(p747^2) elements encoded in 567 bytes.
-    // The shared secret key consists of one GF(p747^2) element encoded in 190 bytes.
-    point_proj_t R, phiC_PB = {0}, phiC_QB = {0}, phiC_RB = {0}, pts[MAX_INT_POINTS_EVE];
-    f2elm_t coeff[3], PKC[3], PKBC[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_EVE], npts = 0, ii = 0;
-
-    // Initialize images from C
-    fp2_decode(PublicKeyC, PKC[0]);
-    fp2_decode(PublicKeyC + FP2_ENCODED_BYTES, PKC[1]);
-    fp2_decode(PublicKeyC + 2 * FP2_ENCODED_BYTES, PKC[2]);
-    fp2_decode(PublicKeyC + 3 * FP2_ENCODED_BYTES, phiC_PB->X);
-    fp2_decode(PublicKeyC + 4 * FP2_ENCODED_BYTES, phiC_QB->X);
-    fp2_decode(PublicKeyC + 5 * FP2_ENCODED_BYTES, phiC_RB->X);
-
-    fpcopy((digit_t *)&Montgomery_one, (phiC_PB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiC_QB->Z)[0]);
-    fpcopy((digit_t *)&Montgomery_one, (phiC_RB->Z)[0]);
-
-    // Initialize images from E_AB
-    fp2_decode(SharedPublicBC, PKBC[0]);
-    fp2_decode(SharedPublicBC + FP2_ENCODED_BYTES, PKBC[1]);
-    fp2_decode(SharedPublicBC + 2 * FP2_ENCODED_BYTES, PKBC[2]);
-
-    get_A(PKC[0], PKC[1], PKC[2], A); // Retrieve E_C
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
-
-    // Retrieve kernel point
-    LADDER3PT(PKC[0], PKC[1], PKC[2], (digit_t *)PrivateKeyA, ALICE, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Alice; row++)
-    {
-        while (index < MAX_Alice - row)
-        {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[MAX_Alice - index - row];
-            xDBLe(R, R, A24plus, C24, (int)(2 * m));
-            index += m;
-        }
-        get_4_isog(R, A24plus, C24, coeff);
+    // The private key is an integer in the range [0, 2^(OALICE_BITS-1) - 1], stored in SIGK_SET_SECRETKEYBYTES bytes.  
+    // The shared public key consists of 3 GF(p^2) elements encoded in SIGK_SET_SHAREDPUBLICBYTES bytes.
+    // The shared secret key consists of one GF(p^2) element encoded in SIGK_SET_BYTES bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(ASharedSecretFromC);
+    op_start(&op, SIGK_OP_A_SHARED_SECRET_FROM_C, PrivateKeyA, PublicKeyC, SharedPublicBC, SharedPublicAC, SharedSecret);
+    ret = op_run(&op);
+    PROBE_RETURN(ASharedSecretFromC, ret);
+    return ret;
+}
+
+int BSharedSecretFromA(const unsigned char *PrivateKeyB, const unsigned char *SharedPublicAC, unsigned char *SharedSecret)
+{   // Bob's shared secret key generation 
+    // It generates the shared secret key from Bob's point of view using Alice and Eve shared public key
+    // The private key is an integer in the range [0, 2^Floor(Log(2,3^OBOB_EXPON)) - 1], stored in SIGK_SET_SECRETKEYBYTES bytes.  
+    // The shared secret key consists of one GF(p^2) element encoded in SIGK_SET_BYTES bytes.
+    sigk_op_t op;
+    int ret;
+
+    PROBE_ENTRY(BSharedSecretFromA);
+    op_start(&op, SIGK_OP_B_SHARED_SECRET_FROM_A, PrivateKeyB, SharedPublicAC, NULL, SharedSecret, NULL);
+    ret = op_run(&op);
+    PROBE_RETURN(BSharedSecretFromA, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_A_ws(const unsigned char *PrivateKeyA, unsigned char *PublicKeyA, void *workspace)
+{ // Alice's ephemeral public key generation using the workspace of SIGK_OP_KEYGEN_A
+    int ret = 1;
 
-        for (i = 0; i < npts; i++)
+    PROBE_ENTRY(EphemeralKeyGeneration_A_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_KEYGEN_A, PrivateKeyA, NULL, NULL, PublicKeyA, NULL);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(EphemeralKeyGeneration_A_ws, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_B_ws(const unsigned char *PrivateKeyB, unsigned char *PublicKeyB, void *workspace)
+{ // Bob's ephemeral public key generation using the workspace of SIGK_OP_KEYGEN_B
+    int ret = 1;
+
+    PROBE_ENTRY(EphemeralKeyGeneration_B_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_KEYGEN_B, PrivateKeyB, NULL, NULL, PublicKeyB, NULL);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(EphemeralKeyGeneration_B_ws, ret);
+    return ret;
+}
+
+int EphemeralKeyGeneration_C_ws(const unsigned char *PrivateKeyC, unsigned char *PublicKeyC, void *workspace)
+{ // Eve's ephemeral public key generation using the workspace of SIGK_OP_KEYGEN_C
+    int ret = 1;
+
+    PROBE_ENTRY(EphemeralKeyGeneration_C_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_KEYGEN_C, PrivateKeyC, NULL, NULL, PublicKeyC, NULL);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(EphemeralKeyGeneration_C_ws, ret);
+    return ret;
+}
+
+int BSharedPublicFromA_ws(const unsigned char *PrivateKeyB, const unsigned char *PublicKeyA, unsigned char *SharedPublicAB, void *workspace)
+{ // Bob's shared public key generation using the workspace of SIGK_OP_B_SHARED_PUBLIC_FROM_A
+    int ret = 1;
+
+    PROBE_ENTRY(BSharedPublicFromA_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_B_SHARED_PUBLIC_FROM_A, PrivateKeyB, PublicKeyA, NULL, SharedPublicAB, NULL);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(BSharedPublicFromA_ws, ret);
+    return ret;
+}
+
+int CSharedSecretFromB_ws(const unsigned char *PrivateKeyC, const unsigned char *PublicKeyB, const unsigned char *SharedPublicAB, unsigned char *SharedPublicBC, unsigned char *SharedSecret, void *workspace)
+{ // Eve's shared secret key generation using the workspace of SIGK_OP_C_SHARED_SECRET_FROM_B
+    int ret = 1;
+
+    PROBE_ENTRY(CSharedSecretFromB_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_C_SHARED_SECRET_FROM_B, PrivateKeyC, PublicKeyB, SharedPublicAB, SharedPublicBC, SharedSecret);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(CSharedSecretFromB_ws, ret);
+    return ret;
+}
+
+int ASharedSecretFromC_ws(const unsigned char *PrivateKeyA, const unsigned char *PublicKeyC, const unsigned char *SharedPublicBC, unsigned char *SharedPublicAC, unsigned char *SharedSecret, void *workspace)
+{ // Alice's shared secret key generation using the workspace of SIGK_OP_A_SHARED_SECRET_FROM_C
+    int ret = 1;
+
+    PROBE_ENTRY(ASharedSecretFromC_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_A_SHARED_SECRET_FROM_C, PrivateKeyA, PublicKeyC, SharedPublicBC, SharedPublicAC, SharedSecret);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(ASharedSecretFromC_ws, ret);
+    return ret;
+}
+
+int BSharedSecretFromA_ws(const unsigned char *PrivateKeyB, const unsigned char *SharedPublicAC, unsigned char *SharedSecret, void *workspace)
+{ // Bob's shared secret key generation using the workspace of SIGK_OP_B_SHARED_SECRET_FROM_A
+    int ret = 1;
+
+    PROBE_ENTRY(BSharedSecretFromA_ws);
+    if (workspace_valid(workspace))
+    {
+        op_start((sigk_op_t *)workspace, SIGK_OP_B_SHARED_SECRET_FROM_A, PrivateKeyB, SharedPublicAC, NULL, SharedSecret, NULL);
+        ret = op_run((sigk_op_t *)workspace);
+    }
+    PROBE_RETURN(BSharedSecretFromA_ws, ret);
+    return ret;
+}
+
+// The sizes published by the set hold the encodings: 6 elements of GF(p^2) in a public key, 3 in a shared public key and 1 in a shared secret
+/*********************** Message framing ***********************/
+
+static size_t frame_keys(const unsigned int pass, size_t *pk_bytes, size_t *sp_bytes)
+{ // Sizes of the keys carried by pass "pass", returns the size of the keys or 0 for an unknown pass
+    *pk_bytes = (pass >= 1 && pass <= 3) ? SIGK_SET_PUBLICKEYBYTES : 0;
+    *sp_bytes = (pass >= 2 && pass <= SIGK_NUM_PASSES) ? SIGK_SET_SHAREDPUBLICBYTES : 0;
+    return *pk_bytes + *sp_bytes;
+}
+
+static void frame_header(const unsigned int pass, const size_t keys, unsigned char *header)
+{ // Version, pass, field size in bits and size of the keys, in little endian
+    unsigned int i;
+
+    header[0] = SIGK_FRAME_VERSION;
+    header[1] = (unsigned char)pass;
+    header[2] = (unsigned char)(NBITS_FIELD & 0xFF);
+    header[3] = (unsigned char)(NBITS_FIELD >> 8);
+    for (i = 0; i < 4; i++)
+        header[4 + i] = (unsigned char)(keys >> (8 * i));
+}
+
+static void key_clear_padding(unsigned char *key, const size_t bytes)
+{ // Clear the bytes of a key past its encoded elements, which the operations leave untouched
+    size_t i;
+
+    for (i = (bytes / FP2_ENCODED_BYTES) * FP2_ENCODED_BYTES; i < bytes; i++)
+        key[i] = 0;
+}
+
+static int key_check(const unsigned char *key, const size_t bytes)
+{ // Returns 0 if the encoded elements of a received key are reduced and its padding is zero. Keys are public, the check need not be constant time.
+    unsigned int i, nelems = (unsigned int)(bytes / FP2_ENCODED_BYTES);
+    unsigned char pad = 0;
+    size_t j;
+
+    for (i = 0; i < nelems; i++)
+    {
+        if (fp2_reduced(key + i * FP2_ENCODED_BYTES) == 0)
+            return 1;
+    }
+    for (j = (size_t)nelems * FP2_ENCODED_BYTES; j < bytes; j++)
+        pad |= key[j];
+    return (pad != 0);
+}
+
+static int frame_check(const unsigned int pass, const unsigned char *header, const unsigned char *pk, const unsigned char *sp)
+{ // Check the header and the keys of a received message, the keys not carried by the pass are NULL
+    unsigned char expected[SIGK_FRAME_HEADER_BYTES], diff = 0;
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    unsigned int i;
+
+    if (keys == 0)
+        return 1;
+    frame_header(pass, keys, expected);
+    for (i = 0; i < SIGK_FRAME_HEADER_BYTES; i++)
+        diff |= header[i] ^ expected[i];
+    if (diff != 0)
+        return 1;
+    return (pk != NULL && key_check(pk, pk_bytes) != 0) || (sp != NULL && key_check(sp, sp_bytes) != 0);
+}
+
+size_t sigk_frame_bytes(unsigned int pass)
+{ // Size of the message of a pass
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    size_t bytes = (keys == 0) ? 0 : SIGK_FRAME_HEADER_BYTES + keys;
+
+    PROBE_ENTRY(sigk_frame_bytes);
+    PROBE_RETURN(sigk_frame_bytes, bytes);
+    return bytes;
+}
+
+int sigk_frame_init(unsigned int pass, unsigned char *msg, unsigned char **PublicKey, unsigned char **SharedPublic)
+{ // Header of a contiguous message, the operations then write the keys in place
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    unsigned char *pk = NULL, *sp = NULL;
+    int ret = 1;
+
+    PROBE_ENTRY(sigk_frame_init);
+    if (keys != 0)
+    {
+        frame_header(pass, keys, msg);
+        if (pk_bytes != 0)
         {
-            eval_4_isog(pts[i], coeff);
+            pk = msg + SIGK_FRAME_HEADER_BYTES;
+            key_clear_padding(pk, pk_bytes);
         }
-        eval_4_isog(phiC_PB, coeff);
-        eval_4_isog(phiC_QB, coeff);
-        eval_4_isog(phiC_RB, coeff);
-
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
-    }
-    get_4_isog(R, A24plus, C24, coeff);
-    eval_4_isog(phiC_PB, coeff);
-    eval_4_isog(phiC_QB, coeff);
-    eval_4_isog(phiC_RB, coeff);
-
-    inv_3_way(phiC_PB->Z, phiC_QB->Z, phiC_RB->Z);
-    fp2mul_mont(phiC_PB->X, phiC_PB->Z, phiC_PB->X);
-    fp2mul_mont(phiC_QB->X, phiC_QB->Z, phiC_QB->X);
-    fp2mul_mont(phiC_RB->X, phiC_RB->Z, phiC_RB->X);
-
-    // Format public key
-    fp2_encode(phiC_PB->X, SharedPublicAC);                         // phiA(phiC(PB))
-    fp2_encode(phiC_QB->X, SharedPublicAC + FP2_ENCODED_BYTES);     // phiA(phiC(QB))
-    fp2_encode(phiC_RB->X, SharedPublicAC + 2 * FP2_ENCODED_BYTES); // phiA(phiC(RB))
-
-    fp2zero(A);
-    fp2zero(A24plus);
-    fp2zero(C24);
-    // Compute the shared secret
-    get_A(PKBC[0], PKBC[1], PKBC[2], A); // Retrieve E_C
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, C24[0]);
-    fp2add(A, C24, A24plus);
-    fpadd(C24[0], C24[0], C24[0]);
-
-    // Retrieve kernel point
-    LADDER3PT(PKBC[0], PKBC[1], PKBC[2], (digit_t *)PrivateKeyA, ALICE, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Alice; row++)
-    {
-        while (index < MAX_Alice - row)
+        if (sp_bytes != 0)
         {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Alice[MAX_Alice - index - row];
-            xDBLe(R, R, A24plus, C24, (int)(2 * m));
-            index += m;
+            sp = msg + SIGK_FRAME_HEADER_BYTES + pk_bytes;
+            key_clear_padding(sp, sp_bytes);
         }
-        get_4_isog(R, A24plus, C24, coeff);
+        ret = 0;
+    }
+    if (PublicKey != NULL)
+        *PublicKey = pk;
+    if (SharedPublic != NULL)
+        *SharedPublic = sp;
+    PROBE_RETURN(sigk_frame_init, ret);
+    return ret;
+}
 
-        for (i = 0; i < npts; i++)
-        {
-            eval_4_isog(pts[i], coeff);
-        }
+int sigk_frame_parse(unsigned int pass, const unsigned char *msg, size_t len, const unsigned char **PublicKey, const unsigned char **SharedPublic)
+{ // Check a contiguous message and locate its keys without copying them
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    const unsigned char *pk = NULL, *sp = NULL;
+    int ret = 1;
 
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
+    PROBE_ENTRY(sigk_frame_parse);
+    if (keys != 0 && msg != NULL && len == SIGK_FRAME_HEADER_BYTES + keys)
+    {
+        pk = (pk_bytes != 0) ? msg + SIGK_FRAME_HEADER_BYTES : NULL;
+        sp = (sp_bytes != 0) ? msg + SIGK_FRAME_HEADER_BYTES + pk_bytes : NULL;
+        ret = frame_check(pass, msg, pk, sp);
     }
-    get_4_isog(R, A24plus, C24, coeff);
-    fp2div2(C24, C24);
-    fp2sub(A24plus, C24, A24plus);
-    fp2div2(C24, C24);
-    j_inv(A24plus, C24, jinv);
-    fp2_encode(jinv, SharedSecret); // Format shared secret
-
-    return 0;
+    if (ret != 0)
+        pk = sp = NULL;
+    if (PublicKey != NULL)
+        *PublicKey = pk;
+    if (SharedPublic != NULL)
+        *SharedPublic = sp;
+    PROBE_RETURN(sigk_frame_parse, ret);
+    return ret;
 }
 
-int BSharedSecretFromA(const unsigned char *PrivateKeyB, const unsigned char *SharedPublicAC, unsigned char *SharedSecret)
-{   // Bob's shared secret key generation 
-    // It generates the shared secret key from Bob's point of view using Alice and Eve shared public key
-    // The private key is an integer in the range [0, 2^Floor(Log(2,3^153)) - 1], stored in 48 bytes.  
-    // The shared secret key consists of one GF(p747^2) element encoded in 190 bytes.
-    point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKAC[3], jinv;
-    f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
-    unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
-
-    // Initialize images of Alice's basis
-    fp2_decode(SharedPublicAC, PKAC[0]);
-    fp2_decode(SharedPublicAC + FP2_ENCODED_BYTES, PKAC[1]);
-    fp2_decode(SharedPublicAC + 2 * FP2_ENCODED_BYTES, PKAC[2]);
-
-    // Initialize constants
-    get_A(PKAC[0], PKAC[1], PKAC[2], A); // Retrieve E_AC
-    fpadd((digit_t *)&Montgomery_one, (digit_t *)&Montgomery_one, A24minus[0]);
-    fp2add(A, A24minus, A24plus);
-    fp2sub(A, A24minus, A24minus);
-
-    // Retrieve kernel point
-    LADDER3PT(PKAC[0], PKAC[1], PKAC[2], (digit_t *)PrivateKeyB, BOB, R, A);
-
-    // Traverse tree
-    index = 0;
-    for (row = 1; row < MAX_Bob; row++)
-    {
-        while (index < MAX_Bob - row)
+#if !defined(__WINDOWS__)
+int sigk_frame_iov(unsigned int pass, unsigned char *header, unsigned char *PublicKey, unsigned char *SharedPublic, struct iovec *iov)
+{ // Gather list of the header and the keys of a message, the keys stay in the caller's buffers
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    int n = 0;
+
+    PROBE_ENTRY(sigk_frame_iov);
+    if (keys != 0 && !(pk_bytes != 0 && PublicKey == NULL) && !(sp_bytes != 0 && SharedPublic == NULL))
+    {
+        frame_header(pass, keys, header);
+        iov[n].iov_base = header;
+        iov[n++].iov_len = SIGK_FRAME_HEADER_BYTES;
+        if (pk_bytes != 0)
         {
-            fp2copy(R->X, pts[npts]->X);
-            fp2copy(R->Z, pts[npts]->Z);
-            pts_index[npts++] = index;
-            m = strat_Bob[MAX_Bob - index - row];
-            xTPLe(R, R, A24minus, A24plus, (int)m);
-            index += m;
+            key_clear_padding(PublicKey, pk_bytes);
+            iov[n].iov_base = PublicKey;
+            iov[n++].iov_len = pk_bytes;
         }
-        get_3_isog(R, A24minus, A24plus, coeff);
-
-        for (i = 0; i < npts; i++)
+        if (sp_bytes != 0)
         {
-            eval_3_isog(pts[i], coeff);
+            key_clear_padding(SharedPublic, sp_bytes);
+            iov[n].iov_base = SharedPublic;
+            iov[n++].iov_len = sp_bytes;
         }
-
-        fp2copy(pts[npts - 1]->X, R->X);
-        fp2copy(pts[npts - 1]->Z, R->Z);
-        index = pts_index[npts - 1];
-        npts -= 1;
     }
-    get_3_isog(R, A24minus, A24plus, coeff);
-    fp2add(A24plus, A24minus, A);
-    fp2add(A, A, A);
-    fp2sub(A24plus, A24minus, A24plus);
-    j_inv(A, A24plus, jinv);
-    fp2_encode(jinv, SharedSecret); // Format shared secret
+    PROBE_RETURN(sigk_frame_iov, n);
+    return n;
+}
 
-    return 0;
+int sigk_frame_parse_iov(unsigned int pass, const struct iovec *iov, int iovcnt, const unsigned char **PublicKey, const unsigned char **SharedPublic)
+{ // Check a message received in the layout of sigk_frame_iov() and locate its keys without copying them
+    size_t pk_bytes, sp_bytes, keys = frame_keys(pass, &pk_bytes, &sp_bytes);
+    const unsigned char *pk = NULL, *sp = NULL;
+    int n = 1, ret = 1;
+
+    PROBE_ENTRY(sigk_frame_parse_iov);
+    if (keys != 0 && iov != NULL && iovcnt == 1 + (pk_bytes != 0) + (sp_bytes != 0) && iov[0].iov_len == SIGK_FRAME_HEADER_BYTES)
+    {
+        ret = 0;
+        if (pk_bytes != 0)
+        {
+            pk = (const unsigned char *)iov[n].iov_base;
+            ret |= (iov[n++].iov_len != pk_bytes);
+        }
+        if (sp_bytes != 0)
+        {
+            sp = (const unsigned char *)iov[n].iov_base;
+            ret |= (iov[n].iov_len != sp_bytes);
+        }
+        if (ret == 0)
+            ret = frame_check(pass, (const unsigned char *)iov[0].iov_base, pk, sp);
+    }
+    if (ret != 0)
+        pk = sp = NULL;
+    if (PublicKey != NULL)
+        *PublicKey = pk;
+    if (SharedPublic != NULL)
+        *SharedPublic = sp;
+    PROBE_RETURN(sigk_frame_parse_iov, ret);
+    return ret;
 }
+#endif
+
+typedef char publickey_holds_encoding[(SIGK_SET_PUBLICKEYBYTES >= 6 * (FP2_ENCODED_BYTES)) ? 1 : -1];
+typedef char sharedpublic_holds_encoding[(SIGK_SET_SHAREDPUBLICBYTES >= 3 * (FP2_ENCODED_BYTES)) ? 1 : -1];
+typedef char sharedsecret_holds_encoding[(SIGK_SET_BYTES >= (FP2_ENCODED_BYTES)) ? 1 : -1];
+
+// Descriptor of the set in the registry of params.c
+const sigk_params_t SIGK_NAME(sigk_params) = {
+    SIGK_SET_ALGNAME, SIGK_SET_SECRETKEYBYTES, SIGK_SET_PUBLICKEYBYTES, SIGK_SET_SHAREDPUBLICBYTES, SIGK_SET_BYTES,
+    random_mod_order_A, random_mod_order_B, random_mod_order_C,
+    EphemeralKeyGeneration_A, EphemeralKeyGeneration_B, EphemeralKeyGeneration_C,
+    BSharedPublicFromA, CSharedSecretFromB, ASharedSecretFromC, BSharedSecretFromA,
+    sigk_start_EphemeralKeyGeneration_A, sigk_start_EphemeralKeyGeneration_B, sigk_start_EphemeralKeyGeneration_C,
+    sigk_start_BSharedPublicFromA, sigk_start_CSharedSecretFromB, sigk_start_ASharedSecretFromC, sigk_start_BSharedSecretFromA,
+    sigk_step, sigk_workspace_size,
+    EphemeralKeyGeneration_A_ws, EphemeralKeyGeneration_B_ws, EphemeralKeyGeneration_C_ws,
+    BSharedPublicFromA_ws, CSharedSecretFromB_ws, ASharedSecretFromC_ws, BSharedSecretFromA_ws,
+    sigk_frame_bytes, sigk_frame_init, sigk_frame_parse,
+#if !defined(__WINDOWS__)
+    sigk_frame_iov, sigk_frame_parse_iov
+#endif
+};
@@ -0,0 +1,110 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: state shared by the parameter sets and registry of the sets
+* The trace hook and the operation counters are common to all sets, so that a tracer or a benchmark sees
+* the operations of every set. The registry lists the descriptors defined by groupKey.c in each set.
+*********************************************************************************************/
+
+#include <string.h>
+#include "sigk_internal.h"
+#include "sigk_sdt.h"
+#if defined(__WINDOWS__)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Static probes of the "sigk" provider at the entry and return of the functions of api.h
+#define PROBE_ENTRY(fn) SIGK_PROBE0(sigk, fn##__entry)
+#define PROBE_EXIT(fn) SIGK_PROBE0(sigk, fn##__return)
+#define PROBE_RETURN(fn, ret) SIGK_PROBE1(sigk, fn##__return, ret)
+
+extern const sigk_params_t sigk_params_p747, sigk_params_p376;
+
+// Registry of the parameter sets, the default set first
+static const sigk_params_t *const params[] = {&sigk_params_p747, &sigk_params_p376};
+
+#define NUM_PARAMS (sizeof(params) / sizeof(params[0]))
+
+// Hook called at the phase boundaries of all operations, see sigk_set_trace_hook()
+sigk_trace_hook_t sigk_trace_hook = NULL;
+static void *trace_ctx = NULL;
+
+#if defined(SIGK_COUNT_OPS)
+SIGK_THREAD_LOCAL sigk_opcount_t sigk_opcount;
+#endif
+
+static uint64_t trace_clock(void)
+{ // Monotonic time in nanoseconds
+#if defined(__WINDOWS__)
+    LARGE_INTEGER count, freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (uint64_t)(count.QuadPart / freq.QuadPart) * 1000000000 + (uint64_t)((count.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void sigk_trace_event(const unsigned int op, const unsigned int phase, const unsigned int event)
+{ // Report a phase boundary to the registered hook
+    sigk_trace_hook(trace_ctx, op, phase, event, trace_clock());
+}
+
+void sigk_set_trace_hook(sigk_trace_hook_t hook, void *ctx)
+{ // Register the trace hook of all operations, a NULL hook disables tracing
+    PROBE_ENTRY(sigk_set_trace_hook);
+    trace_ctx = ctx;
+    sigk_trace_hook = hook;
+    PROBE_EXIT(sigk_set_trace_hook);
+}
+
+int sigk_opcount_snapshot(sigk_opcount_t *counts)
+{ // Copy the operation counters of the calling thread
+#if defined(SIGK_COUNT_OPS)
+    const int ret = 0;
+
+    PROBE_ENTRY(sigk_opcount_snapshot);
+    *counts = sigk_opcount;
+#else
+    const sigk_opcount_t zero = {0};
+    const int ret = 1;
+
+    PROBE_ENTRY(sigk_opcount_snapshot);
+    *counts = zero;
+#endif
+    PROBE_RETURN(sigk_opcount_snapshot, ret);
+    return ret;
+}
+
+const sigk_params_t *sigk_params_get(const char *name)
+{ // Look up a parameter set by its algorithm name
+    const sigk_params_t *p = NULL;
+    unsigned int i;
+
+    PROBE_ENTRY(sigk_params_get);
+    for (i = 0; i < NUM_PARAMS && name != NULL; i++)
+    {
+        if (strcmp(params[i]->name, name) == 0)
+        {
+            p = params[i];
+            break;
+        }
+    }
+    PROBE_RETURN(sigk_params_get, p != NULL);
+    return p;
+}
+
+const sigk_params_t *sigk_params_at(unsigned int index)
+{ // Parameter set at position "index" of the registry
+    const sigk_params_t *p = (index < NUM_PARAMS) ? params[index] : NULL;
+
+    PROBE_ENTRY(sigk_params_at);
+    PROBE_RETURN(sigk_params_at, p != NULL);
+    return p;
+}
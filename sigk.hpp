@@ -0,0 +1,205 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: header-only C++20 interface for P747
+* Fixed-size key types backed by std::array and noexcept functions over std::span that call the C API of api.h
+* directly on the caller's buffers. The header makes no heap allocations and no copies of keys: the functions write
+* their outputs in place. Private keys and shared secrets are move-only and are wiped when destroyed.
+*********************************************************************************************/
+
+#ifndef __P747_API_HPP__
+#define __P747_API_HPP__
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include "api.h"
+
+namespace sigk {
+
+inline constexpr std::size_t secret_key_bytes = CRYPTO_SECRETKEYBYTES;
+inline constexpr std::size_t public_key_bytes = CRYPTO_PUBLICKEYBYTES;
+inline constexpr std::size_t shared_public_bytes = CRYPTO_SHAREDPUBLICBYTES;
+inline constexpr std::size_t shared_secret_bytes = CRYPTO_BYTES;
+
+// Parties of the group key exchange. Their private keys have different ranges, see api.h.
+enum class party { A, B, C };
+
+template <std::size_t N> using bytes_view = std::span<const unsigned char, N>;
+template <std::size_t N> using bytes_out = std::span<unsigned char, N>;
+
+namespace detail {
+
+inline void wipe(unsigned char* p, std::size_t n) noexcept
+{ // Clear n bytes, the volatile writes are not removed by the compiler
+    volatile unsigned char* v = p;
+    for (std::size_t i = 0; i < n; i++)
+        v[i] = 0;
+}
+
+// Public value of N bytes, freely copyable
+template <std::size_t N, class Tag>
+class public_bytes {
+public:
+    static constexpr std::size_t size() noexcept { return N; }
+    unsigned char* data() noexcept { return bytes_.data(); }
+    const unsigned char* data() const noexcept { return bytes_.data(); }
+    bytes_out<N> span() noexcept { return bytes_out<N>(bytes_); }
+    bytes_view<N> span() const noexcept { return bytes_view<N>(bytes_); }
+    operator bytes_out<N>() noexcept { return span(); }
+    operator bytes_view<N>() const noexcept { return span(); }
+    friend bool operator==(const public_bytes&, const public_bytes&) = default;
+
+private:
+    std::array<unsigned char, N> bytes_{};
+};
+
+// Secret value of N bytes. It cannot be copied, a move leaves the source wiped, and it is wiped on destruction.
+template <std::size_t N, class Tag>
+class secret_bytes {
+public:
+    secret_bytes() noexcept = default;
+    secret_bytes(const secret_bytes&) = delete;
+    secret_bytes& operator=(const secret_bytes&) = delete;
+    secret_bytes(secret_bytes&& other) noexcept : bytes_(other.bytes_) { other.wipe(); }
+    secret_bytes& operator=(secret_bytes&& other) noexcept
+    {
+        if (this != &other)
+        {
+            bytes_ = other.bytes_;
+            other.wipe();
+        }
+        return *this;
+    }
+    ~secret_bytes() { wipe(); }
+
+    void wipe() noexcept { detail::wipe(bytes_.data(), N); }
+    static constexpr std::size_t size() noexcept { return N; }
+    unsigned char* data() noexcept { return bytes_.data(); }
+    const unsigned char* data() const noexcept { return bytes_.data(); }
+    bytes_out<N> span() noexcept { return bytes_out<N>(bytes_); }
+    bytes_view<N> span() const noexcept { return bytes_view<N>(bytes_); }
+    operator bytes_out<N>() noexcept { return span(); }
+    operator bytes_view<N>() const noexcept { return span(); }
+
+    friend bool operator==(const secret_bytes& a, const secret_bytes& b) noexcept
+    { // Comparison in constant time
+        unsigned char diff = 0;
+        for (std::size_t i = 0; i < N; i++)
+            diff |= (unsigned char)(a.bytes_[i] ^ b.bytes_[i]);
+        return diff == 0;
+    }
+
+private:
+    std::array<unsigned char, N> bytes_{};
+};
+
+struct public_key_tag;
+struct shared_public_tag;
+struct shared_secret_tag;
+template <party P> struct private_key_tag;
+
+} // namespace detail
+
+// Key types, zero-initialized. The private keys of the three parties are distinct types, so that a key cannot be passed for the wrong party.
+template <party P> using private_key = detail::secret_bytes<secret_key_bytes, detail::private_key_tag<P>>;
+using private_key_A = private_key<party::A>;
+using private_key_B = private_key<party::B>;
+using private_key_C = private_key<party::C>;
+using public_key = detail::public_bytes<public_key_bytes, detail::public_key_tag>;
+using shared_public = detail::public_bytes<shared_public_bytes, detail::shared_public_tag>;
+using shared_secret = detail::secret_bytes<shared_secret_bytes, detail::shared_secret_tag>;
+
+/*********************** Functions over spans ***********************/
+// Same functions as in api.h on fixed-size spans, which can view the key types above or any caller buffer.
+// The functions returning int return 0 on success.
+
+inline void random_mod_order_A(bytes_out<secret_key_bytes> sk) noexcept { ::random_mod_order_A(sk.data()); }
+inline void random_mod_order_B(bytes_out<secret_key_bytes> sk) noexcept { ::random_mod_order_B(sk.data()); }
+inline void random_mod_order_C(bytes_out<secret_key_bytes> sk) noexcept { ::random_mod_order_C(sk.data()); }
+
+[[nodiscard]] inline int EphemeralKeyGeneration_A(bytes_view<secret_key_bytes> skA, bytes_out<public_key_bytes> pkA) noexcept
+{
+    return ::EphemeralKeyGeneration_A(skA.data(), pkA.data());
+}
+
+[[nodiscard]] inline int EphemeralKeyGeneration_B(bytes_view<secret_key_bytes> skB, bytes_out<public_key_bytes> pkB) noexcept
+{
+    return ::EphemeralKeyGeneration_B(skB.data(), pkB.data());
+}
+
+[[nodiscard]] inline int EphemeralKeyGeneration_C(bytes_view<secret_key_bytes> skC, bytes_out<public_key_bytes> pkC) noexcept
+{
+    return ::EphemeralKeyGeneration_C(skC.data(), pkC.data());
+}
+
+[[nodiscard]] inline int BSharedPublicFromA(bytes_view<secret_key_bytes> skB, bytes_view<public_key_bytes> pkA, bytes_out<shared_public_bytes> spAB) noexcept
+{
+    return ::BSharedPublicFromA(skB.data(), pkA.data(), spAB.data());
+}
+
+[[nodiscard]] inline int CSharedSecretFromB(bytes_view<secret_key_bytes> skC, bytes_view<public_key_bytes> pkB, bytes_view<shared_public_bytes> spAB,
+                                            bytes_out<shared_public_bytes> spBC, bytes_out<shared_secret_bytes> ss) noexcept
+{
+    return ::CSharedSecretFromB(skC.data(), pkB.data(), spAB.data(), spBC.data(), ss.data());
+}
+
+[[nodiscard]] inline int ASharedSecretFromC(bytes_view<secret_key_bytes> skA, bytes_view<public_key_bytes> pkC, bytes_view<shared_public_bytes> spBC,
+                                            bytes_out<shared_public_bytes> spAC, bytes_out<shared_secret_bytes> ss) noexcept
+{
+    return ::ASharedSecretFromC(skA.data(), pkC.data(), spBC.data(), spAC.data(), ss.data());
+}
+
+[[nodiscard]] inline int BSharedSecretFromA(bytes_view<secret_key_bytes> skB, bytes_view<shared_public_bytes> spAC, bytes_out<shared_secret_bytes> ss) noexcept
+{
+    return ::BSharedSecretFromA(skB.data(), spAC.data(), ss.data());
+}
+
+/*********************** Functions over the key types ***********************/
+// Overloads taking the private key of the right party.
+
+template <party P>
+inline void generate(private_key<P>& sk) noexcept
+{ // Random private key of party P
+    if constexpr (P == party::A)
+        ::random_mod_order_A(sk.data());
+    else if constexpr (P == party::B)
+        ::random_mod_order_B(sk.data());
+    else
+        ::random_mod_order_C(sk.data());
+}
+
+template <party P>
+[[nodiscard]] inline int public_key_from(const private_key<P>& sk, public_key& pk) noexcept
+{ // Ephemeral public key of party P
+    if constexpr (P == party::A)
+        return ::EphemeralKeyGeneration_A(sk.data(), pk.data());
+    else if constexpr (P == party::B)
+        return ::EphemeralKeyGeneration_B(sk.data(), pk.data());
+    else
+        return ::EphemeralKeyGeneration_C(sk.data(), pk.data());
+}
+
+[[nodiscard]] inline int BSharedPublicFromA(const private_key_B& skB, const public_key& pkA, shared_public& spAB) noexcept
+{
+    return ::BSharedPublicFromA(skB.data(), pkA.data(), spAB.data());
+}
+
+[[nodiscard]] inline int CSharedSecretFromB(const private_key_C& skC, const public_key& pkB, const shared_public& spAB, shared_public& spBC, shared_secret& ss) noexcept
+{
+    return ::CSharedSecretFromB(skC.data(), pkB.data(), spAB.data(), spBC.data(), ss.data());
+}
+
+[[nodiscard]] inline int ASharedSecretFromC(const private_key_A& skA, const public_key& pkC, const shared_public& spBC, shared_public& spAC, shared_secret& ss) noexcept
+{
+    return ::ASharedSecretFromC(skA.data(), pkC.data(), spBC.data(), spAC.data(), ss.data());
+}
+
+[[nodiscard]] inline int BSharedSecretFromA(const private_key_B& skB, const shared_public& spAC, shared_secret& ss) noexcept
+{
+    return ::BSharedSecretFromA(skB.data(), spAC.data(), ss.data());
+}
+
+} // namespace sigk
+
+#endif
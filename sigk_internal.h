@@ -0,0 +1,485 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: internal declarations shared by the parameter sets
+* A parameter set P<n> is compiled as the single translation unit P<n>.c. Its header P<n>_internal.h defines
+* the field size, the limb counts, the subgroup orders and the strategy sizes of the set, then includes this
+* file, which derives the types and declares the field, curve and isogeny functions. Every such function is
+* renamed with the suffix of the set (e.g., xDBL becomes xDBL_p747), so that the code of fpx.c, ec_isogeny.c
+* and groupKey.c can be compiled once per set into the same library. The functions of api.h keep their names
+* for the default set SIGKp747 and take the suffix of the set otherwise, see P376_api.h.
+* Included without a parameter set (params.c), it only declares the state shared by all sets.
+*********************************************************************************************/
+
+#ifndef __SIGK_INTERNAL_H__
+#define __SIGK_INTERNAL_H__
+
+#include "api.h"
+
+// Names of the symbols of a parameter set
+
+#define SIGK_PASTE(name, suffix) name##_##suffix
+#define SIGK_SUFFIX(name, suffix) SIGK_PASTE(name, suffix)
+#define SIGK_NAME(name) SIGK_SUFFIX(name, SIGK_SET)         // Internal functions and descriptor of the set, suffixed with SIGK_SET
+#define SIGK_API(name) SIGK_SUFFIX(name, SIGK_API_SET)      // Functions of api.h, suffixed with SIGK_API_SET
+
+// Operation counters, enabled with -D SIGK_COUNT_OPS. Without it the counting macros expand to nothing.
+
+#if defined(SIGK_COUNT_OPS)
+    #if (COMPILER == COMPILER_VC)
+        #define SIGK_THREAD_LOCAL __declspec(thread)
+    #else
+        #define SIGK_THREAD_LOCAL __thread
+    #endif
+extern SIGK_THREAD_LOCAL sigk_opcount_t sigk_opcount; // Counters of the calling thread, shared by all parameter sets
+    #define COUNT_OPS(field, n) (sigk_opcount.field += (n))
+#else
+    #define COUNT_OPS(field, n)
+#endif
+#define COUNT_OP(field) COUNT_OPS(field, 1)
+
+// Phase tracing, the hook registered with sigk_set_trace_hook() is shared by all parameter sets
+
+extern sigk_trace_hook_t sigk_trace_hook;
+
+// Report a phase boundary to the registered hook
+void sigk_trace_event(const unsigned int op, const unsigned int phase, const unsigned int event);
+
+// Worker threads shared by all parameter sets, see sigk_set_workers()
+
+typedef void (*sigk_job_t)(void *ctx, const unsigned int part, const unsigned int nparts);
+
+// Number of threads that can share a job, the calling thread included
+unsigned int sigk_workers_cores(void);
+
+// Run job(ctx, part, nparts) for each part in [0, nparts-1], on the workers if they are free, and return when all parts are done
+void sigk_workers_run(sigk_job_t job, void *ctx, const unsigned int nparts);
+
+#if defined(NBITS_FIELD)
+
+// Basic constants derived from the parameters of the set
+
+#define MAXWORDS_FIELD ((MAXBITS_FIELD + RADIX - 1) / RADIX) // Max. number of words to represent field elements
+#define NWORDS64_FIELD ((NBITS_FIELD + 63) / 64)             // Number of 64-bit words of a field element
+#define NWORDS_ORDER ((NBITS_ORDER + RADIX - 1) / RADIX)     // Number of words of oA, oB and oC, the subgroup orders of Alice, Bob and Eve, resp.
+#define NWORDS64_ORDER ((NBITS_ORDER + 63) / 64)             // Number of 64-bit words of an element of the orders
+#define MAXBITS_ORDER NBITS_ORDER
+#define MAXWORDS_ORDER ((MAXBITS_ORDER + RADIX - 1) / RADIX) // Max. number of words to represent elements in [1, oA-1], [1, oB] or [1, oC].
+#define ALICE 0
+#define BOB 1
+#define EVE 2
+#define PARAM_A 0
+#define PARAM_C 1
+#define SECRETKEY_A_BYTES (OALICE_BITS + 7) / 8
+#define SECRETKEY_B_BYTES (OBOB_BITS + 7) / 8
+#define SECRETKEY_E_BYTES (OEVE_BITS + 7) / 8
+#define FP2_ENCODED_BYTES (2 * ((NBITS_FIELD + 7) / 8))
+
+// SIDH's basic element definitions and point representations
+
+typedef digit_t felm_t[NWORDS_FIELD];      // Datatype for representing NBITS_FIELD-bit field elements (MAXBITS_FIELD-bit max.)
+typedef digit_t dfelm_t[2 * NWORDS_FIELD]; // Datatype for representing double-precision 2xNBITS_FIELD-bit field elements (2xMAXBITS_FIELD-bit max.)
+typedef felm_t f2elm_t[2];                 // Datatype for representing quadratic extension field elements GF(p^2)
+typedef f2elm_t publickey_t[3];            // Datatype for representing public keys equivalent to three GF(p^2) elements
+
+typedef struct
+{
+    f2elm_t X;
+    f2elm_t Z;
+} point_proj; // Point representation in projective XZ Montgomery coordinates.
+typedef point_proj point_proj_t[1];
+
+#define EVAL_BLOCK 4          // Number of points held by a point_block
+#define MAX_TRACKED_POINTS 7  // Images of two bases of the other parties plus alpha
+#define POINT_BLOCKS(npts) (((npts) + MAX_TRACKED_POINTS + EVAL_BLOCK - 1) / EVAL_BLOCK) // Blocks holding the tracked points and npts stored points
+
+typedef struct
+{
+    ALIGN_CACHE_LINE f2elm_t X[EVAL_BLOCK];
+    ALIGN_CACHE_LINE f2elm_t Z[EVAL_BLOCK];
+} point_block; // Structure-of-arrays storage of EVAL_BLOCK projective points, evaluated together by the eval_*_isog_multi functions.
+
+typedef struct
+{
+    unsigned int role;                     // ALICE, BOB or EVE, selects the isogeny degree and the strategy
+    unsigned int jinv;                     // Output of the walk: 1 for the j-invariant, 0 for the normalized tracked images
+    f2elm_t xP, xQ, xPQ;                   // Affine x-coordinates of the basis points defining the kernel
+    f2elm_t A, A24plus, A24minus, C24;     // Projective curve constants of the current curve
+    f2elm_t coeff[3];                      // Coefficients of the current 3- or 4-isogeny
+    f2elm_t A24;                           // Ladder constant (A+2)/4
+    point_proj_t R0, R2, R;                // Ladder points, R holds the current kernel point during the traversal
+    unsigned int bit, nbits;               // Next ladder bit and number of ladder bits
+    unsigned int pts_index[MAX_INT_POINTS];
+    unsigned int npts, index, row;
+    const unsigned int *splits;            // Strategy whose splits are listed in traversal order, or NULL for the size-indexed strategy of the role
+    unsigned int split;                    // Next entry of splits
+    unsigned int cores;                    // Threads sharing the isogeny evaluations, see sigk_workers_run()
+    unsigned int nphi;                     // Number of tracked images, stored first in the pool
+    unsigned int use_alpha;                // 1 if the image of the 2-torsion point alpha follows the tracked images, used to recover
+                                           // the curve in Eve's key generation
+    unsigned int e0;                       // 1 while the walk is on the base curve E0, until its first isogeny
+    unsigned int base;                     // Pool index of the first intermediate point stored during the strategy traversal
+    point_block pool[POINT_BLOCKS(MAX_INT_POINTS)]; // Tracked images, alpha and stored points, all pushed through each isogeny at once.
+                                           // Must be the last member: a workspace only holds the blocks used by the strategy of its role
+} walk_state; // State of one isogeny walk: kernel point computation followed by the strategy traversal.
+
+typedef struct
+{
+    unsigned int op;                       // Operation identifier, SIGK_OP_*
+    unsigned int stage;                    // Next stage to be executed
+    unsigned int walk;                     // Index of the current walk, operations producing a shared secret run two walks
+    unsigned int nwalks;
+    const unsigned char *sk;               // Caller-owned inputs and outputs
+    const unsigned char *in[2];
+    unsigned char *out[2];
+    walk_state w;                          // Must be the last member, see walk_state.pool
+} op_state; // State of a resumable group key operation, stored inside a sigk_op_t or a caller-provided workspace.
+
+// Internal functions of the set. The macros are function-like so that the fields of sigk_opcount_t named after them are left unchanged.
+
+#define copy_words(...) SIGK_NAME(copy_words)(__VA_ARGS__)
+#define mp_add(...) SIGK_NAME(mp_add)(__VA_ARGS__)
+#define mp_sub(...) SIGK_NAME(mp_sub)(__VA_ARGS__)
+#define mp_shiftleft(...) SIGK_NAME(mp_shiftleft)(__VA_ARGS__)
+#define mp_shiftr1(...) SIGK_NAME(mp_shiftr1)(__VA_ARGS__)
+#define mp_shiftl1(...) SIGK_NAME(mp_shiftl1)(__VA_ARGS__)
+#define digit_x_digit(...) SIGK_NAME(digit_x_digit)(__VA_ARGS__)
+#define MUL64(...) SIGK_NAME(MUL64)(__VA_ARGS__)
+#define mp_mul(...) SIGK_NAME(mp_mul)(__VA_ARGS__)
+#define multiply(...) SIGK_NAME(multiply)(__VA_ARGS__)
+#define Montgomery_multiply_mod_order(...) SIGK_NAME(Montgomery_multiply_mod_order)(__VA_ARGS__)
+#define Montgomery_inversion_mod_order_bingcd(...) SIGK_NAME(Montgomery_inversion_mod_order_bingcd)(__VA_ARGS__)
+#define to_Montgomery_mod_order(...) SIGK_NAME(to_Montgomery_mod_order)(__VA_ARGS__)
+#define from_Montgomery_mod_order(...) SIGK_NAME(from_Montgomery_mod_order)(__VA_ARGS__)
+#define inv_mod_orderA(...) SIGK_NAME(inv_mod_orderA)(__VA_ARGS__)
+#define fpcopy(...) SIGK_NAME(fpcopy)(__VA_ARGS__)
+#define fpzero(...) SIGK_NAME(fpzero)(__VA_ARGS__)
+#define fpequal_non_constant_time(...) SIGK_NAME(fpequal_non_constant_time)(__VA_ARGS__)
+#define fpadd(...) SIGK_NAME(fpadd)(__VA_ARGS__)
+#define fpsub(...) SIGK_NAME(fpsub)(__VA_ARGS__)
+#define fpneg(...) SIGK_NAME(fpneg)(__VA_ARGS__)
+#define fpdiv2(...) SIGK_NAME(fpdiv2)(__VA_ARGS__)
+#define fpcorrection(...) SIGK_NAME(fpcorrection)(__VA_ARGS__)
+#define rdc_mont(...) SIGK_NAME(rdc_mont)(__VA_ARGS__)
+#define fpmul_mont(...) SIGK_NAME(fpmul_mont)(__VA_ARGS__)
+#define fpsqr_mont(...) SIGK_NAME(fpsqr_mont)(__VA_ARGS__)
+#define to_mont(...) SIGK_NAME(to_mont)(__VA_ARGS__)
+#define from_mont(...) SIGK_NAME(from_mont)(__VA_ARGS__)
+#define fpinv_mont(...) SIGK_NAME(fpinv_mont)(__VA_ARGS__)
+#define fpinv_mont_bingcd(...) SIGK_NAME(fpinv_mont_bingcd)(__VA_ARGS__)
+#define fpinv_chain_mont(...) SIGK_NAME(fpinv_chain_mont)(__VA_ARGS__)
+#define fp2copy(...) SIGK_NAME(fp2copy)(__VA_ARGS__)
+#define fp2zero(...) SIGK_NAME(fp2zero)(__VA_ARGS__)
+#define fp2neg(...) SIGK_NAME(fp2neg)(__VA_ARGS__)
+#define fp2add(...) SIGK_NAME(fp2add)(__VA_ARGS__)
+#define fp2sub(...) SIGK_NAME(fp2sub)(__VA_ARGS__)
+#define fp2div2(...) SIGK_NAME(fp2div2)(__VA_ARGS__)
+#define fp2correction(...) SIGK_NAME(fp2correction)(__VA_ARGS__)
+#define fp2sqr_mont(...) SIGK_NAME(fp2sqr_mont)(__VA_ARGS__)
+#define fp2mul_mont(...) SIGK_NAME(fp2mul_mont)(__VA_ARGS__)
+#define to_fp2mont(...) SIGK_NAME(to_fp2mont)(__VA_ARGS__)
+#define from_fp2mont(...) SIGK_NAME(from_fp2mont)(__VA_ARGS__)
+#define fp2inv_mont(...) SIGK_NAME(fp2inv_mont)(__VA_ARGS__)
+#define fp2inv_mont_bingcd(...) SIGK_NAME(fp2inv_mont_bingcd)(__VA_ARGS__)
+#define mont_n_way_inv(...) SIGK_NAME(mont_n_way_inv)(__VA_ARGS__)
+#define j_inv(...) SIGK_NAME(j_inv)(__VA_ARGS__)
+#define xDBLADD(...) SIGK_NAME(xDBLADD)(__VA_ARGS__)
+#define xDBL(...) SIGK_NAME(xDBL)(__VA_ARGS__)
+#define xDBLe(...) SIGK_NAME(xDBLe)(__VA_ARGS__)
+#define xADD(...) SIGK_NAME(xADD)(__VA_ARGS__)
+#define get_4_isog(...) SIGK_NAME(get_4_isog)(__VA_ARGS__)
+#define eval_4_isog(...) SIGK_NAME(eval_4_isog)(__VA_ARGS__)
+#define xTPL(...) SIGK_NAME(xTPL)(__VA_ARGS__)
+#define xTPLe(...) SIGK_NAME(xTPLe)(__VA_ARGS__)
+#define get_3_isog(...) SIGK_NAME(get_3_isog)(__VA_ARGS__)
+#define eval_3_isog(...) SIGK_NAME(eval_3_isog)(__VA_ARGS__)
+#define inv_3_way(...) SIGK_NAME(inv_3_way)(__VA_ARGS__)
+#define get_A(...) SIGK_NAME(get_A)(__VA_ARGS__)
+#define inv_6_way(...) SIGK_NAME(inv_6_way)(__VA_ARGS__)
+#define criss_cross(...) SIGK_NAME(criss_cross)(__VA_ARGS__)
+#define eval_5_isog(...) SIGK_NAME(eval_5_isog)(__VA_ARGS__)
+#define eval_4_isog_multi(...) SIGK_NAME(eval_4_isog_multi)(__VA_ARGS__)
+#define eval_3_isog_multi(...) SIGK_NAME(eval_3_isog_multi)(__VA_ARGS__)
+#define eval_5_isog_multi(...) SIGK_NAME(eval_5_isog_multi)(__VA_ARGS__)
+#define get_a_from_alpha(...) SIGK_NAME(get_a_from_alpha)(__VA_ARGS__)
+#define get_A_projective(...) SIGK_NAME(get_A_projective)(__VA_ARGS__)
+#define xDBLADD_AC24(...) SIGK_NAME(xDBLADD_AC24)(__VA_ARGS__)
+#define xQNTPL(...) SIGK_NAME(xQNTPL)(__VA_ARGS__)
+#define xQNTPLe(...) SIGK_NAME(xQNTPLe)(__VA_ARGS__)
+#define LADDER3PT(...) SIGK_NAME(LADDER3PT)(__VA_ARGS__)
+#define LADDER3PT_init(...) SIGK_NAME(LADDER3PT_init)(__VA_ARGS__)
+#define LADDER3PT_bits(...) SIGK_NAME(LADDER3PT_bits)(__VA_ARGS__)
+#define xDBLe_E0(...) SIGK_NAME(xDBLe_E0)(__VA_ARGS__)
+#define xTPLe_E0(...) SIGK_NAME(xTPLe_E0)(__VA_ARGS__)
+#define xQNTPLe_E0(...) SIGK_NAME(xQNTPLe_E0)(__VA_ARGS__)
+#define LADDER3PT_bits_E0(...) SIGK_NAME(LADDER3PT_bits_E0)(__VA_ARGS__)
+
+// Functions of api.h, suffixed for the sets other than SIGKp747
+
+#if defined(SIGK_API_SET)
+#define random_mod_order_A SIGK_API(random_mod_order_A)
+#define random_mod_order_B SIGK_API(random_mod_order_B)
+#define random_mod_order_C SIGK_API(random_mod_order_C)
+#define EphemeralKeyGeneration_A SIGK_API(EphemeralKeyGeneration_A)
+#define EphemeralKeyGeneration_B SIGK_API(EphemeralKeyGeneration_B)
+#define EphemeralKeyGeneration_C SIGK_API(EphemeralKeyGeneration_C)
+#define BSharedPublicFromA SIGK_API(BSharedPublicFromA)
+#define CSharedSecretFromB SIGK_API(CSharedSecretFromB)
+#define ASharedSecretFromC SIGK_API(ASharedSecretFromC)
+#define BSharedSecretFromA SIGK_API(BSharedSecretFromA)
+#define sigk_start_EphemeralKeyGeneration_A SIGK_API(sigk_start_EphemeralKeyGeneration_A)
+#define sigk_start_EphemeralKeyGeneration_B SIGK_API(sigk_start_EphemeralKeyGeneration_B)
+#define sigk_start_EphemeralKeyGeneration_C SIGK_API(sigk_start_EphemeralKeyGeneration_C)
+#define sigk_start_BSharedPublicFromA SIGK_API(sigk_start_BSharedPublicFromA)
+#define sigk_start_CSharedSecretFromB SIGK_API(sigk_start_CSharedSecretFromB)
+#define sigk_start_ASharedSecretFromC SIGK_API(sigk_start_ASharedSecretFromC)
+#define sigk_start_BSharedSecretFromA SIGK_API(sigk_start_BSharedSecretFromA)
+#define sigk_step SIGK_API(sigk_step)
+#define sigk_workspace_size SIGK_API(sigk_workspace_size)
+#define EphemeralKeyGeneration_A_ws SIGK_API(EphemeralKeyGeneration_A_ws)
+#define EphemeralKeyGeneration_B_ws SIGK_API(EphemeralKeyGeneration_B_ws)
+#define EphemeralKeyGeneration_C_ws SIGK_API(EphemeralKeyGeneration_C_ws)
+#define BSharedPublicFromA_ws SIGK_API(BSharedPublicFromA_ws)
+#define CSharedSecretFromB_ws SIGK_API(CSharedSecretFromB_ws)
+#define ASharedSecretFromC_ws SIGK_API(ASharedSecretFromC_ws)
+#define BSharedSecretFromA_ws SIGK_API(BSharedSecretFromA_ws)
+#define sigk_frame_bytes SIGK_API(sigk_frame_bytes)
+#define sigk_frame_init SIGK_API(sigk_frame_init)
+#define sigk_frame_parse SIGK_API(sigk_frame_parse)
+#define sigk_frame_iov SIGK_API(sigk_frame_iov)
+#define sigk_frame_parse_iov SIGK_API(sigk_frame_parse_iov)
+#endif
+
+/**************** Function prototypes ****************/
+/************* Multiprecision functions **************/
+
+// Copy wordsize digits, c = a, where lng(a) = nwords
+void copy_words(const digit_t *a, digit_t *c, const unsigned int nwords);
+
+// Multiprecision addition, c = a+b, where lng(a) = lng(b) = nwords. Returns the carry bit
+unsigned int mp_add(const digit_t *a, const digit_t *b, digit_t *c, const unsigned int nwords);
+
+// Multiprecision subtraction, c = a-b, where lng(a) = lng(b) = nwords. Returns the borrow bit
+unsigned int mp_sub(const digit_t *a, const digit_t *b, digit_t *c, const unsigned int nwords);
+
+// Multiprecision left shift
+void mp_shiftleft(digit_t *x, unsigned int shift, const unsigned int nwords);
+
+// Multiprecision right shift by one
+void mp_shiftr1(digit_t *x, const unsigned int nwords);
+
+// Multiprecision left right shift by one
+void mp_shiftl1(digit_t *x, const unsigned int nwords);
+
+// Digit multiplication, digit * digit -> 2-digit result
+void digit_x_digit(const digit_t a, const digit_t b, digit_t *c);
+void MUL64(const digit_t a, digit_t b, digit_t* c);
+
+// Multiprecision comba multiply, c = a*b, where lng(a) = lng(b) = nwords.
+void mp_mul(const digit_t *a, const digit_t *b, digit_t *c, const unsigned int nwords);
+
+void multiply(const digit_t *a, const digit_t *b, digit_t *c, const unsigned int nwords);
+
+// Montgomery multiplication modulo the group order, mc = ma*mb*r' mod order, where ma,mb,mc in [0, order-1]
+void Montgomery_multiply_mod_order(const digit_t *ma, const digit_t *mb, digit_t *mc, const digit_t *order, const digit_t *Montgomery_rprime);
+
+// (Non-constant time) Montgomery inversion modulo the curve order using a^(-1) = a^(order-2) mod order
+//void Montgomery_inversion_mod_order(const digit_t* ma, digit_t* mc, const digit_t* order, const digit_t* Montgomery_rprime);
+
+void Montgomery_inversion_mod_order_bingcd(const digit_t *a, digit_t *c, const digit_t *order, const digit_t *Montgomery_rprime, const digit_t *Montgomery_R2);
+
+// Conversion of elements in Z_r to Montgomery representation, where the order r is up to 384 bits.
+void to_Montgomery_mod_order(const digit_t *a, digit_t *mc, const digit_t *order, const digit_t *Montgomery_rprime, const digit_t *Montgomery_Rprime);
+
+// Conversion of elements in Z_r from Montgomery to standard representation, where the order is up to 384 bits.
+void from_Montgomery_mod_order(const digit_t *ma, digit_t *c, const digit_t *order, const digit_t *Montgomery_rprime);
+
+// Inversion modulo Alice's order 2^372.
+void inv_mod_orderA(const digit_t *a, digit_t *c);
+
+/************ Field arithmetic functions *************/
+
+// Copy of a field element, c = a
+void fpcopy(const felm_t a, felm_t c);
+
+// Zeroing a field element, a = 0
+void fpzero(felm_t a);
+
+// Non constant-time comparison of two field elements. If a = b return TRUE, otherwise, return FALSE
+bool fpequal_non_constant_time(const felm_t a, const felm_t b);
+
+// Modular addition, c = a+b mod p
+extern void fpadd(const digit_t *a, const digit_t *b, digit_t *c);
+
+// Modular subtraction, c = a-b mod p
+extern void fpsub(const digit_t *a, const digit_t *b, digit_t *c);
+
+// Modular negation, a = -a mod p
+extern void fpneg(digit_t *a);
+
+// Modular division by two, c = a/2 mod p.
+void fpdiv2(const digit_t *a, digit_t *c);
+
+// Modular correction to reduce field element a in [0, 2*p-1] to [0, p-1].
+void fpcorrection(digit_t *a);
+
+// Montgomery reduction, c = a mod p
+void rdc_mont(const digit_t *a, digit_t *c);
+
+// Field multiplication using Montgomery arithmetic, c = a*b*R^-1 mod p, where R=2^(RADIX*NWORDS_FIELD)
+void fpmul_mont(const felm_t a, const felm_t b, felm_t c);
+
+// Field squaring using Montgomery arithmetic, c = a*b*R^-1 mod p, where R=2^(RADIX*NWORDS_FIELD)
+void fpsqr_mont(const felm_t ma, felm_t mc);
+
+// Conversion to Montgomery representation
+void to_mont(const felm_t a, felm_t mc);
+
+// Conversion from Montgomery representation to standard representation
+void from_mont(const felm_t ma, felm_t c);
+
+// Field inversion, a = a^-1 in GF(p)
+void fpinv_mont(felm_t a);
+
+// Field inversion, a = a^-1 in GF(p) using the binary GCD
+void fpinv_mont_bingcd(felm_t a);
+
+// Chain to compute a^(p-2) using Montgomery arithmetic
+void fpinv_chain_mont(felm_t a);
+
+/************ GF(p^2) arithmetic functions *************/
+
+// Copy of a GF(p^2) element, c = a
+void fp2copy(const f2elm_t a, f2elm_t c);
+
+// Zeroing a GF(p^2) element, a = 0
+void fp2zero(f2elm_t a);
+
+// GF(p^2) negation, a = -a in GF(p^2)
+void fp2neg(f2elm_t a);
+
+// GF(p^2) addition, c = a+b in GF(p^2)
+extern void fp2add(const f2elm_t a, const f2elm_t b, f2elm_t c);
+
+// GF(p^2) subtraction, c = a-b in GF(p^2)
+extern void fp2sub(const f2elm_t a, const f2elm_t b, f2elm_t c);
+
+// GF(p^2) division by two, c = a/2  in GF(p^2)
+void fp2div2(const f2elm_t a, f2elm_t c);
+
+// Modular correction, a = a in GF(p^2)
+void fp2correction(f2elm_t a);
+
+// GF(p^2) squaring using Montgomery arithmetic, c = a^2 in GF(p^2)
+void fp2sqr_mont(const f2elm_t a, f2elm_t c);
+
+// GF(p^2) multiplication using Montgomery arithmetic, c = a*b in GF(p^2)
+void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c);
+
+// Conversion of a GF(p^2) element to Montgomery representation
+void to_fp2mont(const f2elm_t a, f2elm_t mc);
+
+// Conversion of a GF(p^2) element from Montgomery representation to standard representation
+void from_fp2mont(const f2elm_t ma, f2elm_t c);
+
+// GF(p^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2)
+void fp2inv_mont(f2elm_t a);
+
+// GF(p^2) inversion, a = (a0-i*a1)/(a0^2+a1^2), GF(p) inversion done using the binary GCD
+void fp2inv_mont_bingcd(f2elm_t a);
+
+// n-way Montgomery inversion
+void mont_n_way_inv(const f2elm_t *vec, const int n, f2elm_t *out);
+
+/************ Elliptic curve and isogeny functions *************/
+
+// Computes the j-invariant of a Montgomery curve with projective constant.
+void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv);
+
+// Simultaneous doubling and differential addition.
+void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t xPQ, const f2elm_t A24);
+
+// Doubling of a Montgomery point in projective coordinates (X:Z).
+void xDBL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24);
+
+// Computes [2^e](X:Z) on Montgomery curve with projective constant via e repeated doublings.
+void xDBLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24, const int e);
+
+// Differential addition.
+void xADD(point_proj_t P, const point_proj_t Q, const f2elm_t xPQ);
+
+// Computes the corresponding 4-isogeny of a projective Montgomery point (X4:Z4) of order 4.
+void get_4_isog(const point_proj_t P, f2elm_t A24plus, f2elm_t C24, f2elm_t *coeff);
+
+// Evaluates the isogeny at the point (X:Z) in the domain of the isogeny.
+void eval_4_isog(point_proj_t P, f2elm_t *coeff);
+
+// Tripling of a Montgomery point in projective coordinates (X:Z).
+void xTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2elm_t A24plus);
+
+// Computes [3^e](X:Z) on Montgomery curve with projective constant via e repeated triplings.
+void xTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2elm_t A24plus, const int e);
+
+// Computes the corresponding 3-isogeny of a projective Montgomery point (X3:Z3) of order 3.
+void get_3_isog(const point_proj_t P, f2elm_t A24minus, f2elm_t A24plus, f2elm_t *coeff);
+
+// Computes the 3-isogeny R=phi(X:Z), given projective point (X3:Z3) of order 3 on a Montgomery curve and a point P with coefficients given in coeff.
+void eval_3_isog(point_proj_t Q, const f2elm_t *coeff);
+
+// 3-way simultaneous inversion
+void inv_3_way(f2elm_t z1, f2elm_t z2, f2elm_t z3);
+
+// Given the x-coordinates of P, Q, and R, returns the value A corresponding to the Montgomery curve E_A: y^2=x^3+A*x^2+x such that R=Q-P on E_A.
+void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A);
+
+// 6-way simultaneous inversion
+void inv_6_way(f2elm_t z1, f2elm_t z2, f2elm_t z3, f2elm_t z4, f2elm_t z5, f2elm_t z6);
+
+// Criss cross operation for computing 5-isogenies
+void criss_cross(f2elm_t alpha, f2elm_t beta, f2elm_t gamma, f2elm_t delta);
+
+// Computes the 5-isogeny R=phi(X:Z), given two projective points P=(X3:Z3) and Pdbl=(X'3:Z'3) of order 3 on a Montgomery curve where Pdbl = [2]P
+void eval_5_isog(const point_proj_t P, const point_proj_t Pdbl, point_proj_t R);
+
+// Evaluates a 4-isogeny at the first n points of an array of point blocks
+void eval_4_isog_multi(point_block *pts, const unsigned int n, const f2elm_t *coeff);
+
+// Evaluates a 3-isogeny at the first n points of an array of point blocks
+void eval_3_isog_multi(point_block *pts, const unsigned int n, const f2elm_t *coeff);
+
+// Evaluates the 5-isogeny with kernel generated by P, where Pdbl = [2]P, at the first n points of an array of point blocks
+void eval_5_isog_multi(const point_proj_t P, const point_proj_t Pdbl, point_block *pts, const unsigned int n);
+
+// Compute Montgomery curve projective coefficient from a projective point alpha of order 2 on the curve
+void get_a_from_alpha(const point_proj_t alpha, f2elm_t A24plus, f2elm_t C24);
+
+// Given the P, Q, and R, returns the value A24plus and C24 corresponding to the Montgomery curve E_A: Cy^2=Cx^3+A*x^2+Cx such that R=Q-P on E_A.
+void get_A_projective(const point_proj_t P, const point_proj_t Q, const point_proj_t R, f2elm_t A24plus, f2elm_t C24);
+
+// Simultaneous doubling and differential addition using projective curve coefficients.
+void xDBLADD_AC24(point_proj_t P, point_proj_t Q, const point_proj_t xPQ, const f2elm_t A24plus, const f2elm_t C24);
+
+// Quintupling of a Montgomery point in projective coordinates (X:Z).
+void xQNTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24);
+
+// Computes [5^e](X:Z) on Montgomery curve with projective constant via e repeated quintuplings.
+void xQNTPLe(const point_proj_t P, point_proj_t Q, const f2elm_t A24plus, const f2elm_t C24, const int e);
+
+// Three-point Montgomery ladder computing the kernel point R = P + [m]Q.
+void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t *m, const unsigned int AliceOrBobOrEve, point_proj_t R, const f2elm_t A);
+
+// Initialization of the 3-point ladder state, used to run the ladder in several calls.
+void LADDER3PT_init(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const f2elm_t A, point_proj_t R0, point_proj_t R2, point_proj_t R, f2elm_t A24);
+
+// Processes the bits first, ..., last-1 of the scalar m on a ladder state set up by LADDER3PT_init().
+void LADDER3PT_bits(const digit_t *m, const unsigned int first, const unsigned int last, point_proj_t R0, point_proj_t R2, point_proj_t R, const f2elm_t A24);
+
+// Versions of xDBLe, xTPLe, xQNTPLe and LADDER3PT_bits on the base curve E0 (A = 0, C = 1), which need no curve constants.
+void xDBLe_E0(const point_proj_t P, point_proj_t Q, const int e);
+void xTPLe_E0(const point_proj_t P, point_proj_t Q, const int e);
+void xQNTPLe_E0(const point_proj_t P, point_proj_t Q, const int e);
+void LADDER3PT_bits_E0(const digit_t *m, const unsigned int first, const unsigned int last, point_proj_t R0, point_proj_t R2, point_proj_t R);
+
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Library
+*
+* Abstract: static tracepoints compatible with SystemTap/USDT
+* Each probe is a single nop instruction. Its address, name and argument locations are recorded
+* in the .note.stapsdt section in the format of <sys/sdt.h>, so that tools such as bpftrace, perf
+* or SystemTap can attach to it in a running binary. Probes compile to nothing on targets that are
+* not 64-bit ELF or when SIGK_NO_PROBES is defined.
+*********************************************************************************************/
+#ifndef __SIGK_SDT_H__
+#define __SIGK_SDT_H__
+
+#include <stdint.h>
+
+#if defined(__ELF__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__)) && !defined(SIGK_NO_PROBES)
+
+// Note describing one probe, "args" gives the size and location of each argument (e.g., "8@%0 8@%1")
+#define SIGK_SDT_NOTE(provider, name, args)                                           \
+    "990:\tnop\n"                                                                     \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                     \
+    ".balign 4\n"                                                                     \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                                \
+    "991:\t.asciz \"stapsdt\"\n"                                                      \
+    "992:\t.balign 4\n"                                                               \
+    "993:\t.8byte 990b\n"                                                             \
+    ".8byte _.stapsdt.base\n"                                                         \
+    ".8byte 0\n"                                                                      \
+    ".asciz \"" #provider "\"\n"                                                      \
+    ".asciz \"" #name "\"\n"                                                          \
+    ".asciz \"" args "\"\n"                                                           \
+    "994:\t.balign 4\n"                                                               \
+    ".popsection\n"                                                                   \
+    ".ifndef _.stapsdt.base\n"                                                        \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"           \
+    ".weak _.stapsdt.base\n"                                                          \
+    ".hidden _.stapsdt.base\n"                                                        \
+    "_.stapsdt.base: .space 1\n"                                                      \
+    ".size _.stapsdt.base, 1\n"                                                       \
+    ".popsection\n"                                                                   \
+    ".endif\n"
+
+// Probes with zero to three arguments, passed as 64-bit unsigned integers
+#define SIGK_PROBE0(provider, name) \
+    __asm__ __volatile__(SIGK_SDT_NOTE(provider, name, ""))
+#define SIGK_PROBE1(provider, name, a1) \
+    __asm__ __volatile__(SIGK_SDT_NOTE(provider, name, "8@%0") :: "nor"((uint64_t)(a1)))
+#define SIGK_PROBE2(provider, name, a1, a2) \
+    __asm__ __volatile__(SIGK_SDT_NOTE(provider, name, "8@%0 8@%1") :: "nor"((uint64_t)(a1)), "nor"((uint64_t)(a2)))
+#define SIGK_PROBE3(provider, name, a1, a2, a3) \
+    __asm__ __volatile__(SIGK_SDT_NOTE(provider, name, "8@%0 8@%1 8@%2") :: "nor"((uint64_t)(a1)), "nor"((uint64_t)(a2)), "nor"((uint64_t)(a3)))
+
+#else
+
+#define SIGK_PROBE0(provider, name)
+#define SIGK_PROBE1(provider, name, a1)
+#define SIGK_PROBE2(provider, name, a1, a2)
+#define SIGK_PROBE3(provider, name, a1, a2, a3)
+
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: client interface of the sigkd key agreement daemon
+* sigkd runs the group key operations of all the parameter sets for the processes of a host. A client connects
+* to its Unix socket and passes a shared memory buffer to the daemon. Requests then name the operation and the
+* offsets of its arguments in that buffer, so keys are read and written in place and never cross the socket.
+* The daemon collects the requests of all clients ready at the same time and hands them to its worker pool as
+* one batch. A client can keep several requests in flight; the results come back as they complete.
+*********************************************************************************************/
+
+#ifndef __SIGKD_H__
+#define __SIGKD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIGKD_SOCKET_PATH       "/tmp/sigkd.sock"  // Default socket of the daemon
+#define SIGKD_MAGIC             0x6B676973          // "sigk"
+#define SIGKD_VERSION           1
+#define SIGKD_MAX_INFLIGHT      64                  // Requests of a client queued in the daemon, more are read once earlier ones complete
+#define SIGKD_MAX_BUFFER_BYTES  (1 << 24)           // Largest shared buffer accepted by the daemon
+
+// Operations of a request: the SIGK_OP_* identifiers of api.h and the generation of private keys.
+// Arguments used by each operation, in the order of the corresponding function of api.h:
+//   SIGK_OP_*        sk, in0, in1, out0, out1 as far as the function takes them
+//   SIGKD_OP_RANDOM_* out0 receives the private key
+#define SIGKD_OP_RANDOM_A       (SIGK_NUM_OPS + 0)
+#define SIGKD_OP_RANDOM_B       (SIGK_NUM_OPS + 1)
+#define SIGKD_OP_RANDOM_C       (SIGK_NUM_OPS + 2)
+#define SIGKD_NUM_OPS           (SIGK_NUM_OPS + 3)
+
+// Status of a completed request
+#define SIGKD_OK                0                   // The operation returned 0
+#define SIGKD_FAILED            1                   // The operation returned an error
+#define SIGKD_INVALID           -1                  // Unknown operation or set, or arguments outside the shared buffer
+
+// Request sent by a client. "set" is an index of sigk_params_at(), the offsets are relative to the shared buffer.
+// Unused offsets are ignored. "id" is chosen by the client and returned with the result.
+typedef struct {
+    uint32_t id;
+    uint32_t op;
+    uint32_t set;
+    uint32_t sk, in0, in1, out0, out1;
+} sigkd_request_t;
+
+typedef struct {
+    uint32_t id;
+    int32_t status;
+} sigkd_response_t;
+
+typedef struct sigkd_client sigkd_client_t;
+
+// Connect to the daemon listening on "path" (SIGKD_SOCKET_PATH if NULL) with a shared buffer of "buffer_bytes".
+// Returns NULL if the daemon cannot be reached or refuses the buffer.
+sigkd_client_t* sigkd_connect(const char* path, size_t buffer_bytes);
+
+// Close the connection and unmap the shared buffer. Requests still in flight are completed by the daemon and discarded.
+void sigkd_close(sigkd_client_t* client);
+
+// Shared buffer of the client, where the arguments of the requests are placed
+unsigned char* sigkd_buffer(sigkd_client_t* client);
+size_t sigkd_buffer_size(const sigkd_client_t* client);
+
+// Send a request without waiting for its result. Returns 0 on success.
+int sigkd_submit(sigkd_client_t* client, const sigkd_request_t* request);
+
+// Wait for the next result, in completion order. Returns 0 on success and 1 if the connection is lost.
+int sigkd_wait(sigkd_client_t* client, sigkd_response_t* response);
+
+// Submit a request and wait for its result, with no other request in flight. Returns the status of the request,
+// or SIGKD_INVALID if the connection is lost.
+int sigkd_call(sigkd_client_t* client, const sigkd_request_t* request);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
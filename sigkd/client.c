@@ -0,0 +1,179 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: client library of the sigkd key agreement daemon, see sigkd.h
+* The shared buffer is an anonymous memory file whose descriptor is passed to the daemon with the hello message.
+* It is sealed against shrinking, so that the daemon never touches pages a client has removed.
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../sigkd.h"
+
+struct sigkd_client {
+    int fd;
+    unsigned char *buffer;
+    size_t size;
+};
+
+// First message of a connection, sent with the descriptor of the shared buffer
+typedef struct {
+    uint32_t magic, version;
+} sigkd_hello_t;
+
+static int send_all(const int fd, const void *buf, size_t len)
+{ // Write a whole message, returns 0 on success
+    const unsigned char *p = (const unsigned char *)buf;
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int recv_all(const int fd, void *buf, size_t len)
+{ // Read a whole message, returns 0 on success and 1 on error or if the daemon closed the connection
+    unsigned char *p = (unsigned char *)buf;
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int send_hello(const int fd, const int memfd)
+{ // Hello message carrying the descriptor of the shared buffer
+    sigkd_hello_t hello = {SIGKD_MAGIC, SIGKD_VERSION};
+    union {
+        struct cmsghdr align;
+        char bytes[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct iovec iov = {&hello, sizeof(hello)};
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+    ssize_t n;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(&control, 0, sizeof(control));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.bytes;
+    msg.msg_controllen = sizeof(control.bytes);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+
+    do
+    {
+        n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    return (n == (ssize_t)sizeof(hello)) ? 0 : 1;
+}
+
+sigkd_client_t *sigkd_connect(const char *path, size_t buffer_bytes)
+{ // Connect to the daemon and share a buffer of buffer_bytes with it
+    struct sockaddr_un addr;
+    sigkd_client_t *c;
+    sigkd_response_t ack;
+    int memfd;
+
+    if (path == NULL)
+        path = SIGKD_SOCKET_PATH;
+    if (buffer_bytes == 0 || buffer_bytes > SIGKD_MAX_BUFFER_BYTES || strlen(path) >= sizeof(addr.sun_path))
+        return NULL;
+    c = calloc(1, sizeof(sigkd_client_t));
+    if (c == NULL)
+        return NULL;
+    c->size = buffer_bytes;
+    c->buffer = MAP_FAILED;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    c->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    memfd = memfd_create("sigkd", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (c->fd < 0 || memfd < 0 || ftruncate(memfd, (off_t)buffer_bytes) != 0)
+        goto fail;
+    if (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) // The daemon only maps buffers that cannot shrink under it
+        goto fail;
+    c->buffer = mmap(NULL, buffer_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (c->buffer == MAP_FAILED || connect(c->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+        goto fail;
+    if (send_hello(c->fd, memfd) != 0 || recv_all(c->fd, &ack, sizeof(ack)) != 0 || ack.status != SIGKD_OK)
+        goto fail;
+    close(memfd);
+    return c;
+
+fail:
+    if (memfd >= 0)
+        close(memfd);
+    if (c->buffer != MAP_FAILED)
+        munmap(c->buffer, buffer_bytes);
+    if (c->fd >= 0)
+        close(c->fd);
+    free(c);
+    return NULL;
+}
+
+void sigkd_close(sigkd_client_t *client)
+{
+    if (client == NULL)
+        return;
+    close(client->fd);
+    munmap(client->buffer, client->size);
+    free(client);
+}
+
+unsigned char *sigkd_buffer(sigkd_client_t *client)
+{
+    return client->buffer;
+}
+
+size_t sigkd_buffer_size(const sigkd_client_t *client)
+{
+    return client->size;
+}
+
+int sigkd_submit(sigkd_client_t *client, const sigkd_request_t *request)
+{
+    return send_all(client->fd, request, sizeof(sigkd_request_t));
+}
+
+int sigkd_wait(sigkd_client_t *client, sigkd_response_t *response)
+{
+    return recv_all(client->fd, response, sizeof(sigkd_response_t));
+}
+
+int sigkd_call(sigkd_client_t *client, const sigkd_request_t *request)
+{ // Synchronous request, the next result is the one of this request
+    sigkd_response_t response;
+
+    if (sigkd_submit(client, request) != 0 || sigkd_wait(client, &response) != 0 || response.id != request->id)
+        return SIGKD_INVALID;
+    return response.status;
+}
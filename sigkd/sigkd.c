@@ -0,0 +1,640 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: sigkd, key agreement daemon serving the processes of a host over a Unix socket, see sigkd.h
+* The main thread polls the clients. In each round it reads the requests of every ready client and
+* hands them to the worker pool as one batch, under a single lock and wakeup. Each worker owns an aligned
+* workspace large enough for every operation of every parameter set, runs the _ws functions of the registry
+* on the shared buffers of the clients and sends the results back directly.
+* The sockets of the clients are non-blocking. Results that a client does not read are kept in its output queue
+* and flushed by the main thread when the socket becomes writable. Queued results count against the in-flight
+* budget of the client, so a client that stops reading is no longer read either, and one whose queue overflows
+* is disconnected. Neither the main thread nor the workers ever wait on a client.
+*
+* Usage: sigkd [-s socket] [-w workers] [-v]
+*   -s  path of the socket (default /tmp/sigkd.sock)
+*   -w  number of worker threads (default: online processors)
+*   -v  print the number of requests and batches on exit
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "../sigkd.h"
+
+#define ARG_SK 0
+#define ARG_IN0 1
+#define ARG_IN1 2
+#define ARG_OUT0 3
+#define ARG_OUT1 4
+#define NUM_ARGS 5
+
+typedef struct {
+    uint32_t magic, version;
+} sigkd_hello_t;
+
+typedef struct client {
+    int fd;
+    unsigned char *buffer; // Shared buffer, NULL until the hello message
+    size_t size;
+    unsigned char partial[sizeof(sigkd_request_t)];
+    size_t partial_len;
+    unsigned int inflight; // Requests queued or running, protected by pool.lock
+    unsigned int refs;     // Main thread and requests in flight, protected by pool.lock
+    pthread_mutex_t out_lock;
+    sigkd_response_t out[SIGKD_MAX_INFLIGHT]; // Results not sent yet, protected by out_lock
+    unsigned int out_head, out_count;
+    size_t out_sent;       // Bytes of out[out_head] already sent
+    int failed;            // The output queue overflowed or the connection broke, protected by out_lock
+    struct client *next;
+} client_t;
+
+typedef struct job {
+    client_t *client;
+    sigkd_request_t req;
+    struct job *next;
+} job_t;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    job_t *head, *tail;
+    int stop;
+    unsigned long requests, batches, largest;
+} pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0, 0, 0, 0};
+
+static int wake_pipe[2] = {-1, -1}; // Wakes the main thread on a signal, on queued output or when a throttled client can be read again
+static volatile sig_atomic_t stopping = 0;
+static size_t workspace_bytes = 0;
+
+static void wake_main(void)
+{ // A full pipe means that the main thread is already woken
+    ssize_t n = write(wake_pipe[1], "w", 1);
+    (void)n;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stopping = 1;
+    wake_main();
+}
+
+static void request_sizes(const sigk_params_t *p, const unsigned int op, size_t len[NUM_ARGS])
+{ // Bytes read or written at each argument of an operation, 0 for the arguments it does not use
+    memset(len, 0, NUM_ARGS * sizeof(size_t));
+    switch (op)
+    {
+    case SIGK_OP_KEYGEN_A:
+    case SIGK_OP_KEYGEN_B:
+    case SIGK_OP_KEYGEN_C:
+        len[ARG_SK] = p->secretkey_bytes;
+        len[ARG_OUT0] = p->publickey_bytes;
+        break;
+    case SIGK_OP_B_SHARED_PUBLIC_FROM_A:
+        len[ARG_SK] = p->secretkey_bytes;
+        len[ARG_IN0] = p->publickey_bytes;
+        len[ARG_OUT0] = p->sharedpublic_bytes;
+        break;
+    case SIGK_OP_C_SHARED_SECRET_FROM_B:
+    case SIGK_OP_A_SHARED_SECRET_FROM_C:
+        len[ARG_SK] = p->secretkey_bytes;
+        len[ARG_IN0] = p->publickey_bytes;
+        len[ARG_IN1] = p->sharedpublic_bytes;
+        len[ARG_OUT0] = p->sharedpublic_bytes;
+        len[ARG_OUT1] = p->bytes;
+        break;
+    case SIGK_OP_B_SHARED_SECRET_FROM_A:
+        len[ARG_SK] = p->secretkey_bytes;
+        len[ARG_IN0] = p->sharedpublic_bytes;
+        len[ARG_OUT0] = p->bytes;
+        break;
+    default: // SIGKD_OP_RANDOM_*
+        len[ARG_OUT0] = p->secretkey_bytes;
+        break;
+    }
+}
+
+static int request_valid(const client_t *c, const sigkd_request_t *req)
+{ // The operation and the set exist, and all the arguments of the operation lie in the shared buffer
+    const uint32_t off[NUM_ARGS] = {req->sk, req->in0, req->in1, req->out0, req->out1};
+    const sigk_params_t *p = sigk_params_at(req->set);
+    size_t len[NUM_ARGS];
+    unsigned int i;
+
+    if (p == NULL || req->op >= SIGKD_NUM_OPS)
+        return 0;
+    request_sizes(p, req->op, len);
+    for (i = 0; i < NUM_ARGS; i++)
+    {
+        if (len[i] != 0 && (off[i] > c->size || len[i] > c->size - off[i]))
+            return 0;
+    }
+    return 1;
+}
+
+static int run_request(const sigkd_request_t *req, unsigned char *b, void *ws)
+{ // Run a validated request on the shared buffer b
+    const sigk_params_t *p = sigk_params_at(req->set);
+    unsigned char *sk = b + req->sk, *in0 = b + req->in0, *in1 = b + req->in1, *out0 = b + req->out0, *out1 = b + req->out1;
+
+    switch (req->op)
+    {
+    case SIGK_OP_KEYGEN_A: return p->keygen_A_ws(sk, out0, ws);
+    case SIGK_OP_KEYGEN_B: return p->keygen_B_ws(sk, out0, ws);
+    case SIGK_OP_KEYGEN_C: return p->keygen_C_ws(sk, out0, ws);
+    case SIGK_OP_B_SHARED_PUBLIC_FROM_A: return p->B_shared_public_from_A_ws(sk, in0, out0, ws);
+    case SIGK_OP_C_SHARED_SECRET_FROM_B: return p->C_shared_secret_from_B_ws(sk, in0, in1, out0, out1, ws);
+    case SIGK_OP_A_SHARED_SECRET_FROM_C: return p->A_shared_secret_from_C_ws(sk, in0, in1, out0, out1, ws);
+    case SIGK_OP_B_SHARED_SECRET_FROM_A: return p->B_shared_secret_from_A_ws(sk, in0, out0, ws);
+    case SIGKD_OP_RANDOM_A: p->random_A(out0); return 0;
+    case SIGKD_OP_RANDOM_B: p->random_B(out0); return 0;
+    default: p->random_C(out0); return 0;
+    }
+}
+
+static void flush_output(client_t *c)
+{ // Send the queued results as far as the socket takes them, with out_lock held
+    const unsigned char *p;
+    ssize_t n;
+
+    while (c->out_count != 0 && !c->failed)
+    {
+        p = (const unsigned char *)&c->out[c->out_head];
+        n = send(c->fd, p + c->out_sent, sizeof(sigkd_response_t) - c->out_sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (n <= 0)
+        {
+            c->failed = 1;
+            break;
+        }
+        c->out_sent += (size_t)n;
+        if (c->out_sent == sizeof(sigkd_response_t))
+        {
+            c->out_head = (c->out_head + 1) % SIGKD_MAX_INFLIGHT;
+            c->out_count--;
+            c->out_sent = 0;
+        }
+    }
+}
+
+static int respond(client_t *c, const uint32_t id, const int32_t status)
+{ // Queue a result and send what the socket takes. Returns 1 if the main thread has to poll for output or drop the client.
+    int pending;
+
+    pthread_mutex_lock(&c->out_lock);
+    if (c->out_count == SIGKD_MAX_INFLIGHT)
+    { // Cannot happen while queued results count against the in-flight budget, but never wait for the client
+        c->failed = 1;
+    }
+    else if (!c->failed)
+    {
+        c->out[(c->out_head + c->out_count) % SIGKD_MAX_INFLIGHT].id = id;
+        c->out[(c->out_head + c->out_count) % SIGKD_MAX_INFLIGHT].status = status;
+        c->out_count++;
+        flush_output(c);
+    }
+    pending = (c->out_count != 0 || c->failed);
+    pthread_mutex_unlock(&c->out_lock);
+    return pending;
+}
+
+static unsigned int client_budget(client_t *c)
+{ // Requests in flight plus results not sent yet
+    unsigned int used;
+
+    pthread_mutex_lock(&pool.lock);
+    used = c->inflight;
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_lock(&c->out_lock);
+    used += c->out_count;
+    pthread_mutex_unlock(&c->out_lock);
+    return used;
+}
+
+static void client_release(client_t *c)
+{ // Drop a reference, the last one unmaps the buffer and closes the connection
+    unsigned int refs;
+
+    pthread_mutex_lock(&pool.lock);
+    refs = --c->refs;
+    pthread_mutex_unlock(&pool.lock);
+    if (refs != 0)
+        return;
+    if (c->buffer != NULL)
+        munmap(c->buffer, c->size);
+    close(c->fd);
+    pthread_mutex_destroy(&c->out_lock);
+    free(c);
+}
+
+static void *worker(void *arg)
+{ // Run the queued requests until the pool is stopped and drained
+    void *ws = aligned_alloc(SIGK_WORKSPACE_ALIGN, workspace_bytes);
+    job_t *job;
+    client_t *c;
+    int status, wake;
+
+    (void)arg;
+    if (ws == NULL)
+    {
+        perror("sigkd: workspace");
+        exit(EXIT_FAILURE);
+    }
+    for (;;)
+    {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.head == NULL && !pool.stop)
+            pthread_cond_wait(&pool.cond, &pool.lock);
+        job = pool.head;
+        if (job == NULL)
+        {
+            pthread_mutex_unlock(&pool.lock);
+            break;
+        }
+        pool.head = job->next;
+        if (pool.head == NULL)
+            pool.tail = NULL;
+        pthread_mutex_unlock(&pool.lock);
+
+        c = job->client;
+        status = (run_request(&job->req, c->buffer, ws) == 0) ? SIGKD_OK : SIGKD_FAILED;
+        wake = respond(c, job->req.id, status);
+
+        pthread_mutex_lock(&pool.lock);
+        wake |= (c->inflight-- == SIGKD_MAX_INFLIGHT);
+        pthread_mutex_unlock(&pool.lock);
+        if (wake)
+            wake_main();
+        client_release(c);
+        free(job);
+    }
+    free(ws);
+    return NULL;
+}
+
+static int recv_hello(client_t *c)
+{ // Hello message with the descriptor of the shared buffer, which must be sealed against shrinking. Returns 0 on success.
+    sigkd_hello_t hello;
+    union {
+        struct cmsghdr align;
+        char bytes[CMSG_SPACE(sizeof(int))];
+    } control;
+    struct iovec iov = {&hello, sizeof(hello)};
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+    struct stat st;
+    int memfd = -1, seals;
+    ssize_t n;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.bytes;
+    msg.msg_controllen = sizeof(control.bytes);
+    n = recvmsg(c->fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    if (n > 0 && cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(int)))
+        memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+    if (n != (ssize_t)sizeof(hello) || hello.magic != SIGKD_MAGIC || hello.version != SIGKD_VERSION || memfd < 0)
+        goto fail;
+    seals = fcntl(memfd, F_GET_SEALS);
+    if (seals < 0 || !(seals & F_SEAL_SHRINK) || fstat(memfd, &st) != 0 || st.st_size <= 0 || st.st_size > SIGKD_MAX_BUFFER_BYTES)
+        goto fail;
+    c->buffer = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (c->buffer == MAP_FAILED)
+    {
+        c->buffer = NULL;
+        goto fail;
+    }
+    c->size = (size_t)st.st_size;
+    close(memfd);
+    respond(c, 0, SIGKD_OK);
+    return 0;
+
+fail:
+    if (memfd >= 0)
+        close(memfd);
+    respond(c, 0, SIGKD_INVALID);
+    return 1;
+}
+
+static int read_requests(client_t *c, job_t **batch_head, job_t **batch_tail, unsigned long *count)
+{ // Read the requests available on a connection into the batch. Returns 1 if the client is gone.
+    unsigned char buf[SIGKD_MAX_INFLIGHT * sizeof(sigkd_request_t)];
+    sigkd_request_t req;
+    unsigned int room;
+    size_t used = 0, len;
+    ssize_t n;
+    job_t *job;
+
+    room = client_budget(c);
+    room = (room < SIGKD_MAX_INFLIGHT) ? SIGKD_MAX_INFLIGHT - room : 0;
+    if (room == 0)
+        return 0;
+    len = room * sizeof(sigkd_request_t) - c->partial_len;
+    memcpy(buf, c->partial, c->partial_len);
+    do
+    {
+        n = recv(c->fd, buf + c->partial_len, len, MSG_DONTWAIT);
+    } while (n < 0 && errno == EINTR);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+        return 1;
+    if (n < 0)
+        return 0;
+    len = c->partial_len + (size_t)n;
+
+    for (; len - used >= sizeof(sigkd_request_t); used += sizeof(sigkd_request_t))
+    {
+        memcpy(&req, buf + used, sizeof(req));
+        if (!request_valid(c, &req))
+        {
+            respond(c, req.id, SIGKD_INVALID);
+            continue;
+        }
+        job = malloc(sizeof(job_t));
+        if (job == NULL)
+        {
+            respond(c, req.id, SIGKD_FAILED);
+            continue;
+        }
+        job->client = c;
+        job->req = req;
+        job->next = NULL;
+        if (*batch_tail != NULL)
+            (*batch_tail)->next = job;
+        else
+            *batch_head = job;
+        *batch_tail = job;
+        (*count)++;
+        pthread_mutex_lock(&pool.lock);
+        c->inflight++;
+        c->refs++;
+        pthread_mutex_unlock(&pool.lock);
+    }
+    c->partial_len = len - used;
+    memcpy(c->partial, buf + used, c->partial_len);
+    return 0;
+}
+
+static int open_socket(const char *path)
+{ // Listening socket at path. A stale socket file is replaced, a running daemon is not.
+    struct sockaddr_un addr;
+    int fd;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "sigkd: socket path too long\n");
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+    {
+        fprintf(stderr, "sigkd: a daemon is already listening on %s\n", path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    unlink(path);
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0)
+    {
+        perror("sigkd: socket");
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-s socket] [-w workers] [-v]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = SIGKD_SOCKET_PATH;
+    unsigned int workers = (unsigned int)sysconf(_SC_NPROCESSORS_ONLN), nclients = 0, nfds, i, op;
+    int opt, verbose = 0, listen_fd;
+    client_t *clients = NULL, *c, **link;
+    struct pollfd *fds = NULL;
+    pthread_t *threads;
+    struct sigaction sa;
+    char drain[64];
+
+    while ((opt = getopt(argc, argv, "s:w:vh")) != -1)
+    {
+        switch (opt)
+        {
+        case 's': path = optarg; break;
+        case 'w': workers = (unsigned int)atoi(optarg); break;
+        case 'v': verbose = 1; break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (workers == 0)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; sigk_params_at(i) != NULL; i++)
+    { // One workspace per worker fits every operation of every set
+        for (op = 0; op < SIGK_NUM_OPS; op++)
+        {
+            size_t bytes = sigk_params_at(i)->workspace_size(op);
+            workspace_bytes = (bytes > workspace_bytes) ? bytes : workspace_bytes;
+        }
+    }
+
+    if (pipe2(wake_pipe, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        perror("sigkd: pipe");
+        return EXIT_FAILURE;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    listen_fd = open_socket(path);
+    if (listen_fd < 0)
+        return EXIT_FAILURE;
+
+    threads = calloc(workers, sizeof(pthread_t));
+    if (threads == NULL)
+        return EXIT_FAILURE;
+    for (i = 0; i < workers; i++)
+    {
+        if (pthread_create(&threads[i], NULL, worker, NULL) != 0)
+        {
+            perror("sigkd: pthread_create");
+            return EXIT_FAILURE;
+        }
+    }
+
+    while (!stopping)
+    {
+        job_t *batch_head = NULL, *batch_tail = NULL;
+        unsigned long count = 0;
+        struct pollfd *grown = realloc(fds, (nclients + 2) * sizeof(struct pollfd));
+
+        if (grown == NULL)
+            break;
+        fds = grown;
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = wake_pipe[0];
+        fds[1].events = POLLIN;
+        nfds = 2;
+        pthread_mutex_lock(&pool.lock);
+        for (c = clients; c != NULL; c = c->next)
+        { // Clients with SIGKD_MAX_INFLIGHT requests and results queued are not read until one is sent
+            pthread_mutex_lock(&c->out_lock);
+            fds[nfds].fd = c->fd;
+            fds[nfds].events = (c->inflight + c->out_count < SIGKD_MAX_INFLIGHT) ? POLLIN : 0;
+            fds[nfds].events |= (c->out_count != 0) ? POLLOUT : 0;
+            pthread_mutex_unlock(&c->out_lock);
+            nfds++;
+        }
+        pthread_mutex_unlock(&pool.lock);
+
+        if (poll(fds, nfds, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("sigkd: poll");
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+        {
+            while (read(wake_pipe[0], drain, sizeof(drain)) > 0)
+            {
+            }
+        }
+
+        // One round: read every ready client, then queue all their requests at once
+        i = 2;
+        for (link = &clients; (c = *link) != NULL; i++)
+        {
+            int gone = 0;
+
+            if (fds[i].revents & POLLOUT)
+            {
+                pthread_mutex_lock(&c->out_lock);
+                flush_output(c);
+                pthread_mutex_unlock(&c->out_lock);
+            }
+            if (fds[i].revents & POLLIN)
+            {
+                if (c->buffer == NULL)
+                    gone = recv_hello(c);
+                else
+                    gone = read_requests(c, &batch_head, &batch_tail, &count);
+            }
+            else if (fds[i].revents & (POLLHUP | POLLERR))
+            { // Hung up while throttled
+                gone = 1;
+            }
+            pthread_mutex_lock(&c->out_lock);
+            if (c->failed)
+            { // Disconnect a client whose results cannot be delivered
+                shutdown(c->fd, SHUT_WR);
+                gone = 1;
+            }
+            pthread_mutex_unlock(&c->out_lock);
+            if (gone)
+            { // Requests in flight keep the client until they complete
+                *link = c->next;
+                nclients--;
+                shutdown(c->fd, SHUT_RD);
+                client_release(c);
+            }
+            else
+            {
+                link = &c->next;
+            }
+        }
+        if (count != 0)
+        {
+            pthread_mutex_lock(&pool.lock);
+            if (pool.tail != NULL)
+                pool.tail->next = batch_head;
+            else
+                pool.head = batch_head;
+            pool.tail = batch_tail;
+            pool.requests += count;
+            pool.batches++;
+            pool.largest = (count > pool.largest) ? count : pool.largest;
+            pthread_cond_broadcast(&pool.cond);
+            pthread_mutex_unlock(&pool.lock);
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            int fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+            c = (fd >= 0) ? calloc(1, sizeof(client_t)) : NULL;
+            if (c != NULL)
+            {
+                c->fd = fd;
+                c->refs = 1;
+                pthread_mutex_init(&c->out_lock, NULL);
+                c->next = clients;
+                clients = c;
+                nclients++;
+            }
+            else if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    // Finish the queued requests, then drop the connections
+    close(listen_fd);
+    unlink(path);
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 1;
+    pthread_cond_broadcast(&pool.cond);
+    pthread_mutex_unlock(&pool.lock);
+    for (i = 0; i < workers; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    while (clients != NULL)
+    {
+        c = clients;
+        clients = c->next;
+        client_release(c);
+    }
+    if (verbose)
+    {
+        printf("sigkd: %lu requests in %lu batches, largest batch %lu\n", pool.requests, pool.batches, pool.largest);
+    }
+    free(fds);
+    free(threads);
+    return EXIT_SUCCESS;
+}
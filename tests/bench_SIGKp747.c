@@ -0,0 +1,598 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: benchmarking of the field, curve and protocol layers of SIGKp747
+*
+* Usage: bench_SIGK_747 [-n samples] [-p protocol_samples] [-w warmup] [-c cpu] [-e] [-f text|csv|json] [-o file] [-m match]
+*   -n  timed samples of each primitive (default 1000)
+*   -p  timed samples of each protocol function (default 11)
+*   -w  untimed runs of each benchmark before sampling (default 10, 1 for protocol functions)
+*   -c  pin the process to the given core
+*   -e  read the hardware performance counters (instructions, IPC, branch and L1D misses) with perf_event_open
+*       and break the protocol functions down into the phases reported by the trace hook
+*   -f  output format
+*   -o  write the results to a file instead of stdout
+*   -m  only run the benchmarks whose name contains the given string
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "../P747_internal.h"
+#include "../random.h"
+#include "test_extras.h"
+
+#define SCHEME_NAME "SIGKp747"
+
+// Default benchmark parameters
+#define BENCH_SAMPLES 1000
+#define BENCH_SAMPLES_PROTOCOL 11
+#define BENCH_WARMUP 10
+
+#define FORMAT_TEXT 0
+#define FORMAT_CSV 1
+#define FORMAT_JSON 2
+
+// Inputs and outputs of the benchmarked functions
+static felm_t fa, fb, fc;
+static f2elm_t a, b, c, A24plus, C24, coeff[3];
+static point_proj_t P, Q, R, Pdbl;
+static point_block blocks[1];
+static unsigned char sk_A[CRYPTO_SECRETKEYBYTES], sk_B[CRYPTO_SECRETKEYBYTES], sk_C[CRYPTO_SECRETKEYBYTES];
+static unsigned char pk_A[CRYPTO_PUBLICKEYBYTES], pk_B[CRYPTO_PUBLICKEYBYTES], pk_C[CRYPTO_PUBLICKEYBYTES];
+static unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES], sp_BC[CRYPTO_SHAREDPUBLICBYTES], sp_AC[CRYPTO_SHAREDPUBLICBYTES];
+static unsigned char ss_A[CRYPTO_BYTES], ss_B[CRYPTO_BYTES], ss_C[CRYPTO_BYTES];
+
+static void run_fpadd(void) { fpadd(fa, fb, fc); }
+static void run_fpmul(void) { fpmul_mont(fa, fb, fc); }
+static void run_fpsqr(void) { fpsqr_mont(fa, fc); }
+static void run_fpinv(void) { fpcopy(fa, fc); fpinv_chain_mont(fc); }
+static void run_fp2mul(void) { fp2mul_mont(a, b, c); }
+static void run_fp2sqr(void) { fp2sqr_mont(a, c); }
+static void run_fp2inv(void) { fp2copy(a, c); fp2inv_mont(c); }
+static void run_xDBLe(void) { xDBLe(P, R, A24plus, C24, 2); }
+static void run_xTPLe(void) { xTPLe(P, R, A24plus, C24, 1); }
+static void run_xQNTPLe(void) { xQNTPLe(P, R, A24plus, C24, 1); }
+static void run_xDBLe_E0(void) { xDBLe_E0(P, R, 2); }
+static void run_xTPLe_E0(void) { xTPLe_E0(P, R, 1); }
+static void run_xQNTPLe_E0(void) { xQNTPLe_E0(P, R, 1); }
+static void run_eval_4(void) { eval_4_isog(Q, coeff); }
+static void run_eval_3(void) { eval_3_isog(Q, (const f2elm_t *)coeff); }
+static void run_eval_5(void) { eval_5_isog(P, Pdbl, Q); }
+static void run_eval_4_multi(void) { eval_4_isog_multi(blocks, EVAL_BLOCK, (const f2elm_t *)coeff); }
+static void run_eval_3_multi(void) { eval_3_isog_multi(blocks, EVAL_BLOCK, (const f2elm_t *)coeff); }
+static void run_eval_5_multi(void) { eval_5_isog_multi(P, Pdbl, blocks, EVAL_BLOCK); }
+static void run_get_A_projective(void) { get_A_projective(P, Q, Pdbl, A24plus, C24); }
+static void run_ladder_A(void) { LADDER3PT(a, b, c, (digit_t *)sk_A, ALICE, R, A24plus); }
+static void run_ladder_B(void) { LADDER3PT(a, b, c, (digit_t *)sk_B, BOB, R, A24plus); }
+static void run_ladder_C(void) { LADDER3PT(a, b, c, (digit_t *)sk_C, EVE, R, A24plus); }
+static void ladder_E0(const unsigned char *sk, const unsigned int nbits)
+{ // The ladder of a key generation, on the base curve
+    point_proj_t R0, R2;
+    f2elm_t A0 = {0}, A24;
+
+    LADDER3PT_init(a, b, c, A0, R0, R2, R, A24);
+    LADDER3PT_bits_E0((digit_t *)sk, 0, nbits, R0, R2, R);
+}
+static void run_ladder_E0_A(void) { ladder_E0(sk_A, OALICE_BITS); }
+static void run_ladder_E0_B(void) { ladder_E0(sk_B, OBOB_BITS); }
+static void run_ladder_E0_C(void) { ladder_E0(sk_C, OEVE_BITS); }
+static void run_keygen_A(void) { EphemeralKeyGeneration_A(sk_A, pk_A); }
+static void run_keygen_B(void) { EphemeralKeyGeneration_B(sk_B, pk_B); }
+static void run_keygen_C(void) { EphemeralKeyGeneration_C(sk_C, pk_C); }
+static void run_shared_public_AB(void) { BSharedPublicFromA(sk_B, pk_A, sp_AB); }
+static void run_shared_secret_C(void) { CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C); }
+static void run_shared_secret_A(void) { ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A); }
+static void run_shared_secret_B(void) { BSharedSecretFromA(sk_B, sp_AC, ss_B); }
+
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+    unsigned int reps;     // Calls per timed sample, the reported figures are per call
+    unsigned int protocol; // 1 for the protocol functions, which use the protocol sample count
+} bench_t;
+
+static const bench_t benches[] = {
+    {"fpadd", run_fpadd, 1000, 0},
+    {"fpmul_mont", run_fpmul, 100, 0},
+    {"fpsqr_mont", run_fpsqr, 100, 0},
+    {"fpinv_chain_mont", run_fpinv, 1, 0},
+    {"fp2mul_mont", run_fp2mul, 100, 0},
+    {"fp2sqr_mont", run_fp2sqr, 100, 0},
+    {"fp2inv_mont", run_fp2inv, 1, 0},
+    {"xDBLe_2", run_xDBLe, 10, 0},
+    {"xTPLe_1", run_xTPLe, 10, 0},
+    {"xQNTPLe_1", run_xQNTPLe, 10, 0},
+    {"xDBLe_E0_2", run_xDBLe_E0, 10, 0},
+    {"xTPLe_E0_1", run_xTPLe_E0, 10, 0},
+    {"xQNTPLe_E0_1", run_xQNTPLe_E0, 10, 0},
+    {"eval_4_isog", run_eval_4, 10, 0},
+    {"eval_3_isog", run_eval_3, 10, 0},
+    {"eval_5_isog", run_eval_5, 10, 0},
+    {"eval_4_isog_multi_4", run_eval_4_multi, 10, 0},
+    {"eval_3_isog_multi_4", run_eval_3_multi, 10, 0},
+    {"eval_5_isog_multi_4", run_eval_5_multi, 10, 0},
+    {"get_A_projective", run_get_A_projective, 10, 0},
+    {"LADDER3PT_A", run_ladder_A, 1, 0},
+    {"LADDER3PT_B", run_ladder_B, 1, 0},
+    {"LADDER3PT_C", run_ladder_C, 1, 0},
+    {"LADDER3PT_E0_A", run_ladder_E0_A, 1, 0},
+    {"LADDER3PT_E0_B", run_ladder_E0_B, 1, 0},
+    {"LADDER3PT_E0_C", run_ladder_E0_C, 1, 0},
+    {"EphemeralKeyGeneration_A", run_keygen_A, 1, 1},
+    {"EphemeralKeyGeneration_B", run_keygen_B, 1, 1},
+    {"EphemeralKeyGeneration_C", run_keygen_C, 1, 1},
+    {"BSharedPublicFromA", run_shared_public_AB, 1, 1},
+    {"CSharedSecretFromB", run_shared_secret_C, 1, 1},
+    {"ASharedSecretFromC", run_shared_secret_A, 1, 1},
+    {"BSharedSecretFromA", run_shared_secret_B, 1, 1},
+};
+
+#define NUM_BENCHES (sizeof(benches) / sizeof(benches[0]))
+
+// Hardware counters of the -e mode
+#define COUNTER_CYCLES 0
+#define COUNTER_INSTRUCTIONS 1
+#define COUNTER_BRANCH_MISSES 2
+#define COUNTER_L1D_MISSES 3
+#define NUM_COUNTERS 4
+
+static const struct
+{
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+} counter_defs[NUM_COUNTERS] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"L1D-read-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+static int counter_fd[NUM_COUNTERS] = {-1, -1, -1, -1};
+static unsigned int counters_open = 0; // Number of counters the kernel granted
+
+static const char *phase_names[SIGK_NUM_PHASES] = {"decode", "get_A", "ladder", "traverse", "normalize", "j_inv", "encode"};
+
+typedef struct
+{
+    double min, median, p90, p99, mean;
+    double counters[NUM_COUNTERS]; // Per call, when the counter is open
+    unsigned int samples;
+} stats_t;
+
+// Cycles and counter values of each phase of one protocol function, accumulated by the trace hook
+typedef struct
+{
+    int64_t start, cycles[SIGK_NUM_PHASES];
+    uint64_t begin[NUM_COUNTERS], counts[SIGK_NUM_PHASES][NUM_COUNTERS];
+    unsigned int seen[SIGK_NUM_PHASES];
+} phase_acc_t;
+
+static void random_felm(felm_t x)
+{ // Random element in [0, p747), the top digit is kept below the one of p747
+    randombytes((unsigned char *)x, NWORDS_FIELD * sizeof(digit_t));
+    x[NWORDS_FIELD - 1] &= ((digit_t)-1) >> (NWORDS_FIELD * RADIX - NBITS_FIELD + 1);
+}
+
+static void random_f2elm(f2elm_t x)
+{
+    random_felm(x[0]);
+    random_felm(x[1]);
+}
+
+static void init_inputs(void)
+{ // Random inputs for the primitives and a complete exchange for the protocol functions
+    unsigned int i;
+
+    random_felm(fa);
+    random_felm(fb);
+    random_f2elm(a);
+    random_f2elm(b);
+    random_f2elm(c);
+    random_f2elm(A24plus);
+    random_f2elm(C24);
+    for (i = 0; i < 3; i++)
+    {
+        random_f2elm(coeff[i]);
+    }
+    random_f2elm(P->X);
+    random_f2elm(P->Z);
+    random_f2elm(Q->X);
+    random_f2elm(Q->Z);
+    random_f2elm(Pdbl->X);
+    random_f2elm(Pdbl->Z);
+    for (i = 0; i < EVAL_BLOCK; i++)
+    {
+        random_f2elm(blocks[0].X[i]);
+        random_f2elm(blocks[0].Z[i]);
+    }
+
+    random_mod_order_A(sk_A);
+    random_mod_order_B(sk_B);
+    random_mod_order_C(sk_C);
+    EphemeralKeyGeneration_A(sk_A, pk_A);
+    EphemeralKeyGeneration_B(sk_B, pk_B);
+    EphemeralKeyGeneration_C(sk_C, pk_C);
+    BSharedPublicFromA(sk_B, pk_A, sp_AB);
+    CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+    ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+    BSharedSecretFromA(sk_B, sp_AC, ss_B);
+}
+
+static void open_counters(void)
+{ // Open the counters of this process. Those refused by the kernel (no PMU, perf_event_paranoid, containers) are left out.
+    struct perf_event_attr attr;
+    unsigned int k;
+
+    for (k = 0; k < NUM_COUNTERS; k++)
+    {
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counter_defs[k].type;
+        attr.config = counter_defs[k].config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counter_fd[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counter_fd[k] < 0)
+        {
+            fprintf(stderr, "%s counter unavailable: %s\n", counter_defs[k].name, strerror(errno));
+            continue;
+        }
+        counters_open += 1;
+    }
+    if (counters_open == 0)
+    {
+        fprintf(stderr, "no hardware counters available, reporting timings only\n");
+    }
+}
+
+static void close_counters(void)
+{
+    unsigned int k;
+
+    for (k = 0; k < NUM_COUNTERS; k++)
+    {
+        if (counter_fd[k] >= 0)
+            close(counter_fd[k]);
+        counter_fd[k] = -1;
+    }
+}
+
+static void read_counters(uint64_t *v)
+{ // Current value of each open counter, scaled up when the kernel multiplexed it
+    uint64_t buf[3];
+    unsigned int k;
+
+    for (k = 0; k < NUM_COUNTERS; k++)
+    {
+        v[k] = 0;
+        if (counter_fd[k] < 0 || read(counter_fd[k], buf, sizeof(buf)) != sizeof(buf))
+            continue;
+        v[k] = (buf[2] != 0 && buf[2] < buf[1]) ? (uint64_t)((double)buf[0] * buf[1] / buf[2]) : buf[0];
+    }
+}
+
+static int compare_samples(const void *x, const void *y)
+{
+    int64_t u = *(const int64_t *)x, v = *(const int64_t *)y;
+    return (u > v) - (u < v);
+}
+
+static double percentile(const int64_t *sorted, const unsigned int n, const unsigned int pct)
+{ // Nearest-rank percentile of n sorted samples
+    unsigned int rank = (pct * n + 99) / 100;
+    return (double)sorted[(rank == 0) ? 0 : rank - 1];
+}
+
+static void summarize(int64_t *t, const unsigned int samples, const unsigned int reps, stats_t *st)
+{ // Statistics per call of "samples" timings of "reps" calls each
+    unsigned int i;
+    int64_t sum = 0;
+
+    for (i = 0; i < samples; i++)
+    {
+        sum += t[i];
+    }
+    qsort(t, samples, sizeof(int64_t), compare_samples);
+
+    st->samples = samples;
+    st->min = (double)t[0] / reps;
+    st->median = percentile(t, samples, 50) / reps;
+    st->p90 = percentile(t, samples, 90) / reps;
+    st->p99 = percentile(t, samples, 99) / reps;
+    st->mean = (double)sum / samples / reps;
+}
+
+static void run_bench(const bench_t *bench, const unsigned int samples, const unsigned int warmup, int64_t *t, stats_t *st)
+{ // Time "samples" batches of bench->reps calls after "warmup" untimed batches
+    unsigned int i, j, k;
+    int64_t cycles;
+    uint64_t before[NUM_COUNTERS], after[NUM_COUNTERS];
+
+    for (i = 0; i < warmup; i++)
+    {
+        for (j = 0; j < bench->reps; j++)
+        {
+            bench->run();
+        }
+    }
+    read_counters(before);
+    for (i = 0; i < samples; i++)
+    {
+        cycles = cpucycles();
+        for (j = 0; j < bench->reps; j++)
+        {
+            bench->run();
+        }
+        t[i] = cpucycles() - cycles;
+    }
+    read_counters(after);
+    for (k = 0; k < NUM_COUNTERS; k++)
+    {
+        st->counters[k] = (double)(after[k] - before[k]) / samples / bench->reps;
+    }
+    summarize(t, samples, bench->reps, st);
+}
+
+static void phase_hook(void *ctx, unsigned int op, unsigned int phase, unsigned int event, uint64_t timestamp_ns)
+{ // Trace hook accumulating the cycles and counter values spent in each phase
+    phase_acc_t *acc = (phase_acc_t *)ctx;
+    uint64_t v[NUM_COUNTERS];
+    unsigned int k;
+
+    (void)op;
+    (void)timestamp_ns;
+    if (event == SIGK_TRACE_BEGIN)
+    {
+        read_counters(acc->begin);
+        acc->start = cpucycles();
+        return;
+    }
+    acc->cycles[phase] += cpucycles() - acc->start;
+    read_counters(v);
+    for (k = 0; k < NUM_COUNTERS; k++)
+    {
+        acc->counts[phase][k] += v[k] - acc->begin[k];
+    }
+    acc->seen[phase] = 1;
+}
+
+static void run_phases(const bench_t *bench, const unsigned int samples, int64_t *t, phase_acc_t *total)
+{ // Run a protocol function "samples" times under the trace hook. The cycles of phase p in run i are stored in t[p * samples + i]
+    phase_acc_t acc;
+    unsigned int i, p, k;
+
+    memset(total, 0, sizeof(phase_acc_t));
+    for (i = 0; i < samples; i++)
+    {
+        memset(&acc, 0, sizeof(acc));
+        sigk_set_trace_hook(phase_hook, &acc);
+        bench->run();
+        sigk_set_trace_hook(NULL, NULL);
+        for (p = 0; p < SIGK_NUM_PHASES; p++)
+        {
+            t[p * samples + i] = acc.cycles[p];
+            total->seen[p] |= acc.seen[p];
+            for (k = 0; k < NUM_COUNTERS; k++)
+            {
+                total->counts[p][k] += acc.counts[p][k];
+            }
+        }
+    }
+}
+
+static const char *unit_name(void)
+{
+#if (TARGET == TARGET_ARM || TARGET == TARGET_ARM64)
+    return "nsec";
+#else
+    return "cycles";
+#endif
+}
+
+static void print_header(FILE *out, const int format, const unsigned int samples, const unsigned int samples_protocol, const unsigned int warmup, const int cpu)
+{
+    if (format == FORMAT_TEXT)
+    {
+        fprintf(out, "\n\nBENCHMARKING LAYERS OF ISOGENY-BASED GROUP KEY MECHANISM %s\n", SCHEME_NAME);
+        fprintf(out, "--------------------------------------------------------------------------------------------------------\n");
+        fprintf(out, "  %u samples per primitive, %u per protocol function, %u warm-up runs, ", samples, samples_protocol, warmup);
+        if (cpu >= 0)
+            fprintf(out, "pinned to core %d, ", cpu);
+        fprintf(out, "%s per call\n\n", unit_name());
+        fprintf(out, "  %-30s %12s %12s %12s %12s %12s", "", "min", "median", "p90", "p99", "mean");
+        if (counters_open > 0)
+            fprintf(out, " %12s %6s %10s %10s", "instr", "IPC", "br-miss", "L1D-miss");
+        fprintf(out, "\n");
+    }
+    else if (format == FORMAT_CSV)
+    {
+        fprintf(out, "scheme,name,unit,reps,samples,min,median,p90,p99,mean%s\n", (counters_open > 0) ? ",instructions,ipc,branch_misses,l1d_misses" : "");
+    }
+    else
+    {
+        fprintf(out, "{\n  \"scheme\": \"%s\",\n  \"unit\": \"%s\",\n  \"warmup\": %u,\n  \"cpu\": %d,\n  \"results\": [", SCHEME_NAME, unit_name(), warmup, cpu);
+    }
+}
+
+static void print_counter(FILE *out, const int format, const char *key, const unsigned int k, const double value, const int width)
+{ // One counter value, left empty (or null) when the counter is not open
+    const int open = (counter_fd[k] >= 0) && (k != COUNTER_CYCLES || counter_fd[COUNTER_INSTRUCTIONS] >= 0);
+
+    if (format == FORMAT_TEXT)
+        open ? fprintf(out, " %*.*f", width, (key[0] == 'i' && key[1] == 'p') ? 2 : 0, value) : fprintf(out, " %*s", width, "-");
+    else if (format == FORMAT_CSV)
+        open ? fprintf(out, ",%.2f", value) : fprintf(out, ",");
+    else
+        open ? fprintf(out, ", \"%s\": %.2f", key, value) : fprintf(out, ", \"%s\": null", key);
+}
+
+static void print_counters(FILE *out, const int format, const stats_t *st)
+{ // Counters of a result, IPC takes the place of the cycle counter
+    const double ipc = (st->counters[COUNTER_CYCLES] > 0) ? st->counters[COUNTER_INSTRUCTIONS] / st->counters[COUNTER_CYCLES] : 0;
+
+    if (counters_open == 0)
+        return;
+    print_counter(out, format, "instructions", COUNTER_INSTRUCTIONS, st->counters[COUNTER_INSTRUCTIONS], 12);
+    print_counter(out, format, "ipc", COUNTER_CYCLES, ipc, 6);
+    print_counter(out, format, "branch_misses", COUNTER_BRANCH_MISSES, st->counters[COUNTER_BRANCH_MISSES], 10);
+    print_counter(out, format, "l1d_misses", COUNTER_L1D_MISSES, st->counters[COUNTER_L1D_MISSES], 10);
+}
+
+static void print_result(FILE *out, const int format, const char *name, const unsigned int reps, const stats_t *st, const unsigned int first)
+{
+    if (format == FORMAT_TEXT)
+    {
+        fprintf(out, "  %-30s %12.0f %12.0f %12.0f %12.0f %12.0f", name, st->min, st->median, st->p90, st->p99, st->mean);
+        print_counters(out, format, st);
+        fprintf(out, "\n");
+    }
+    else if (format == FORMAT_CSV)
+    {
+        fprintf(out, "%s,%s,%s,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f", SCHEME_NAME, name, unit_name(), reps, st->samples, st->min, st->median, st->p90, st->p99, st->mean);
+        print_counters(out, format, st);
+        fprintf(out, "\n");
+    }
+    else
+    {
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"reps\": %u, \"samples\": %u, \"min\": %.1f, \"median\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"mean\": %.1f",
+                first ? "" : ",", name, reps, st->samples, st->min, st->median, st->p90, st->p99, st->mean);
+        print_counters(out, format, st);
+        fprintf(out, "}");
+    }
+}
+
+static void print_phases(FILE *out, const int format, const bench_t *bench, const unsigned int samples, int64_t *t, const phase_acc_t *total)
+{ // Results of each phase of a protocol function, named "function/phase"
+    char name[64];
+    stats_t st;
+    unsigned int p, k;
+
+    for (p = 0; p < SIGK_NUM_PHASES; p++)
+    {
+        if (!total->seen[p])
+            continue;
+        summarize(t + p * samples, samples, 1, &st);
+        for (k = 0; k < NUM_COUNTERS; k++)
+        {
+            st.counters[k] = (double)total->counts[p][k] / samples;
+        }
+        snprintf(name, sizeof(name), "%s/%s", bench->name, phase_names[p]);
+        print_result(out, format, name, 1, &st, 0);
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-n samples] [-p protocol_samples] [-w warmup] [-c cpu] [-e] [-f text|csv|json] [-o file] [-m match]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int samples = BENCH_SAMPLES, samples_protocol = BENCH_SAMPLES_PROTOCOL, warmup = BENCH_WARMUP, i, n, first = 1;
+    int opt, cpu = -1, format = FORMAT_TEXT, perf = 0;
+    const char *match = NULL, *file = NULL;
+    FILE *out = stdout;
+    int64_t *t;
+    stats_t st;
+    phase_acc_t phases;
+    cpu_set_t set;
+
+    while ((opt = getopt(argc, argv, "n:p:w:c:ef:o:m:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': samples = (unsigned int)atoi(optarg); break;
+        case 'p': samples_protocol = (unsigned int)atoi(optarg); break;
+        case 'w': warmup = (unsigned int)atoi(optarg); break;
+        case 'c': cpu = atoi(optarg); break;
+        case 'e': perf = 1; break;
+        case 'o': file = optarg; break;
+        case 'm': match = optarg; break;
+        case 'f':
+            if (strcmp(optarg, "text") == 0)
+                format = FORMAT_TEXT;
+            else if (strcmp(optarg, "csv") == 0)
+                format = FORMAT_CSV;
+            else if (strcmp(optarg, "json") == 0)
+                format = FORMAT_JSON;
+            else
+            {
+                usage(argv[0]);
+                return FAILED;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return FAILED;
+        }
+    }
+    if (samples == 0 || samples_protocol == 0)
+    {
+        usage(argv[0]);
+        return FAILED;
+    }
+
+    if (cpu >= 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        {
+            perror("sched_setaffinity");
+            return FAILED;
+        }
+    }
+    if (file != NULL && (out = fopen(file, "w")) == NULL)
+    {
+        perror(file);
+        return FAILED;
+    }
+    t = malloc(sizeof(int64_t) * ((samples > SIGK_NUM_PHASES * samples_protocol) ? samples : SIGK_NUM_PHASES * samples_protocol));
+    if (t == NULL)
+    {
+        return FAILED;
+    }
+
+    init_inputs();
+    if (perf)
+    {
+        open_counters();
+    }
+    print_header(out, format, samples, samples_protocol, warmup, cpu);
+    for (i = 0; i < NUM_BENCHES; i++)
+    {
+        if (match != NULL && strstr(benches[i].name, match) == NULL)
+            continue;
+        n = benches[i].protocol ? samples_protocol : samples;
+        run_bench(&benches[i], n, benches[i].protocol ? (warmup > 0) : warmup, t, &st);
+        print_result(out, format, benches[i].name, benches[i].reps, &st, first);
+        if (perf && benches[i].protocol)
+        {
+            run_phases(&benches[i], n, t, &phases);
+            print_phases(out, format, &benches[i], n, t, &phases);
+        }
+        fflush(out);
+        first = 0;
+    }
+    if (format == FORMAT_JSON)
+        fprintf(out, "\n  ]\n}\n");
+    else if (format == FORMAT_TEXT)
+        fprintf(out, "\n");
+
+    close_counters();
+    free(t);
+    if (out != stdout)
+        fclose(out);
+    return PASSED;
+}
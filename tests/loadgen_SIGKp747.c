@@ -0,0 +1,404 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: three-party handshake load generator for SIGKp747
+* Parties A, B and C run as separate threads connected by pipes or Unix sockets, and each of them
+* executes its own passes of the four-pass group key exchange. The messages are framed with the functions
+* of api.h: the operations write their outputs into the outgoing messages and read the received ones in place.
+* Several groups of three parties can run at the same time.
+*
+* Usage: loadgen_SIGK_747 [-n handshakes] [-c concurrency] [-t pipe|unix] [-f text|json]
+*   -n  number of handshakes, spread over the groups (default 20)
+*   -c  number of groups of parties running at the same time (default 1)
+*   -t  transport between the parties
+*   -f  output format
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include "../api.h"
+#include "test_extras.h"
+
+#define SCHEME_NAME "SIGKp747"
+
+#define LOAD_HANDSHAKES 20
+#define LOAD_CONCURRENCY 1
+
+#define TRANSPORT_PIPE 0
+#define TRANSPORT_UNIX 1
+
+#define FORMAT_TEXT 0
+#define FORMAT_JSON 1
+
+#define PARTY_A 0
+#define PARTY_B 1
+#define PARTY_C 2
+
+typedef struct
+{
+    uint64_t start[3], done[3]; // Monotonic time at which each party started and completed the handshake
+    uint64_t busy[3];           // Wall time spent by each party in the library calls
+    unsigned char ss[3][CRYPTO_BYTES];
+} handshake_t;
+
+// Three parties connected by the channels A -> B, B -> C and C -> A. Index 0 of a channel is the read end.
+typedef struct
+{
+    int ab[2], bc[2], ca[2];
+    handshake_t *hs;
+    unsigned int count;
+    int status[3];
+} group_t;
+
+typedef struct
+{
+    group_t *group;
+    unsigned int party;
+} party_arg_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static int send_all(const int fd, const unsigned char *buf, size_t len)
+{ // Write a whole message, returns 0 on success
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int recv_all(const int fd, unsigned char *buf, size_t len)
+{ // Read a whole message, returns 0 on success and 1 on error or if the peer closed the channel
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = read(fd, buf, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int run_A(group_t *g)
+{ // Key generation, pass 1, then ASharedSecretFromC on pass 3 and pass 4
+    unsigned char sk[CRYPTO_SECRETKEYBYTES], m1[SIGK_PASS1_BYTES], in[SIGK_PASS3_BYTES], m4[SIGK_PASS4_BYTES];
+    unsigned char *pk, *sp;
+    const unsigned char *pk_C, *sp_BC;
+    unsigned int i;
+    uint64_t t;
+
+    sigk_frame_init(1, m1, &pk, NULL);
+    sigk_frame_init(4, m4, NULL, &sp);
+    for (i = 0; i < g->count; i++)
+    {
+        handshake_t *h = &g->hs[i];
+
+        h->start[PARTY_A] = t = now_ns();
+        random_mod_order_A(sk);
+        EphemeralKeyGeneration_A(sk, pk);
+        h->busy[PARTY_A] = now_ns() - t;
+        if (send_all(g->ab[1], m1, SIGK_PASS1_BYTES) != 0 || recv_all(g->ca[0], in, SIGK_PASS3_BYTES) != 0)
+            return 1;
+        t = now_ns();
+        if (sigk_frame_parse(3, in, SIGK_PASS3_BYTES, &pk_C, &sp_BC) != 0 || ASharedSecretFromC(sk, pk_C, sp_BC, sp, h->ss[PARTY_A]) != 0)
+            return 1;
+        h->busy[PARTY_A] += now_ns() - t;
+        if (send_all(g->ab[1], m4, SIGK_PASS4_BYTES) != 0)
+            return 1;
+        h->done[PARTY_A] = now_ns();
+    }
+    return 0;
+}
+
+static int run_B(group_t *g)
+{ // Key generation, BSharedPublicFromA on pass 1 and pass 2, then BSharedSecretFromA on pass 4
+    unsigned char sk[CRYPTO_SECRETKEYBYTES], in[SIGK_PASS1_BYTES], m2[SIGK_PASS2_BYTES];
+    unsigned char *pk, *sp;
+    const unsigned char *pk_A, *sp_AC;
+    unsigned int i;
+    uint64_t t;
+
+    sigk_frame_init(2, m2, &pk, &sp);
+    for (i = 0; i < g->count; i++)
+    {
+        handshake_t *h = &g->hs[i];
+
+        h->start[PARTY_B] = t = now_ns();
+        random_mod_order_B(sk);
+        EphemeralKeyGeneration_B(sk, pk);
+        h->busy[PARTY_B] = now_ns() - t;
+        if (recv_all(g->ab[0], in, SIGK_PASS1_BYTES) != 0)
+            return 1;
+        t = now_ns();
+        if (sigk_frame_parse(1, in, SIGK_PASS1_BYTES, &pk_A, NULL) != 0 || BSharedPublicFromA(sk, pk_A, sp) != 0)
+            return 1;
+        h->busy[PARTY_B] += now_ns() - t;
+        if (send_all(g->bc[1], m2, SIGK_PASS2_BYTES) != 0 || recv_all(g->ab[0], in, SIGK_PASS4_BYTES) != 0)
+            return 1;
+        t = now_ns();
+        if (sigk_frame_parse(4, in, SIGK_PASS4_BYTES, NULL, &sp_AC) != 0 || BSharedSecretFromA(sk, sp_AC, h->ss[PARTY_B]) != 0)
+            return 1;
+        h->done[PARTY_B] = now_ns();
+        h->busy[PARTY_B] += h->done[PARTY_B] - t;
+    }
+    return 0;
+}
+
+static int run_C(group_t *g)
+{ // Key generation, then CSharedSecretFromB on pass 2 and pass 3
+    unsigned char sk[CRYPTO_SECRETKEYBYTES], in[SIGK_PASS2_BYTES], m3[SIGK_PASS3_BYTES];
+    unsigned char *pk, *sp;
+    const unsigned char *pk_B, *sp_AB;
+    unsigned int i;
+    uint64_t t;
+
+    sigk_frame_init(3, m3, &pk, &sp);
+    for (i = 0; i < g->count; i++)
+    {
+        handshake_t *h = &g->hs[i];
+
+        h->start[PARTY_C] = t = now_ns();
+        random_mod_order_C(sk);
+        EphemeralKeyGeneration_C(sk, pk);
+        h->busy[PARTY_C] = now_ns() - t;
+        if (recv_all(g->bc[0], in, SIGK_PASS2_BYTES) != 0)
+            return 1;
+        t = now_ns();
+        if (sigk_frame_parse(2, in, SIGK_PASS2_BYTES, &pk_B, &sp_AB) != 0 || CSharedSecretFromB(sk, pk_B, sp_AB, sp, h->ss[PARTY_C]) != 0)
+            return 1;
+        h->busy[PARTY_C] += now_ns() - t;
+        if (send_all(g->ca[1], m3, SIGK_PASS3_BYTES) != 0)
+            return 1;
+        h->done[PARTY_C] = now_ns();
+    }
+    return 0;
+}
+
+static void *party_thread(void *arg)
+{ // Run the passes of one party. Its outgoing channel is closed at the end so that a failing peer does not block the others.
+    party_arg_t *p = (party_arg_t *)arg;
+    group_t *g = p->group;
+
+    if (p->party == PARTY_A)
+    {
+        g->status[PARTY_A] = run_A(g);
+        close(g->ab[1]);
+    }
+    else if (p->party == PARTY_B)
+    {
+        g->status[PARTY_B] = run_B(g);
+        close(g->bc[1]);
+    }
+    else
+    {
+        g->status[PARTY_C] = run_C(g);
+        close(g->ca[1]);
+    }
+    return NULL;
+}
+
+static int open_channel(const int transport, int fd[2])
+{ // Unidirectional channel, fd[0] is the read end and fd[1] the write end
+    if (transport == TRANSPORT_PIPE)
+    {
+        return pipe(fd);
+    }
+    return socketpair(AF_UNIX, SOCK_STREAM, 0, fd);
+}
+
+static int compare_u64(const void *x, const void *y)
+{
+    uint64_t u = *(const uint64_t *)x, v = *(const uint64_t *)y;
+    return (u > v) - (u < v);
+}
+
+static double percentile_ms(const uint64_t *sorted, const unsigned int n, const unsigned int pct)
+{ // Nearest-rank percentile of n sorted durations in nanoseconds, in milliseconds
+    unsigned int rank = (pct * n + 99) / 100;
+    return sorted[(rank == 0) ? 0 : rank - 1] / 1e6;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-n handshakes] [-c concurrency] [-t pipe|unix] [-f text|json]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int handshakes = LOAD_HANDSHAKES, concurrency = LOAD_CONCURRENCY, i, j, k, n = 0;
+    int opt, transport = TRANSPORT_PIPE, format = FORMAT_TEXT, status = PASSED;
+    group_t *groups;
+    handshake_t *hs;
+    party_arg_t *args;
+    pthread_t *threads;
+    uint64_t *latency, busy[3] = {0}, wall;
+    double rate;
+
+    while ((opt = getopt(argc, argv, "n:c:t:f:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': handshakes = (unsigned int)atoi(optarg); break;
+        case 'c': concurrency = (unsigned int)atoi(optarg); break;
+        case 't':
+            if (strcmp(optarg, "pipe") == 0)
+                transport = TRANSPORT_PIPE;
+            else if (strcmp(optarg, "unix") == 0)
+                transport = TRANSPORT_UNIX;
+            else
+            {
+                usage(argv[0]);
+                return FAILED;
+            }
+            break;
+        case 'f':
+            if (strcmp(optarg, "text") == 0)
+                format = FORMAT_TEXT;
+            else if (strcmp(optarg, "json") == 0)
+                format = FORMAT_JSON;
+            else
+            {
+                usage(argv[0]);
+                return FAILED;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return FAILED;
+        }
+    }
+    if (handshakes == 0 || concurrency == 0 || concurrency > handshakes)
+    {
+        usage(argv[0]);
+        return FAILED;
+    }
+
+    groups = calloc(concurrency, sizeof(group_t));
+    hs = calloc(handshakes, sizeof(handshake_t));
+    args = calloc(3 * concurrency, sizeof(party_arg_t));
+    threads = calloc(3 * concurrency, sizeof(pthread_t));
+    latency = calloc(handshakes, sizeof(uint64_t));
+    if (groups == NULL || hs == NULL || args == NULL || threads == NULL || latency == NULL)
+    {
+        return FAILED;
+    }
+
+    for (i = 0; i < concurrency; i++)
+    { // The handshakes are spread evenly over the groups
+        groups[i].hs = hs + n;
+        groups[i].count = handshakes / concurrency + (i < handshakes % concurrency);
+        n += groups[i].count;
+        if (open_channel(transport, groups[i].ab) != 0 || open_channel(transport, groups[i].bc) != 0 || open_channel(transport, groups[i].ca) != 0)
+        {
+            perror("channel");
+            return FAILED;
+        }
+    }
+
+    wall = now_ns();
+    for (i = 0; i < 3 * concurrency; i++)
+    {
+        args[i].group = &groups[i / 3];
+        args[i].party = i % 3;
+        if (pthread_create(&threads[i], NULL, party_thread, &args[i]) != 0)
+        {
+            perror("pthread_create");
+            return FAILED;
+        }
+    }
+    for (i = 0; i < 3 * concurrency; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    wall = now_ns() - wall;
+
+    for (i = 0; i < concurrency; i++)
+    {
+        close(groups[i].ab[0]);
+        close(groups[i].bc[0]);
+        close(groups[i].ca[0]);
+        for (k = 0; k < 3; k++)
+        {
+            if (groups[i].status[k] != 0)
+                status = FAILED;
+        }
+    }
+    if (status != PASSED)
+    {
+        fprintf(stderr, "a party failed to exchange its messages\n");
+        return FAILED;
+    }
+
+    for (j = 0; j < handshakes; j++)
+    { // A handshake lasts from the first start to the last completion among the three parties
+        uint64_t first = hs[j].start[0], last = hs[j].done[0];
+
+        for (k = 0; k < 3; k++)
+        {
+            first = (hs[j].start[k] < first) ? hs[j].start[k] : first;
+            last = (hs[j].done[k] > last) ? hs[j].done[k] : last;
+            busy[k] += hs[j].busy[k];
+        }
+        latency[j] = last - first;
+        if (memcmp(hs[j].ss[PARTY_A], hs[j].ss[PARTY_B], CRYPTO_BYTES) != 0 || memcmp(hs[j].ss[PARTY_A], hs[j].ss[PARTY_C], CRYPTO_BYTES) != 0)
+        {
+            status = FAILED;
+        }
+    }
+    qsort(latency, handshakes, sizeof(uint64_t), compare_u64);
+    rate = handshakes / (wall / 1e9);
+
+    if (format == FORMAT_TEXT)
+    {
+        printf("\n\nTHREE-PARTY HANDSHAKE LOAD GENERATOR %s\n", SCHEME_NAME);
+        printf("--------------------------------------------------------------------------------------------------------\n");
+        printf("  %u handshakes, %u concurrent group(s) of 3 threads, %s transport\n\n", handshakes, concurrency, (transport == TRANSPORT_PIPE) ? "pipe" : "Unix socket");
+        printf("  Throughput ........................ %10.2f handshakes/s\n", rate);
+        printf("  Completion latency (ms) ........... min %.1f, p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+               latency[0] / 1e6, percentile_ms(latency, handshakes, 50), percentile_ms(latency, handshakes, 90), percentile_ms(latency, handshakes, 99), latency[handshakes - 1] / 1e6);
+        printf("  Compute per handshake (ms) ........ A %.1f, B %.1f, C %.1f\n", busy[PARTY_A] / 1e6 / handshakes, busy[PARTY_B] / 1e6 / handshakes, busy[PARTY_C] / 1e6 / handshakes);
+        printf("  Shared secrets .................... %s\n\n", (status == PASSED) ? "all equal" : "MISMATCH");
+    }
+    else
+    {
+        printf("{\n  \"scheme\": \"%s\",\n  \"handshakes\": %u,\n  \"concurrency\": %u,\n  \"transport\": \"%s\",\n", SCHEME_NAME, handshakes, concurrency, (transport == TRANSPORT_PIPE) ? "pipe" : "unix");
+        printf("  \"handshakes_per_second\": %.3f,\n", rate);
+        printf("  \"latency_ms\": {\"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+               latency[0] / 1e6, percentile_ms(latency, handshakes, 50), percentile_ms(latency, handshakes, 90), percentile_ms(latency, handshakes, 99), latency[handshakes - 1] / 1e6);
+        printf("  \"compute_ms\": {\"A\": %.3f, \"B\": %.3f, \"C\": %.3f},\n", busy[PARTY_A] / 1e6 / handshakes, busy[PARTY_B] / 1e6 / handshakes, busy[PARTY_C] / 1e6 / handshakes);
+        printf("  \"secrets_equal\": %s\n}\n", (status == PASSED) ? "true" : "false");
+    }
+
+    free(latency);
+    free(threads);
+    free(args);
+    free(hs);
+    free(groups);
+    return status;
+}
@@ -0,0 +1,275 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: multi-core scaling benchmark for SIGKp747
+* For N = 1 up to the number of cores, N threads each run complete group key exchanges (secret keys,
+* the three key generations and the four key agreement calls). The throughput of each thread count
+* is compared with N times the single-thread throughput.
+*
+* Usage: scale_SIGK_747 [-t max_threads] [-n exchanges] [-p] [-m local|interleave] [-f text|csv]
+*   -t  largest thread count (default: the number of cores available to the process)
+*   -n  exchanges per thread for each thread count (default 2)
+*   -p  pin thread i to the i-th core available to the process
+*   -m  NUMA memory policy of the threads: allocation on the local node, or interleaved over all nodes
+*   -f  output format
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "../api.h"
+#include "test_extras.h"
+
+#define SCHEME_NAME "SIGKp747"
+
+#define SCALE_EXCHANGES 2
+
+#define NUMA_DEFAULT 0
+#define NUMA_LOCAL 1
+#define NUMA_INTERLEAVE 2
+
+// Memory policies of set_mempolicy(2), see <linux/mempolicy.h>
+#define SIGK_MPOL_INTERLEAVE 3
+#define SIGK_MPOL_LOCAL 4
+
+#define FORMAT_TEXT 0
+#define FORMAT_CSV 1
+
+typedef struct
+{
+    unsigned int exchanges; // Exchanges to run
+    int cpu;                // Core the thread is pinned to, -1 if not pinned
+    int numa;
+    pthread_barrier_t *start;
+    unsigned int failures;  // Exchanges whose three shared secrets differ
+    int status;
+} worker_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static int set_numa_policy(const int numa)
+{ // Memory policy of the calling thread, returns 0 on success
+    unsigned long nodes[16];
+
+    if (numa == NUMA_LOCAL)
+    {
+        return (int)syscall(SYS_set_mempolicy, SIGK_MPOL_LOCAL, NULL, 0);
+    }
+    if (numa == NUMA_INTERLEAVE)
+    { // The kernel restricts the mask to the nodes the process may use
+        memset(nodes, 0xFF, sizeof(nodes));
+        return (int)syscall(SYS_set_mempolicy, SIGK_MPOL_INTERLEAVE, nodes, 8 * sizeof(nodes));
+    }
+    return 0;
+}
+
+static int exchange(void)
+{ // One complete group key exchange, returns 0 if the three parties agree on the shared secret
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES], sk_B[CRYPTO_SECRETKEYBYTES], sk_C[CRYPTO_SECRETKEYBYTES];
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES], pk_B[CRYPTO_PUBLICKEYBYTES], pk_C[CRYPTO_PUBLICKEYBYTES];
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES], sp_BC[CRYPTO_SHAREDPUBLICBYTES], sp_AC[CRYPTO_SHAREDPUBLICBYTES];
+    unsigned char ss_A[CRYPTO_BYTES], ss_B[CRYPTO_BYTES], ss_C[CRYPTO_BYTES];
+
+    random_mod_order_A(sk_A);
+    random_mod_order_B(sk_B);
+    random_mod_order_C(sk_C);
+    EphemeralKeyGeneration_A(sk_A, pk_A);
+    EphemeralKeyGeneration_B(sk_B, pk_B);
+    EphemeralKeyGeneration_C(sk_C, pk_C);
+    BSharedPublicFromA(sk_B, pk_A, sp_AB);
+    CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+    ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+    BSharedSecretFromA(sk_B, sp_AC, ss_B);
+
+    return (memcmp(ss_A, ss_B, CRYPTO_BYTES) != 0 || memcmp(ss_A, ss_C, CRYPTO_BYTES) != 0);
+}
+
+static void *worker_thread(void *arg)
+{ // Place the thread, wait for the others and run its exchanges
+    worker_t *w = (worker_t *)arg;
+    cpu_set_t set;
+    unsigned int i;
+
+    if (w->cpu >= 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET(w->cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            w->status = 1;
+    }
+    if (set_numa_policy(w->numa) != 0)
+    {
+        w->status = 1;
+    }
+    pthread_barrier_wait(w->start);
+    for (i = 0; i < w->exchanges; i++)
+    {
+        w->failures += exchange();
+    }
+    return NULL;
+}
+
+static int run_threads(const unsigned int nthreads, const unsigned int exchanges, const int *cpus, const int numa, double *seconds, unsigned int *failures)
+{ // Run "exchanges" exchanges on each of "nthreads" threads started together, returns 0 on success
+    pthread_t threads[CPU_SETSIZE];
+    worker_t workers[CPU_SETSIZE];
+    pthread_barrier_t start;
+    unsigned int i;
+    uint64_t t;
+    int status = 0;
+
+    pthread_barrier_init(&start, NULL, nthreads + 1);
+    for (i = 0; i < nthreads; i++)
+    {
+        memset(&workers[i], 0, sizeof(worker_t));
+        workers[i].exchanges = exchanges;
+        workers[i].cpu = (cpus != NULL) ? cpus[i] : -1;
+        workers[i].numa = numa;
+        workers[i].start = &start;
+        if (pthread_create(&threads[i], NULL, worker_thread, &workers[i]) != 0)
+        {
+            perror("pthread_create");
+            exit(FAILED);
+        }
+    }
+    pthread_barrier_wait(&start);
+    t = now_ns();
+    *failures = 0;
+    for (i = 0; i < nthreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+        *failures += workers[i].failures;
+        status |= workers[i].status;
+    }
+    *seconds = (now_ns() - t) / 1e9;
+    pthread_barrier_destroy(&start);
+
+    return status;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-t max_threads] [-n exchanges] [-p] [-m local|interleave] [-f text|csv]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int max_threads = 0, exchanges = SCALE_EXCHANGES, ncpus = 0, n, i, failures, total_failures = 0;
+    int opt, pin = 0, numa = NUMA_DEFAULT, format = FORMAT_TEXT;
+    int cpus[CPU_SETSIZE];
+    double seconds, rate, base_rate = 0;
+    cpu_set_t set;
+
+    while ((opt = getopt(argc, argv, "t:n:pm:f:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 't': max_threads = (unsigned int)atoi(optarg); break;
+        case 'n': exchanges = (unsigned int)atoi(optarg); break;
+        case 'p': pin = 1; break;
+        case 'm':
+            if (strcmp(optarg, "local") == 0)
+                numa = NUMA_LOCAL;
+            else if (strcmp(optarg, "interleave") == 0)
+                numa = NUMA_INTERLEAVE;
+            else
+            {
+                usage(argv[0]);
+                return FAILED;
+            }
+            break;
+        case 'f':
+            if (strcmp(optarg, "text") == 0)
+                format = FORMAT_TEXT;
+            else if (strcmp(optarg, "csv") == 0)
+                format = FORMAT_CSV;
+            else
+            {
+                usage(argv[0]);
+                return FAILED;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return FAILED;
+        }
+    }
+
+    // Cores available to the process, in increasing order
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    {
+        perror("sched_getaffinity");
+        return FAILED;
+    }
+    for (i = 0; i < CPU_SETSIZE; i++)
+    {
+        if (CPU_ISSET(i, &set))
+            cpus[ncpus++] = (int)i;
+    }
+    if (max_threads == 0)
+    {
+        max_threads = ncpus;
+    }
+    if (exchanges == 0 || max_threads > CPU_SETSIZE)
+    {
+        usage(argv[0]);
+        return FAILED;
+    }
+    if (pin && max_threads > ncpus)
+    {
+        fprintf(stderr, "cannot pin %u threads to %u cores\n", max_threads, ncpus);
+        return FAILED;
+    }
+
+    if (format == FORMAT_TEXT)
+    {
+        printf("\n\nMULTI-CORE SCALING OF ISOGENY-BASED GROUP KEY MECHANISM %s\n", SCHEME_NAME);
+        printf("--------------------------------------------------------------------------------------------------------\n");
+        printf("  %u exchanges per thread, %u cores available, %s, %s NUMA policy\n\n", exchanges, ncpus, pin ? "pinned threads" : "unpinned threads",
+               (numa == NUMA_LOCAL) ? "local" : ((numa == NUMA_INTERLEAVE) ? "interleaved" : "default"));
+        printf("  %8s %10s %12s %16s %10s %12s\n", "threads", "exchanges", "seconds", "exchanges/s", "speedup", "efficiency");
+    }
+    else
+    {
+        printf("scheme,threads,exchanges,seconds,exchanges_per_second,speedup,efficiency\n");
+    }
+
+    for (n = 1; n <= max_threads; n++)
+    {
+        if (run_threads(n, exchanges, pin ? cpus : NULL, numa, &seconds, &failures) != 0)
+        {
+            fprintf(stderr, "could not apply the requested thread placement\n");
+            return FAILED;
+        }
+        total_failures += failures;
+        rate = n * exchanges / seconds;
+        if (n == 1)
+            base_rate = rate;
+        if (format == FORMAT_TEXT)
+            printf("  %8u %10u %12.2f %16.3f %10.2f %11.1f%%\n", n, n * exchanges, seconds, rate, rate / base_rate, 100 * rate / (n * base_rate));
+        else
+            printf("%s,%u,%u,%.3f,%.4f,%.3f,%.3f\n", SCHEME_NAME, n, n * exchanges, seconds, rate, rate / base_rate, rate / (n * base_rate));
+        fflush(stdout);
+    }
+
+    if (total_failures != 0)
+    {
+        fprintf(stderr, "%u exchanges did not agree on the shared secret\n", total_failures);
+        return FAILED;
+    }
+    if (format == FORMAT_TEXT)
+        printf("\n");
+    return PASSED;
+}
@@ -0,0 +1,78 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: benchmarking/testing isogeny-based group key agreement mechanism SIGKp376
+* The tests of test_groupKey.c are run on the functions of P376_api.h, renamed below.
+*********************************************************************************************/ 
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../config.h"
+#include "test_extras.h"
+#include "../api.h"
+#include "../P376_api.h"
+
+#undef CRYPTO_SECRETKEYBYTES
+#undef CRYPTO_PUBLICKEYBYTES
+#undef CRYPTO_BYTES
+#undef CRYPTO_SHAREDPUBLICBYTES
+#undef CRYPTO_ALGNAME
+#undef SIGK_PASS1_BYTES
+#undef SIGK_PASS2_BYTES
+#undef SIGK_PASS3_BYTES
+#undef SIGK_PASS4_BYTES
+#define CRYPTO_SECRETKEYBYTES CRYPTO_SECRETKEYBYTES_SIGKp376
+#define CRYPTO_PUBLICKEYBYTES CRYPTO_PUBLICKEYBYTES_SIGKp376
+#define CRYPTO_BYTES CRYPTO_BYTES_SIGKp376
+#define CRYPTO_SHAREDPUBLICBYTES CRYPTO_SHAREDPUBLICBYTES_SIGKp376
+#define CRYPTO_ALGNAME CRYPTO_ALGNAME_SIGKp376
+#define SIGK_PASS1_BYTES SIGK_PASS1_BYTES_SIGKp376
+#define SIGK_PASS2_BYTES SIGK_PASS2_BYTES_SIGKp376
+#define SIGK_PASS3_BYTES SIGK_PASS3_BYTES_SIGKp376
+#define SIGK_PASS4_BYTES SIGK_PASS4_BYTES_SIGKp376
+
+#define random_mod_order_A random_mod_order_A_SIGKp376
+#define random_mod_order_B random_mod_order_B_SIGKp376
+#define random_mod_order_C random_mod_order_C_SIGKp376
+#define EphemeralKeyGeneration_A EphemeralKeyGeneration_A_SIGKp376
+#define EphemeralKeyGeneration_B EphemeralKeyGeneration_B_SIGKp376
+#define EphemeralKeyGeneration_C EphemeralKeyGeneration_C_SIGKp376
+#define BSharedPublicFromA BSharedPublicFromA_SIGKp376
+#define CSharedSecretFromB CSharedSecretFromB_SIGKp376
+#define ASharedSecretFromC ASharedSecretFromC_SIGKp376
+#define BSharedSecretFromA BSharedSecretFromA_SIGKp376
+#define sigk_start_EphemeralKeyGeneration_A sigk_start_EphemeralKeyGeneration_A_SIGKp376
+#define sigk_start_EphemeralKeyGeneration_B sigk_start_EphemeralKeyGeneration_B_SIGKp376
+#define sigk_start_EphemeralKeyGeneration_C sigk_start_EphemeralKeyGeneration_C_SIGKp376
+#define sigk_start_BSharedPublicFromA sigk_start_BSharedPublicFromA_SIGKp376
+#define sigk_start_CSharedSecretFromB sigk_start_CSharedSecretFromB_SIGKp376
+#define sigk_start_ASharedSecretFromC sigk_start_ASharedSecretFromC_SIGKp376
+#define sigk_start_BSharedSecretFromA sigk_start_BSharedSecretFromA_SIGKp376
+#define sigk_step sigk_step_SIGKp376
+#define sigk_workspace_size sigk_workspace_size_SIGKp376
+#define EphemeralKeyGeneration_A_ws EphemeralKeyGeneration_A_ws_SIGKp376
+#define EphemeralKeyGeneration_B_ws EphemeralKeyGeneration_B_ws_SIGKp376
+#define EphemeralKeyGeneration_C_ws EphemeralKeyGeneration_C_ws_SIGKp376
+#define BSharedPublicFromA_ws BSharedPublicFromA_ws_SIGKp376
+#define CSharedSecretFromB_ws CSharedSecretFromB_ws_SIGKp376
+#define ASharedSecretFromC_ws ASharedSecretFromC_ws_SIGKp376
+#define BSharedSecretFromA_ws BSharedSecretFromA_ws_SIGKp376
+#define sigk_frame_bytes sigk_frame_bytes_SIGKp376
+#define sigk_frame_init sigk_frame_init_SIGKp376
+#define sigk_frame_parse sigk_frame_parse_SIGKp376
+#define sigk_frame_iov sigk_frame_iov_SIGKp376
+#define sigk_frame_parse_iov sigk_frame_parse_iov_SIGKp376
+
+#define SCHEME_NAME    "SIGKp376"
+
+// Shared secret of the known-answer test of test_groupKey.c
+static const unsigned char kat_shared_secret[CRYPTO_BYTES] = {
+    0xD8, 0xAB, 0xDA, 0x71, 0xFB, 0xEF, 0xE6, 0x5F, 0xC1, 0x1E, 0xF4, 0x1B, 0x0C, 0xA8, 0xAC, 0xF0,
+    0x57, 0x3B, 0xB8, 0x6C, 0x33, 0xB8, 0x2F, 0xAA, 0x0A, 0xE1, 0x8C, 0x29, 0x1D, 0x99, 0x63, 0x55,
+    0x5A, 0x85, 0x69, 0xBE, 0x9D, 0x77, 0x97, 0xD0, 0x53, 0x7A, 0xC3, 0xA5, 0xD9, 0x31, 0x3B, 0x82,
+    0x4D, 0x6B, 0x3C, 0x49, 0x29, 0x65, 0xE9, 0x8A, 0xEF, 0x56, 0x85, 0xB4, 0x2E, 0x40, 0x31, 0xAC,
+    0x17, 0x4B, 0x3A, 0x64, 0x55, 0xD5, 0x0B, 0xEC, 0x20, 0x72, 0x37, 0x5A, 0xAE, 0x03, 0x5E, 0x77,
+    0x4C, 0x9D, 0xE5, 0x00, 0xB7, 0x15, 0x68, 0x0F, 0xD7, 0xAC, 0x1E, 0x9C, 0x8B, 0x6C};
+
+#include "test_groupKey.c"
@@ -5,6 +5,7 @@
 *********************************************************************************************/ 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../config.h"
 #include "test_extras.h"
@@ -13,4 +14,19 @@
 
 #define SCHEME_NAME    "SIGKp747"
 
+// Shared secret of the known-answer test of test_groupKey.c
+static const unsigned char kat_shared_secret[CRYPTO_BYTES] = {
+    0xD2, 0x7A, 0x57, 0x4A, 0x07, 0xA2, 0xAB, 0xF4, 0x22, 0x15, 0x3A, 0x6A, 0x03, 0xD9, 0x27, 0x38,
+    0xEE, 0x85, 0xD7, 0xBA, 0xD0, 0x2F, 0xDE, 0x5F, 0x9D, 0x39, 0xA3, 0x4E, 0x29, 0x7D, 0xCD, 0x34,
+    0x05, 0x8A, 0x6A, 0xC2, 0xA1, 0x11, 0xD9, 0x22, 0x65, 0x9D, 0x74, 0xE8, 0x3C, 0x5F, 0x6D, 0x4E,
+    0x68, 0x80, 0x9E, 0x22, 0x51, 0xF9, 0x2A, 0xEB, 0x2C, 0xCC, 0xB1, 0x46, 0x92, 0x40, 0x74, 0xE4,
+    0x8F, 0x91, 0xB1, 0xBD, 0x08, 0xE5, 0xAD, 0x39, 0x16, 0x65, 0x58, 0xF1, 0x3C, 0x9C, 0xA6, 0xA9,
+    0xF1, 0xD0, 0x4C, 0x9D, 0x7D, 0x10, 0xFA, 0x0C, 0xA6, 0xC6, 0xD6, 0x92, 0x1A, 0x01, 0x0B, 0x89,
+    0xF1, 0x4C, 0xAC, 0xD8, 0x03, 0x85, 0xD5, 0x44, 0xB9, 0x65, 0x61, 0x14, 0xCB, 0x9D, 0xDC, 0xCE,
+    0xE3, 0xC8, 0x54, 0xA0, 0x15, 0xCE, 0x00, 0x99, 0x62, 0x4C, 0x0A, 0x14, 0x77, 0x81, 0xBE, 0xEA,
+    0xE3, 0x22, 0x47, 0xFD, 0x3D, 0xCB, 0xB8, 0x97, 0x4F, 0x49, 0xB5, 0x15, 0x06, 0x7F, 0x0E, 0x14,
+    0x7E, 0x7E, 0x46, 0xED, 0x04, 0xA1, 0x00, 0x51, 0xA9, 0x22, 0x65, 0xDB, 0x50, 0x92, 0xB7, 0x5A,
+    0xD9, 0x77, 0xC1, 0xE3, 0x60, 0x8C, 0x2E, 0x55, 0xAB, 0x3C, 0x4D, 0x9F, 0xCD, 0x36, 0xA4, 0xC5,
+    0x15, 0xDB, 0x59, 0xAD, 0x06, 0x1A, 0x20, 0x51, 0x90, 0x5B, 0x4E, 0x00, 0x00, 0x00};
+
 #include "test_groupKey.c"
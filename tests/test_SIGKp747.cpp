@@ -0,0 +1,157 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: testing the C++ interface sigk.hpp
+* Runs complete group key exchanges through the key types and through spans over plain buffers, checks that they
+* agree with the C API, and counts the heap allocations made meanwhile.
+*********************************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../sigk.hpp"
+#include "test_extras.h"
+
+#define SCHEME_NAME    "SIGKp747"
+#define GROUPKEY_TEST_LOOPS 2
+
+static_assert(sizeof(sigk::private_key_A) == CRYPTO_SECRETKEYBYTES && sizeof(sigk::public_key) == CRYPTO_PUBLICKEYBYTES);
+static_assert(sizeof(sigk::shared_public) == CRYPTO_SHAREDPUBLICBYTES && sizeof(sigk::shared_secret) == CRYPTO_BYTES);
+static_assert(!std::is_copy_constructible_v<sigk::private_key_B> && !std::is_copy_assignable_v<sigk::private_key_B>);
+static_assert(std::is_nothrow_move_constructible_v<sigk::private_key_B> && std::is_nothrow_move_assignable_v<sigk::private_key_B>);
+static_assert(!std::is_copy_constructible_v<sigk::shared_secret> && std::is_nothrow_move_constructible_v<sigk::shared_secret>);
+static_assert(std::is_trivially_copyable_v<sigk::public_key> && std::is_trivially_copyable_v<sigk::shared_public>);
+static_assert(!std::is_same_v<sigk::private_key_A, sigk::private_key_B>);
+static_assert(noexcept(sigk::CSharedSecretFromB(std::declval<const sigk::private_key_C&>(), std::declval<const sigk::public_key&>(),
+                                                std::declval<const sigk::shared_public&>(), std::declval<sigk::shared_public&>(), std::declval<sigk::shared_secret&>())));
+
+// Heap allocations made by the program
+static unsigned long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static bool is_zero(const unsigned char* p, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (p[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+static bool exchange_types(void)
+{ // Exchange with the key types, checked against the C API on the same private keys
+    sigk::private_key_A skA;
+    sigk::private_key_B skB;
+    sigk::private_key_C skC;
+    sigk::public_key pkA, pkB, pkC;
+    sigk::shared_public spAB, spBC, spAC;
+    sigk::shared_secret ssA, ssB, ssC;
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0}, sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0}, ss[CRYPTO_BYTES] = {0};
+    int status = 0;
+
+    sigk::generate(skA);
+    sigk::generate(skB);
+    sigk::generate(skC);
+    status |= sigk::public_key_from(skA, pkA);
+    status |= sigk::public_key_from(skB, pkB);
+    status |= sigk::public_key_from(skC, pkC);
+    status |= sigk::BSharedPublicFromA(skB, pkA, spAB);
+    status |= sigk::CSharedSecretFromB(skC, pkB, spAB, spBC, ssC);
+    status |= sigk::ASharedSecretFromC(skA, pkC, spBC, spAC, ssA);
+    status |= sigk::BSharedSecretFromA(skB, spAC, ssB);
+    if (status != 0 || !(ssA == ssB) || !(ssA == ssC))
+        return false;
+
+    status |= EphemeralKeyGeneration_B(skB.data(), pk);
+    status |= CSharedSecretFromB(skC.data(), pk, spAB.data(), sp_BC, ss);
+    return status == 0 && memcmp(pk, pkB.data(), CRYPTO_PUBLICKEYBYTES) == 0 && memcmp(sp_BC, spBC.data(), CRYPTO_SHAREDPUBLICBYTES) == 0 &&
+           memcmp(ss, ssC.data(), CRYPTO_BYTES) == 0;
+}
+
+static bool exchange_spans(void)
+{ // Exchange with spans over plain buffers
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0}, sk_B[CRYPTO_SECRETKEYBYTES] = {0}, sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0}, pk_B[CRYPTO_PUBLICKEYBYTES] = {0}, pk_C[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_AC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_A[CRYPTO_BYTES] = {0}, ss_B[CRYPTO_BYTES] = {0}, ss_C[CRYPTO_BYTES] = {0};
+    int status = 0;
+
+    sigk::random_mod_order_A(sk_A);
+    sigk::random_mod_order_B(sk_B);
+    sigk::random_mod_order_C(sk_C);
+    status |= sigk::EphemeralKeyGeneration_A(sk_A, pk_A);
+    status |= sigk::EphemeralKeyGeneration_B(sk_B, pk_B);
+    status |= sigk::EphemeralKeyGeneration_C(sk_C, pk_C);
+    status |= sigk::BSharedPublicFromA(sk_B, pk_A, sp_AB);
+    status |= sigk::CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+    status |= sigk::ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+    status |= sigk::BSharedSecretFromA(sk_B, sp_AC, ss_B);
+
+    return status == 0 && memcmp(ss_A, ss_B, CRYPTO_BYTES) == 0 && memcmp(ss_A, ss_C, CRYPTO_BYTES) == 0;
+}
+
+static bool moves_wipe(void)
+{ // A moved-from secret is cleared, the destination holds the key
+    sigk::private_key_C sk, moved;
+    unsigned char copy[CRYPTO_SECRETKEYBYTES];
+
+    sigk::generate(sk);
+    memcpy(copy, sk.data(), CRYPTO_SECRETKEYBYTES);
+    moved = std::move(sk);
+    if (!is_zero(sk.data(), CRYPTO_SECRETKEYBYTES) || memcmp(moved.data(), copy, CRYPTO_SECRETKEYBYTES) != 0)
+        return false;
+    sigk::private_key_C constructed(std::move(moved));
+    if (!is_zero(moved.data(), CRYPTO_SECRETKEYBYTES) || memcmp(constructed.data(), copy, CRYPTO_SECRETKEYBYTES) != 0)
+        return false;
+    constructed.wipe();
+    return is_zero(constructed.data(), CRYPTO_SECRETKEYBYTES);
+}
+
+int main(void)
+{
+    bool passed = true;
+    unsigned long before;
+    int n;
+
+    printf("\n\nTESTING C++ INTERFACE OF ISOGENY-BASED GROUP KEY MECHANISM %s\n", SCHEME_NAME);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    before = allocations;
+    for (n = 0; n < GROUPKEY_TEST_LOOPS && passed; n++)
+    {
+        passed = exchange_types() && exchange_spans();
+    }
+    if (passed)
+        printf("  C++ GROUP KEY tests ................................................ PASSED\n");
+    else
+        printf("  C++ GROUP KEY tests ... FAILED\n");
+    if (passed && allocations != before)
+    {
+        printf("  %lu heap allocations during the exchanges\n", allocations - before);
+        passed = false;
+    }
+    if (passed)
+    {
+        passed = moves_wipe();
+        if (passed)
+            printf("  Secret wiping tests ................................................ PASSED\n");
+        else
+            printf("  Secret wiping tests ... FAILED\n");
+    }
+
+    return passed ? PASSED : FAILED;
+}
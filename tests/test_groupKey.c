@@ -67,6 +67,616 @@ int cryptotest_groupkey()
     return PASSED;
 }
 
+static void kat_key(unsigned char *sk, const unsigned char seed)
+{ // Fixed private key of 120 bits, within the range of every party of every set
+    unsigned int i;
+
+    for (i = 0; i < CRYPTO_SECRETKEYBYTES; i++)
+        sk[i] = (i < 15) ? (unsigned char)(seed + 37 * i) : 0;
+}
+
+int cryptotest_kat()
+{ // Known-answer test: an exchange with fixed private keys gives the shared secret recorded for the set,
+  // so that builds of other field backends or other architectures can be checked against this one
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES], sk_B[CRYPTO_SECRETKEYBYTES], sk_C[CRYPTO_SECRETKEYBYTES];
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_B[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_C[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_AC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_A[CRYPTO_BYTES] = {0};
+    unsigned char ss_B[CRYPTO_BYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0};
+    bool passed;
+
+    kat_key(sk_A, 0x11);
+    kat_key(sk_B, 0x22);
+    kat_key(sk_C, 0x33);
+    EphemeralKeyGeneration_A(sk_A, pk_A);
+    EphemeralKeyGeneration_B(sk_B, pk_B);
+    EphemeralKeyGeneration_C(sk_C, pk_C);
+    BSharedPublicFromA(sk_B, pk_A, sp_AB);
+    CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+    ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+    BSharedSecretFromA(sk_B, sp_AC, ss_B);
+    passed = (memcmp(ss_A, kat_shared_secret, CRYPTO_BYTES) == 0) && (memcmp(ss_B, kat_shared_secret, CRYPTO_BYTES) == 0) &&
+             (memcmp(ss_C, kat_shared_secret, CRYPTO_BYTES) == 0);
+
+    if (passed == true)
+        printf("  Known-answer tests ................................................. PASSED");
+    else
+    {
+        printf("  Known-answer tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+int cryptotest_workers()
+{ // Testing the parallel isogeny evaluations: the known-answer exchange run with 1 and 3 workers, using the strategies for
+  // 2 and 4 threads, gives the public values of the sequential run and the recorded shared secret
+    const unsigned int workers[2] = {1, 3};
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES], sk_B[CRYPTO_SECRETKEYBYTES], sk_C[CRYPTO_SECRETKEYBYTES];
+    unsigned char pk[2][3][CRYPTO_PUBLICKEYBYTES];
+    unsigned char sp[2][3][CRYPTO_SHAREDPUBLICBYTES];
+    unsigned char ss[3][CRYPTO_BYTES];
+    unsigned int i, k;
+    bool passed = true;
+
+    memset(pk, 0, sizeof(pk));
+    memset(sp, 0, sizeof(sp));
+    kat_key(sk_A, 0x11);
+    kat_key(sk_B, 0x22);
+    kat_key(sk_C, 0x33);
+    for (i = 0; i < 3; i++)
+    { // Run 0 is sequential, runs 1 and 2 use the workers
+        k = (i == 0) ? 0 : 1;
+        if (sigk_set_workers((i == 0) ? 0 : workers[i - 1]) != 0)
+        {
+            passed = false;
+            break;
+        }
+        EphemeralKeyGeneration_A(sk_A, pk[k][0]);
+        EphemeralKeyGeneration_B(sk_B, pk[k][1]);
+        EphemeralKeyGeneration_C(sk_C, pk[k][2]);
+        BSharedPublicFromA(sk_B, pk[k][0], sp[k][0]);
+        CSharedSecretFromB(sk_C, pk[k][1], sp[k][0], sp[k][1], ss[2]);
+        ASharedSecretFromC(sk_A, pk[k][2], sp[k][1], sp[k][2], ss[0]);
+        BSharedSecretFromA(sk_B, sp[k][2], ss[1]);
+        passed = passed && (memcmp(pk[k], pk[0], sizeof(pk[0])) == 0) && (memcmp(sp[k], sp[0], sizeof(sp[0])) == 0);
+        for (k = 0; k < 3; k++)
+        {
+            passed = passed && (memcmp(ss[k], kat_shared_secret, CRYPTO_BYTES) == 0);
+        }
+    }
+    passed = passed && (sigk_set_workers(SIGK_MAX_WORKERS + 1) != 0) && (sigk_set_workers(0) == 0);
+
+    if (passed == true)
+        printf("  Parallel evaluation tests .......................................... PASSED");
+    else
+    {
+        printf("  Parallel evaluation tests ... FAILED");
+        printf("\n");
+        sigk_set_workers(0);
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+int cryptotest_groupkey_steps()
+{ // Testing the resumable operations against the one-shot functions, with two operations interleaved on the same thread
+    unsigned int i, budget;
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_B[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0}, pk_A_s[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_B[CRYPTO_PUBLICKEYBYTES] = {0}, pk_B_s[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_C[CRYPTO_PUBLICKEYBYTES] = {0}, pk_C_s[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_AB_s[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_BC_s[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_AC[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_AC_s[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_A[CRYPTO_BYTES] = {0}, ss_A_s[CRYPTO_BYTES] = {0};
+    unsigned char ss_B[CRYPTO_BYTES] = {0}, ss_B_s[CRYPTO_BYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0}, ss_C_s[CRYPTO_BYTES] = {0};
+    sigk_op_t op1, op2;
+    int r1, r2;
+    bool passed = true;
+
+    for (i = 0; i < TEST_LOOPS; i++)
+    {
+        budget = i + 1;
+        random_mod_order_A(sk_A);
+        random_mod_order_B(sk_B);
+        random_mod_order_C(sk_C);
+
+        EphemeralKeyGeneration_A(sk_A, pk_A);
+        EphemeralKeyGeneration_B(sk_B, pk_B);
+        EphemeralKeyGeneration_C(sk_C, pk_C);
+        BSharedPublicFromA(sk_B, pk_A, sp_AB);
+        CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+        ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+        BSharedSecretFromA(sk_B, sp_AC, ss_B);
+
+        // Key generations of A and B interleaved, then C alone
+        sigk_start_EphemeralKeyGeneration_A(&op1, sk_A, pk_A_s);
+        sigk_start_EphemeralKeyGeneration_B(&op2, sk_B, pk_B_s);
+        do {
+            r1 = sigk_step(&op1, budget);
+            r2 = sigk_step(&op2, budget);
+        } while (r1 == SIGK_STEP_PENDING || r2 == SIGK_STEP_PENDING);
+        sigk_start_EphemeralKeyGeneration_C(&op1, sk_C, pk_C_s);
+        while (sigk_step(&op1, budget) == SIGK_STEP_PENDING);
+
+        // Key agreement, each pass interleaved with the next one of a second exchange running on the one-shot outputs
+        sigk_start_BSharedPublicFromA(&op1, sk_B, pk_A_s, sp_AB_s);
+        sigk_start_CSharedSecretFromB(&op2, sk_C, pk_B, sp_AB, sp_BC_s, ss_C_s);
+        do {
+            r1 = sigk_step(&op1, budget);
+            r2 = sigk_step(&op2, budget);
+        } while (r1 == SIGK_STEP_PENDING || r2 == SIGK_STEP_PENDING);
+        sigk_start_ASharedSecretFromC(&op1, sk_A, pk_C_s, sp_BC_s, sp_AC_s, ss_A_s);
+        sigk_start_BSharedSecretFromA(&op2, sk_B, sp_AC, ss_B_s);
+        do {
+            r1 = sigk_step(&op1, budget);
+            r2 = sigk_step(&op2, budget);
+        } while (r1 == SIGK_STEP_PENDING || r2 == SIGK_STEP_PENDING);
+
+        if (r1 != SIGK_STEP_DONE || r2 != SIGK_STEP_DONE ||
+            memcmp(pk_A, pk_A_s, CRYPTO_PUBLICKEYBYTES) || memcmp(pk_B, pk_B_s, CRYPTO_PUBLICKEYBYTES) || memcmp(pk_C, pk_C_s, CRYPTO_PUBLICKEYBYTES) ||
+            memcmp(sp_AB, sp_AB_s, CRYPTO_SHAREDPUBLICBYTES) || memcmp(sp_BC, sp_BC_s, CRYPTO_SHAREDPUBLICBYTES) || memcmp(sp_AC, sp_AC_s, CRYPTO_SHAREDPUBLICBYTES) ||
+            memcmp(ss_A, ss_A_s, CRYPTO_BYTES) || memcmp(ss_B, ss_B_s, CRYPTO_BYTES) || memcmp(ss_C, ss_C_s, CRYPTO_BYTES))
+        {
+            passed = false;
+        }
+    }
+
+    if (passed == true)
+        printf("  Resumable operation tests .......................................... PASSED");
+    else
+    {
+        printf("  Resumable operation tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+int cryptotest_groupkey_ws()
+{ // Testing the operations running in a caller-provided workspace against the one-shot functions
+    unsigned int i, op;
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_B[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0}, pk_A_w[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_B[CRYPTO_PUBLICKEYBYTES] = {0}, pk_B_w[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_C[CRYPTO_PUBLICKEYBYTES] = {0}, pk_C_w[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_AB_w[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_BC_w[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_AC[CRYPTO_SHAREDPUBLICBYTES] = {0}, sp_AC_w[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_A[CRYPTO_BYTES] = {0}, ss_A_w[CRYPTO_BYTES] = {0};
+    unsigned char ss_B[CRYPTO_BYTES] = {0}, ss_B_w[CRYPTO_BYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0}, ss_C_w[CRYPTO_BYTES] = {0};
+    unsigned char *ws;
+    size_t size = 0;
+    bool passed = true;
+
+    for (op = 0; op < SIGK_NUM_OPS; op++)
+    {
+        if (sigk_workspace_size(op) == 0 || sigk_workspace_size(op) % SIGK_WORKSPACE_ALIGN != 0)
+        {
+            passed = false;
+        }
+        if (sigk_workspace_size(op) > size)
+        {
+            size = sigk_workspace_size(op);
+        }
+    }
+    if (sigk_workspace_size(SIGK_NUM_OPS) != 0)
+    {
+        passed = false;
+    }
+    ws = aligned_alloc(SIGK_WORKSPACE_ALIGN, size);
+    if (ws == NULL)
+    {
+        passed = false;
+    }
+    else if (EphemeralKeyGeneration_A_ws(sk_A, pk_A_w, ws + 8) != 1 || EphemeralKeyGeneration_A_ws(sk_A, pk_A_w, NULL) != 1)
+    { // Misaligned or missing workspaces are rejected
+        passed = false;
+    }
+
+    for (i = 0; i < TEST_LOOPS && ws != NULL; i++)
+    {
+        random_mod_order_A(sk_A);
+        random_mod_order_B(sk_B);
+        random_mod_order_C(sk_C);
+
+        EphemeralKeyGeneration_A(sk_A, pk_A);
+        EphemeralKeyGeneration_B(sk_B, pk_B);
+        EphemeralKeyGeneration_C(sk_C, pk_C);
+        BSharedPublicFromA(sk_B, pk_A, sp_AB);
+        CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+        ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A);
+        BSharedSecretFromA(sk_B, sp_AC, ss_B);
+
+        // The same workspace is reused by every operation
+        if (EphemeralKeyGeneration_A_ws(sk_A, pk_A_w, ws) || EphemeralKeyGeneration_B_ws(sk_B, pk_B_w, ws) || EphemeralKeyGeneration_C_ws(sk_C, pk_C_w, ws) ||
+            BSharedPublicFromA_ws(sk_B, pk_A_w, sp_AB_w, ws) || CSharedSecretFromB_ws(sk_C, pk_B_w, sp_AB_w, sp_BC_w, ss_C_w, ws) ||
+            ASharedSecretFromC_ws(sk_A, pk_C_w, sp_BC_w, sp_AC_w, ss_A_w, ws) || BSharedSecretFromA_ws(sk_B, sp_AC_w, ss_B_w, ws))
+        {
+            passed = false;
+        }
+
+        if (memcmp(pk_A, pk_A_w, CRYPTO_PUBLICKEYBYTES) || memcmp(pk_B, pk_B_w, CRYPTO_PUBLICKEYBYTES) || memcmp(pk_C, pk_C_w, CRYPTO_PUBLICKEYBYTES) ||
+            memcmp(sp_AB, sp_AB_w, CRYPTO_SHAREDPUBLICBYTES) || memcmp(sp_BC, sp_BC_w, CRYPTO_SHAREDPUBLICBYTES) || memcmp(sp_AC, sp_AC_w, CRYPTO_SHAREDPUBLICBYTES) ||
+            memcmp(ss_A, ss_A_w, CRYPTO_BYTES) || memcmp(ss_B, ss_B_w, CRYPTO_BYTES) || memcmp(ss_C, ss_C_w, CRYPTO_BYTES))
+        {
+            passed = false;
+        }
+    }
+    free(ws);
+
+    if (passed == true)
+        printf("  Workspace operation tests .......................................... PASSED");
+    else
+    {
+        printf("  Workspace operation tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+#define MAX_TRACE_EVENTS 64
+
+typedef struct
+{
+    unsigned int count;
+    unsigned int op[MAX_TRACE_EVENTS], phase[MAX_TRACE_EVENTS], event[MAX_TRACE_EVENTS];
+    uint64_t time[MAX_TRACE_EVENTS];
+} trace_log;
+
+static void trace_record(void *ctx, unsigned int op, unsigned int phase, unsigned int event, uint64_t timestamp_ns)
+{ // Trace hook recording the events in a trace_log
+    trace_log *log = (trace_log *)ctx;
+
+    if (log->count < MAX_TRACE_EVENTS)
+    {
+        log->op[log->count] = op;
+        log->phase[log->count] = phase;
+        log->event[log->count] = event;
+        log->time[log->count] = timestamp_ns;
+    }
+    log->count += 1;
+}
+
+static bool trace_matches(const trace_log *log, const unsigned int op, const unsigned int *phases, const unsigned int nphases)
+{ // Check that the log holds the begin and end events of the given phases, in order and with increasing timestamps
+    unsigned int i;
+
+    if (log->count != 2 * nphases)
+    {
+        return false;
+    }
+    for (i = 0; i < log->count; i++)
+    {
+        if (log->op[i] != op || log->phase[i] != phases[i / 2] || log->event[i] != ((i % 2 == 0) ? SIGK_TRACE_BEGIN : SIGK_TRACE_END))
+        {
+            return false;
+        }
+        if (i > 0 && log->time[i] < log->time[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int cryptotest_trace()
+{ // Testing the phase trace hook
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_B[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_B[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0};
+    const unsigned int keygen_phases[] = {SIGK_PHASE_DECODE, SIGK_PHASE_LADDER, SIGK_PHASE_TRAVERSE, SIGK_PHASE_NORMALIZE, SIGK_PHASE_ENCODE};
+    const unsigned int shared_phases[] = {SIGK_PHASE_DECODE, SIGK_PHASE_GET_A, SIGK_PHASE_LADDER, SIGK_PHASE_TRAVERSE, SIGK_PHASE_NORMALIZE, SIGK_PHASE_ENCODE,
+                                          SIGK_PHASE_DECODE, SIGK_PHASE_GET_A, SIGK_PHASE_LADDER, SIGK_PHASE_TRAVERSE, SIGK_PHASE_J_INV, SIGK_PHASE_ENCODE};
+    trace_log log;
+    bool passed = true;
+
+    random_mod_order_A(sk_A);
+    random_mod_order_B(sk_B);
+    random_mod_order_C(sk_C);
+
+    log.count = 0;
+    sigk_set_trace_hook(trace_record, &log);
+    EphemeralKeyGeneration_A(sk_A, pk_A);
+    sigk_set_trace_hook(NULL, NULL);
+    if (!trace_matches(&log, SIGK_OP_KEYGEN_A, keygen_phases, sizeof(keygen_phases) / sizeof(keygen_phases[0])))
+    {
+        passed = false;
+    }
+
+    EphemeralKeyGeneration_B(sk_B, pk_B);
+    BSharedPublicFromA(sk_B, pk_A, sp_AB);
+
+    log.count = 0;
+    sigk_set_trace_hook(trace_record, &log);
+    CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C);
+    sigk_set_trace_hook(NULL, NULL);
+    if (!trace_matches(&log, SIGK_OP_C_SHARED_SECRET_FROM_B, shared_phases, sizeof(shared_phases) / sizeof(shared_phases[0])))
+    {
+        passed = false;
+    }
+
+    log.count = 0;
+    EphemeralKeyGeneration_A(sk_A, pk_A); // No events once the hook is cleared
+    if (log.count != 0)
+    {
+        passed = false;
+    }
+
+    if (passed == true)
+        printf("  Phase trace tests .................................................. PASSED");
+    else
+    {
+        printf("  Phase trace tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+static void opcount_diff(const sigk_opcount_t *before, const sigk_opcount_t *after, sigk_opcount_t *diff)
+{ // Counts of the operations made between two snapshots
+    unsigned int i;
+
+    for (i = 0; i < sizeof(sigk_opcount_t) / sizeof(uint64_t); i++)
+    {
+        ((uint64_t *)diff)[i] = ((const uint64_t *)after)[i] - ((const uint64_t *)before)[i];
+    }
+}
+
+int cryptotest_params()
+{ // Testing the registry of parameter sets: the descriptor of the set tested here lists its sizes and functions
+    const sigk_params_t *p = sigk_params_get(SCHEME_NAME);
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned int i;
+    bool passed = true;
+
+    if (p == NULL || strcmp(p->name, SCHEME_NAME) != 0 || p->secretkey_bytes != CRYPTO_SECRETKEYBYTES || p->publickey_bytes != CRYPTO_PUBLICKEYBYTES ||
+        p->sharedpublic_bytes != CRYPTO_SHAREDPUBLICBYTES || p->bytes != CRYPTO_BYTES)
+    {
+        passed = false;
+    }
+    else if (p->keygen_A != EphemeralKeyGeneration_A || p->B_shared_secret_from_A != BSharedSecretFromA || p->step != sigk_step ||
+             p->workspace_size != sigk_workspace_size || p->B_shared_secret_from_A_ws != BSharedSecretFromA_ws)
+    {
+        passed = false;
+    }
+    else
+    { // Same public key through the descriptor
+        p->random_A(sk_A);
+        passed = (p->keygen_A(sk_A, pk) == 0) && (EphemeralKeyGeneration_A(sk_A, pk_A) == 0) && (memcmp(pk, pk_A, CRYPTO_PUBLICKEYBYTES) == 0);
+    }
+    for (i = 0; sigk_params_at(i) != NULL; i++)
+    { // The registry starts with the default set and every set can be found by name
+        if (sigk_params_get(sigk_params_at(i)->name) != sigk_params_at(i))
+            passed = false;
+    }
+    if (i < 2 || strcmp(sigk_params_at(0)->name, "SIGKp747") != 0 || sigk_params_get("SIGKp0") != NULL || sigk_params_get(NULL) != NULL)
+        passed = false;
+
+    if (passed == true)
+        printf("  Parameter registry tests ........................................... PASSED");
+    else
+    {
+        printf("  Parameter registry tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+int cryptotest_frames()
+{ // Testing the message framing: an exchange run on framed messages, the gather lists of the keys and the refusal of malformed messages
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_B[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char m1[SIGK_PASS1_BYTES], m2[SIGK_PASS2_BYTES], m3[SIGK_PASS3_BYTES], m4[SIGK_PASS4_BYTES], bad[SIGK_PASS2_BYTES];
+    unsigned char ss_A[CRYPTO_BYTES] = {0};
+    unsigned char ss_B[CRYPTO_BYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0};
+    unsigned char *pk_out, *sp_out;
+    const unsigned char *pk_A, *pk_B, *pk_C, *sp_AB, *sp_BC, *sp_AC, *pk, *sp;
+    const sigk_params_t *p;
+    unsigned int i;
+    bool passed = true;
+
+    if (sigk_frame_bytes(1) != SIGK_PASS1_BYTES || sigk_frame_bytes(2) != SIGK_PASS2_BYTES || sigk_frame_bytes(3) != SIGK_PASS3_BYTES ||
+        sigk_frame_bytes(4) != SIGK_PASS4_BYTES || sigk_frame_bytes(0) != 0 || sigk_frame_bytes(SIGK_NUM_PASSES + 1) != 0)
+    {
+        passed = false;
+    }
+    // Operations write their outputs into the messages, which are parsed in place. Uninitialized padding must not reach the messages.
+    memset(m1, 0xAA, sizeof(m1));
+    memset(m2, 0xAA, sizeof(m2));
+    memset(m3, 0xAA, sizeof(m3));
+    memset(m4, 0xAA, sizeof(m4));
+    random_mod_order_A(sk_A);
+    random_mod_order_B(sk_B);
+    random_mod_order_C(sk_C);
+
+    passed &= (sigk_frame_init(1, m1, &pk_out, &sp_out) == 0) && (sp_out == NULL) && (EphemeralKeyGeneration_A(sk_A, pk_out) == 0);
+    passed &= (sigk_frame_parse(1, m1, sizeof(m1), &pk_A, NULL) == 0) && (pk_A == m1 + SIGK_FRAME_HEADER_BYTES);
+    passed &= (sigk_frame_init(2, m2, &pk_out, &sp_out) == 0) && (EphemeralKeyGeneration_B(sk_B, pk_out) == 0) && (BSharedPublicFromA(sk_B, pk_A, sp_out) == 0);
+    passed &= (sigk_frame_parse(2, m2, sizeof(m2), &pk_B, &sp_AB) == 0);
+    passed &= (sigk_frame_init(3, m3, &pk_out, &sp_out) == 0) && (EphemeralKeyGeneration_C(sk_C, pk_out) == 0) && (CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_out, ss_C) == 0);
+    passed &= (sigk_frame_parse(3, m3, sizeof(m3), &pk_C, &sp_BC) == 0);
+    passed &= (sigk_frame_init(4, m4, &pk_out, &sp_out) == 0) && (pk_out == NULL) && (ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_out, ss_A) == 0);
+    passed &= (sigk_frame_parse(4, m4, sizeof(m4), &pk, &sp_AC) == 0) && (pk == NULL) && (BSharedSecretFromA(sk_B, sp_AC, ss_B) == 0);
+    if (passed && (memcmp(ss_A, ss_B, CRYPTO_BYTES) != 0 || memcmp(ss_A, ss_C, CRYPTO_BYTES) != 0))
+    {
+        passed = false;
+    }
+
+    // Malformed messages are refused and yield no keys
+    passed &= (sigk_frame_parse(3, m2, sizeof(m2), &pk, &sp) != 0) && (pk == NULL) && (sp == NULL);
+    passed &= (sigk_frame_parse(2, m2, sizeof(m2) - 1, &pk, &sp) != 0) && (sigk_frame_parse(0, m2, sizeof(m2), &pk, &sp) != 0);
+    for (i = 0; i < SIGK_FRAME_HEADER_BYTES; i++)
+    { // Any change of the header
+        memcpy(bad, m2, sizeof(m2));
+        bad[i] ^= 0x01;
+        passed &= (sigk_frame_parse(2, bad, sizeof(bad), &pk, &sp) != 0);
+    }
+    memcpy(bad, m2, sizeof(m2));
+    memset(bad + SIGK_FRAME_HEADER_BYTES, 0xFF, CRYPTO_PUBLICKEYBYTES / 12);     // First half of the first element, 6 elements of 2 halves, above p
+    passed &= (sigk_frame_parse(2, bad, sizeof(bad), &pk, &sp) != 0);
+    memcpy(bad, m2, sizeof(m2));
+    bad[sizeof(bad) - 1] = 0xFF;                                                // Top byte of the last element above p, or non-zero padding
+    passed &= (sigk_frame_parse(2, bad, sizeof(bad), &pk, &sp) != 0);
+    for (i = 0; (p = sigk_params_at(i)) != NULL; i++)
+    { // Messages of this set are refused by the other sets
+        if (strcmp(p->name, SCHEME_NAME) != 0 && p->frame_parse(2, m2, sizeof(m2), &pk, &sp) == 0)
+            passed = false;
+    }
+
+#if !defined(__WINDOWS__)
+    { // Gather lists of the keys kept in separate buffers give the same messages
+        unsigned char header[SIGK_FRAME_HEADER_BYTES], pk_buf[CRYPTO_PUBLICKEYBYTES], sp_buf[CRYPTO_SHAREDPUBLICBYTES], flat[SIGK_PASS2_BYTES];
+        struct iovec iov[SIGK_FRAME_MAX_IOV];
+        size_t len = 0;
+        int n, j;
+
+        memset(pk_buf, 0xAA, sizeof(pk_buf));
+        memset(sp_buf, 0xAA, sizeof(sp_buf));
+        EphemeralKeyGeneration_B(sk_B, pk_buf);
+        BSharedPublicFromA(sk_B, pk_A, sp_buf);
+        n = sigk_frame_iov(2, header, pk_buf, sp_buf, iov);
+        for (j = 0; j < n; j++)
+        {
+            memcpy(flat + len, iov[j].iov_base, iov[j].iov_len);
+            len += iov[j].iov_len;
+        }
+        passed &= (n == 3) && (len == sizeof(m2)) && (memcmp(flat, m2, sizeof(m2)) == 0);
+        passed &= (sigk_frame_parse_iov(2, iov, n, &pk, &sp) == 0) && (pk == pk_buf) && (sp == sp_buf);
+        passed &= (sigk_frame_parse_iov(2, iov, n - 1, &pk, &sp) != 0) && (sigk_frame_parse_iov(3, iov, n, &pk, &sp) != 0);
+        passed &= (sigk_frame_iov(1, header, pk_buf, NULL, iov) == 2) && (sigk_frame_iov(4, header, NULL, sp_buf, iov) == 2);
+        passed &= (sigk_frame_iov(2, header, NULL, sp_buf, iov) == 0) && (sigk_frame_iov(5, header, pk_buf, sp_buf, iov) == 0);
+    }
+#endif
+
+    if (passed == true)
+        printf("  Message framing tests .............................................. PASSED");
+    else
+    {
+        printf("  Message framing tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n");
+
+    return PASSED;
+}
+
+int cryptotest_opcount()
+{ // Testing the operation counters: repeated runs of a protocol function make the same calls. Prints the counts of each function.
+    unsigned int i, op;
+    unsigned char sk_A[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_B[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char sk_C[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk_A[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_B[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char pk_C[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sp_AB[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_BC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char sp_AC[CRYPTO_SHAREDPUBLICBYTES] = {0};
+    unsigned char ss_A[CRYPTO_BYTES] = {0};
+    unsigned char ss_B[CRYPTO_BYTES] = {0};
+    unsigned char ss_C[CRYPTO_BYTES] = {0};
+    const char *names[SIGK_NUM_OPS] = {"Key generation A", "Key generation B", "Key generation C", "B sharedPublic from A",
+                                       "C sharedSecret from B", "A sharedSecret from C", "B sharedSecret from A"};
+    sigk_opcount_t c0, c1, counts[2][SIGK_NUM_OPS];
+    bool passed = true;
+
+    if (sigk_opcount_snapshot(&c0) != 0)
+    { // Library built without SIGK_COUNT_OPS
+        return PASSED;
+    }
+
+    random_mod_order_A(sk_A);
+    random_mod_order_B(sk_B);
+    random_mod_order_C(sk_C);
+    for (i = 0; i < 2; i++)
+    {
+        for (op = 0; op < SIGK_NUM_OPS; op++)
+        {
+            sigk_opcount_snapshot(&c0);
+            switch (op)
+            {
+            case SIGK_OP_KEYGEN_A: EphemeralKeyGeneration_A(sk_A, pk_A); break;
+            case SIGK_OP_KEYGEN_B: EphemeralKeyGeneration_B(sk_B, pk_B); break;
+            case SIGK_OP_KEYGEN_C: EphemeralKeyGeneration_C(sk_C, pk_C); break;
+            case SIGK_OP_B_SHARED_PUBLIC_FROM_A: BSharedPublicFromA(sk_B, pk_A, sp_AB); break;
+            case SIGK_OP_C_SHARED_SECRET_FROM_B: CSharedSecretFromB(sk_C, pk_B, sp_AB, sp_BC, ss_C); break;
+            case SIGK_OP_A_SHARED_SECRET_FROM_C: ASharedSecretFromC(sk_A, pk_C, sp_BC, sp_AC, ss_A); break;
+            case SIGK_OP_B_SHARED_SECRET_FROM_A: BSharedSecretFromA(sk_B, sp_AC, ss_B); break;
+            }
+            sigk_opcount_snapshot(&c1);
+            opcount_diff(&c0, &c1, &counts[i][op]);
+        }
+    }
+    for (op = 0; op < SIGK_NUM_OPS; op++)
+    {
+        if (memcmp(&counts[0][op], &counts[1][op], sizeof(sigk_opcount_t)) != 0 || counts[0][op].mp_mul == 0)
+        {
+            passed = false;
+        }
+    }
+
+    if (passed == true)
+        printf("  Operation counter tests ............................................ PASSED");
+    else
+    {
+        printf("  Operation counter tests ... FAILED");
+        printf("\n");
+        return FAILED;
+    }
+    printf("\n\n");
+
+    printf("  %-22s %9s %9s %9s %9s %9s %7s %7s %7s %7s %7s\n", "", "mp_mul", "rdc_mont", "fp2mul", "fp2sqr", "fpadd", "fpinv", "xDBL", "xTPL", "xQNTPL", "eval");
+    for (op = 0; op < SIGK_NUM_OPS; op++)
+    {
+        sigk_opcount_t *c = &counts[0][op];
+        printf("  %-22s %9llu %9llu %9llu %9llu %9llu %7llu %7llu %7llu %7llu %7llu\n", names[op],
+               (unsigned long long)c->mp_mul, (unsigned long long)c->rdc_mont, (unsigned long long)c->fp2mul, (unsigned long long)c->fp2sqr,
+               (unsigned long long)c->fpadd, (unsigned long long)c->fpinv, (unsigned long long)c->xDBL, (unsigned long long)c->xTPL,
+               (unsigned long long)c->xQNTPL, (unsigned long long)(c->eval_3_isog + c->eval_4_isog + c->eval_5_isog));
+    }
+
+    return PASSED;
+}
+
 int cryptorun_groupkey()
 { // Benchmarking group key exchange
     unsigned int n;
@@ -187,6 +797,62 @@ int main()
         //return FAILED;
     }
 
+    Status = cryptotest_kat(); // Test against the recorded shared secret
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_KAT \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_workers(); // Test parallel isogeny evaluations
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_WORKERS \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_groupkey_steps(); // Test resumable group key operations
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_RESUMABLE \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_groupkey_ws(); // Test group key operations with a caller-provided workspace
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_WORKSPACE \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_trace(); // Test phase trace hook
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_TRACE \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_params(); // Test registry of parameter sets
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_PARAMS \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_frames(); // Test message framing of the four passes
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_FRAMES \n\n");
+        return FAILED;
+    }
+
+    Status = cryptotest_opcount(); // Test operation counters, only run when the library counts them
+    if (Status != PASSED)
+    {
+        printf("\n\n   Error detected: GROUPKEY_ERROR_OPCOUNT \n\n");
+        return FAILED;
+    }
+
     Status = cryptorun_groupkey(); // Benchmark group key agreement
     if (Status != PASSED)
     {
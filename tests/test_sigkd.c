@@ -0,0 +1,225 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: testing the sigkd daemon and its client library
+* Starts the daemon given on the command line on a private socket, runs a group key exchange of every
+* parameter set through three clients with several requests in flight, checks the results against the
+* library, checks that malformed requests are refused, then stops the daemon. A fourth client floods the daemon
+* with requests and never reads the results, the other clients must still be served.
+*
+* Usage: test_sigkd path/to/sigkd
+*********************************************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../sigkd.h"
+#include "test_extras.h"
+
+#define BUFFER_BYTES 16384
+
+// Layout of the shared buffer of a client: the data of one party
+#define OFF_SK 0
+#define OFF_PK 64
+#define OFF_PEER_PK 2048
+#define OFF_SP_IN 4096
+#define OFF_SP_OUT 5120
+#define OFF_SS 6144
+
+static sigkd_client_t *connect_retry(const char *path)
+{ // The daemon may not be listening yet
+    sigkd_client_t *c = NULL;
+    struct timespec pause = {0, 20000000};
+    unsigned int i;
+
+    for (i = 0; i < 250 && c == NULL; i++)
+    {
+        c = sigkd_connect(path, BUFFER_BYTES);
+        if (c == NULL)
+            nanosleep(&pause, NULL);
+    }
+    return c;
+}
+
+static sigkd_request_t request(const uint32_t id, const uint32_t op, const uint32_t set)
+{ // Request on the layout above, private keys are generated in place
+    sigkd_request_t r = {id, op, set, OFF_SK, OFF_PEER_PK, OFF_SP_IN, OFF_PK, OFF_SS};
+
+    if (op >= SIGK_NUM_OPS)
+        r.out0 = OFF_SK;
+    return r;
+}
+
+static int submit(sigkd_client_t *c, const uint32_t id, const uint32_t op, const uint32_t set)
+{
+    sigkd_request_t r = request(id, op, set);
+
+    return sigkd_submit(c, &r);
+}
+
+static int wait_all(sigkd_client_t **c, const unsigned int n)
+{ // Wait for one result on each of n clients, returns 0 if all succeeded
+    sigkd_response_t resp;
+    unsigned int i;
+    int status = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (sigkd_wait(c[i], &resp) != 0 || resp.status != SIGKD_OK)
+            status = 1;
+    }
+    return status;
+}
+
+static int exchange(sigkd_client_t *cA, sigkd_client_t *cB, sigkd_client_t *cC, const unsigned int set)
+{ // Group key exchange of one set with the three parties on three buffers, the requests of the parties are in flight together
+    const sigk_params_t *p = sigk_params_at(set);
+    sigkd_client_t *all[3] = {cA, cB, cC};
+    unsigned char *a = sigkd_buffer(cA), *b = sigkd_buffer(cB), *c = sigkd_buffer(cC);
+    unsigned char pk[2048] = {0};
+    sigkd_request_t r;
+    int status = 0;
+
+    status |= submit(cA, 1, SIGKD_OP_RANDOM_A, set) | submit(cB, 1, SIGKD_OP_RANDOM_B, set) | submit(cC, 1, SIGKD_OP_RANDOM_C, set);
+    status |= wait_all(all, 3);
+    status |= submit(cA, 2, SIGK_OP_KEYGEN_A, set) | submit(cB, 2, SIGK_OP_KEYGEN_B, set) | submit(cC, 2, SIGK_OP_KEYGEN_C, set);
+    status |= wait_all(all, 3);
+
+    // The daemon computes the same public key as the library
+    p->keygen_B(b + OFF_SK, pk);
+    status |= (memcmp(pk, b + OFF_PK, p->publickey_bytes) != 0);
+
+    // Pass 1 and 2: B computes SharedPublicAB, then C its SharedPublicBC and the secret
+    memcpy(b + OFF_PEER_PK, a + OFF_PK, p->publickey_bytes);
+    r = request(3, SIGK_OP_B_SHARED_PUBLIC_FROM_A, set);
+    r.out0 = OFF_SP_OUT;
+    status |= (sigkd_call(cB, &r) != SIGKD_OK);
+    memcpy(c + OFF_PEER_PK, b + OFF_PK, p->publickey_bytes);
+    memcpy(c + OFF_SP_IN, b + OFF_SP_OUT, p->sharedpublic_bytes);
+    r = request(4, SIGK_OP_C_SHARED_SECRET_FROM_B, set);
+    r.out0 = OFF_SP_OUT;
+    status |= (sigkd_call(cC, &r) != SIGKD_OK);
+    // Pass 3 and 4: A computes SharedPublicAC and the secret, then B the secret
+    memcpy(a + OFF_PEER_PK, c + OFF_PK, p->publickey_bytes);
+    memcpy(a + OFF_SP_IN, c + OFF_SP_OUT, p->sharedpublic_bytes);
+    r = request(5, SIGK_OP_A_SHARED_SECRET_FROM_C, set);
+    r.out0 = OFF_SP_OUT;
+    status |= (sigkd_call(cA, &r) != SIGKD_OK);
+    memcpy(b + OFF_SP_IN, a + OFF_SP_OUT, p->sharedpublic_bytes);
+    r = request(6, SIGK_OP_B_SHARED_SECRET_FROM_A, set);
+    r.in0 = OFF_SP_IN;
+    r.out0 = OFF_SS;
+    status |= (sigkd_call(cB, &r) != SIGKD_OK);
+
+    status |= (memcmp(a + OFF_SS, b + OFF_SS, p->bytes) != 0) || (memcmp(a + OFF_SS, c + OFF_SS, p->bytes) != 0);
+    return status;
+}
+
+static int refused(sigkd_client_t *c)
+{ // Requests with an unknown operation or set, or arguments past the buffer, are answered SIGKD_INVALID
+    sigkd_request_t r = request(7, SIGKD_NUM_OPS, 0);
+    int status = 0;
+
+    status |= (sigkd_call(c, &r) != SIGKD_INVALID);
+    r = request(8, SIGK_OP_KEYGEN_A, 1000);
+    status |= (sigkd_call(c, &r) != SIGKD_INVALID);
+    r = request(9, SIGK_OP_KEYGEN_A, 0);
+    r.out0 = BUFFER_BYTES - 1;
+    status |= (sigkd_call(c, &r) != SIGKD_INVALID);
+    r.out0 = 0xFFFFFFF0;
+    status |= (sigkd_call(c, &r) != SIGKD_INVALID);
+    return status;
+}
+
+static pid_t flood(const char *path)
+{ // Process sending malformed requests without reading the results, until the daemon stops reading them
+    sigkd_request_t r = request(10, SIGKD_NUM_OPS, 0);
+    sigkd_client_t *c;
+    pid_t pid = fork();
+
+    if (pid != 0)
+        return pid;
+    c = connect_retry(path);
+    while (c != NULL && sigkd_submit(c, &r) == 0)
+    {
+    }
+    pause();
+    _exit(0);
+}
+
+int main(int argc, char **argv)
+{
+    char path[64];
+    sigkd_client_t *c[3] = {NULL, NULL, NULL};
+    unsigned int set, i;
+    struct timespec settle = {0, 200000000};
+    int status = 0, wstatus;
+    pid_t pid, flooder;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s path/to/sigkd\n", argv[0]);
+        return FAILED;
+    }
+    snprintf(path, sizeof(path), "/tmp/sigkd_test_%d.sock", (int)getpid());
+    pid = fork();
+    if (pid == 0)
+    {
+        execl(argv[1], argv[1], "-s", path, "-w", "3", (char *)NULL);
+        _exit(127);
+    }
+    if (pid < 0)
+        return FAILED;
+
+    printf("\n\nTESTING THE SIGKD KEY AGREEMENT DAEMON\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (i = 0; i < 3; i++)
+    {
+        c[i] = connect_retry(path);
+        status |= (c[i] == NULL);
+    }
+    flooder = flood(path);
+    if (flooder < 0)
+        status = 1;
+    nanosleep(&settle, NULL);
+    for (set = 0; status == 0 && sigk_params_at(set) != NULL; set++)
+    {
+        if (exchange(c[0], c[1], c[2], set) != 0)
+        {
+            printf("  %s exchange through sigkd ... FAILED\n", sigk_params_at(set)->name);
+            status = 1;
+        }
+        else
+            printf("  %s exchange through sigkd ...................................... PASSED\n", sigk_params_at(set)->name);
+    }
+    if (status == 0)
+    {
+        status = refused(c[0]);
+        printf("  Malformed request tests %s\n", (status == 0) ? "............................................ PASSED" : "... FAILED");
+    }
+    for (i = 0; i < 3; i++)
+    {
+        sigkd_close(c[i]);
+    }
+
+    // The daemon stops with the flooding client still connected
+    kill(pid, SIGTERM);
+    if (waitpid(pid, &wstatus, 0) != pid || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+    {
+        printf("  sigkd did not exit cleanly\n");
+        status = 1;
+    }
+    if (flooder > 0)
+    {
+        kill(flooder, SIGKILL);
+        waitpid(flooder, NULL, 0);
+    }
+    printf("\n");
+    return (status == 0) ? PASSED : FAILED;
+}
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+#####################################################################################################
+#   Supersingular Isogeny Group-Key Agreement Library
+#
+#   Abstract: static probe check
+#   Lists the USDT probes of the "sigk" provider recorded in the ELF notes of a library or binary
+#   (using readelf) and checks that every function declared in the given API headers (api.h and the headers
+#   of the other parameter sets) has an entry and a return probe, and that the phase boundaries are probed.
+#
+#   Usage: check_probes.py library api.h [P376_api.h ...]
+#####################################################################################################
+
+import re
+import subprocess
+import sys
+
+PROVIDER = 'sigk'
+PROTOTYPE = re.compile(r'^(?:int|void|size_t|const\s+sigk_params_t)\s*\**\s*(\w+)\s*\(', re.M)
+NOTE = re.compile(r'Provider: (\S+)\s+Name: (\S+)\s+Location: (\S+)[^\n]*\s+Arguments: ?([^\n]*)')
+
+
+def probes(binary):
+    notes = subprocess.run(['readelf', '-n', binary], check=True, capture_output=True, text=True).stdout
+    found = {}
+    for provider, name, location, args in NOTE.findall(notes):
+        if provider == PROVIDER:
+            found.setdefault(name, []).append((location.rstrip(','), args.strip()))
+    return found
+
+
+def expected(headers):
+    names = []
+    for header in headers:
+        with open(header) as f:
+            names += PROTOTYPE.findall(f.read())
+    return [n + suffix for n in names for suffix in ('__entry', '__return')] + ['phase']
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write('usage: check_probes.py library api.h [P376_api.h ...]\n')
+        return 1
+
+    found = probes(argv[0])
+    wanted = expected(argv[1:])
+
+    print('%-52s %6s  %s' % ('probe', 'sites', 'arguments'))
+    for name in sorted(found):
+        print('%-52s %6d  %s' % (PROVIDER + ':' + name, len(found[name]), found[name][0][1]))
+    missing = [n for n in wanted if n not in found]
+    print('')
+    if missing:
+        print('missing probes: ' + ', '.join(missing))
+        return 1
+    print('%d probes, all API functions and phase boundaries are covered' % len(found))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+#####################################################################################################
+#   Supersingular Isogeny Group-Key Agreement Library
+#
+#   Abstract: generator of the unrolled field multiplication of a parameter set
+#   For a prime p = 2^eA * 3^eB * 5^eC * f - 1, prints generic/fp_p<bits>_unrolled.c: mp_mul() and
+#   rdc_mont() as straight-line product scanning code on 64-bit words, with a separate squaring.
+#   The words of p+1 are literals of the reduction. The products by its zero words are left out
+#   and the products by a power of two become additions of shifted words, so that the code only
+#   contains the multiplications by the other words.
+#
+#   Usage: gen_fp_unrolled.py eA eB eC f > generic/fp_p<bits>_unrolled.c
+#####################################################################################################
+
+import argparse
+import sys
+
+RADIX = 64
+MASK = 2**RADIX - 1
+
+
+def words(x, n):
+    return [(x >> (RADIX * i)) & MASK for i in range(n)]
+
+
+def gen_mul(n):
+    body = ['static __inline void mul_unrolled(const digit_t* a, const digit_t* b, digit_t* c)',
+            '{ // c = a*b, where lng(a) = lng(b) = NWORDS_FIELD',
+            '    const digit_t %s;' % ', '.join('a%d = a[%d]' % (i, i) for i in range(n)),
+            '    const digit_t %s;' % ', '.join('b%d = b[%d]' % (i, i) for i in range(n)),
+            '    uint128_t acc = 0, uv;',
+            '    digit_t t = 0;',
+            '']
+    for k in range(2 * n - 1):
+        for i in range(max(0, k - n + 1), min(k, n - 1) + 1):
+            body.append('    MULACC(a%d, b%d);' % (i, k - i))
+        body.append('    COLUMN(c[%d]);' % k)
+    body.append('    c[%d] = (digit_t)acc;' % (2 * n - 1))
+    body.append('}')
+    return body
+
+
+def gen_sqr(n):
+    body = ['static __inline void sqr_unrolled(const digit_t* a, digit_t* c)',
+            '{ // c = a^2, where lng(a) = NWORDS_FIELD. The products a[i]*a[j], i < j, are summed once and doubled',
+            '    const digit_t %s;' % ', '.join('a%d = a[%d]' % (i, i) for i in range(n)),
+            '    uint128_t acc = 0, uv, s;',
+            '    digit_t t = 0, st;',
+            '']
+    for k in range(2 * n - 1):
+        pairs = [(i, k - i) for i in range(max(0, k - n + 1), min(k, n - 1) + 1) if i < k - i]
+        if pairs:
+            body.append('    s = 0; st = 0;')
+            for i, j in pairs:
+                body.append('    SQRACC(a%d, a%d);' % (i, j))
+            body.append('    DOUBLEACC();')
+        if k % 2 == 0:
+            body.append('    MULACC(a%d, a%d);' % (k // 2, k // 2))
+        body.append('    COLUMN(c[%d]);' % k)
+    body.append('    c[%d] = (digit_t)acc;' % (2 * n - 1))
+    body.append('}')
+    return body
+
+
+def gen_rdc(n, p1):
+    # Product scanning Montgomery reduction. Since p = -1 mod 2^64, the quotient word of column i is the
+    # low word of the column, and adding q*(p+1) - q clears it.
+    body = ['void rdc_mont(const digit_t* ma, digit_t* mc)',
+            '{ // Montgomery reduction exploiting the special form of the prime, mc = ma*R^-1 mod 2p, where R = 2^%d.' % (RADIX * n),
+            '  // If ma < 2^%d*p, the output mc is in the range [0, 2*p-1].' % (RADIX * n),
+            '    digit_t %s;' % ', '.join('q%d' % i for i in range(n)),
+            '    uint128_t acc = 0, uv;',
+            '    digit_t t = 0;',
+            '',
+            '    COUNT_OP(rdc_mont);',
+            '']
+
+    def products(k, lo, hi):
+        for j in range(lo, hi + 1):
+            w = p1[k - j]
+            if w == 0:
+                continue
+            if w == 1:
+                body.append('    ADDACC(q%d);' % j)
+            elif w & (w - 1) == 0:
+                body.append('    SHLACC(q%d, %d);' % (j, w.bit_length() - 1))
+            else:
+                body.append('    MULACC(q%d, 0x%016X);' % (j, w))
+
+    for k in range(n):
+        products(k, 0, k - 1)
+        body.append('    ADDACC(ma[%d]);' % k)
+        body.append('    COLUMN(q%d);' % k)
+    for k in range(n, 2 * n - 1):
+        products(k, k - n + 1, n - 1)
+        body.append('    ADDACC(ma[%d]);' % k)
+        body.append('    COLUMN(mc[%d]);' % (k - n))
+    body.append('    mc[%d] = (digit_t)acc + ma[%d];' % (n - 1, 2 * n - 1))
+    body.append('}')
+    return body
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Unrolled field multiplication of a SIGK parameter set')
+    parser.add_argument('eA', type=int)
+    parser.add_argument('eB', type=int)
+    parser.add_argument('eC', type=int)
+    parser.add_argument('f', type=int)
+    args = parser.parse_args(argv)
+
+    eA, eB, eC = args.eA, args.eB, args.eC
+    p = 2**eA * 3**eB * 5**eC * args.f - 1
+    if eA < RADIX:
+        sys.stderr.write('p = 2^%d*3^%d*5^%d*%d - 1 is not -1 mod 2^%d\n' % (eA, eB, eC, args.f, RADIX))
+        return 1
+    nbits = p.bit_length()
+    n = (nbits + RADIX - 1) // RADIX
+    p1 = words(p + 1, n)
+    lines = ['/********************************************************************************************',
+             '* Supersingular Isogeny Group Key Agreement Library',
+             '*',
+             '* Abstract: unrolled modular multiplication for P%d' % nbits,
+             '* Generated by tools/gen_fp_unrolled.py %d %d %d %d, do not edit.' % (eA, eB, eC, args.f),
+             '* Straight-line product scanning multiplication, squaring and Montgomery reduction on 64-bit words, with',
+             '* the words of p%d+1 as literals. The other field functions are those of the portable implementation.' % nbits,
+             '* Included by P%d.c in _UNROLLED_ builds.' % nbits,
+             '*********************************************************************************************/',
+             '',
+             '#define SIGK_FP_MUL_RDC',
+             '#include "fp_generic.c"',
+             '',
+             '#if !defined(UINT128_SUPPORT) || (RADIX != 64) || (NWORDS_FIELD != %d)' % n,
+             '#error -- "The unrolled backend of P%d requires 64-bit digits and 128-bit integers"' % nbits,
+             '#endif',
+             '',
+             '// Accumulator of a column: the 192-bit value t:acc',
+             '#define MULACC(x, y) { uv = (uint128_t)(x) * (y); acc += uv; t += (acc < uv); }',
+             '#define ADDACC(x) { acc += (x); t += (acc < (x)); }',
+             '#define SHLACC(x, n) { uv = (uint128_t)(x) << (n); acc += uv; t += (acc < uv); }',
+             '// Store the low word of the column and shift the accumulator to the next column',
+             '#define COLUMN(out) { (out) = (digit_t)acc; acc = (acc >> 64) | ((uint128_t)t << 64); t = 0; }',
+             '// Products of a squaring summed in st:s, then doubled into the accumulator',
+             '#define SQRACC(x, y) { uv = (uint128_t)(x) * (y); s += uv; st += (s < uv); }',
+             '#define DOUBLEACC() { st = (st << 1) | (digit_t)(s >> 127); s <<= 1; acc += s; t += st + (acc < s); }',
+             '',
+             '']
+    lines += gen_mul(n) + ['', ''] + gen_sqr(n) + ['', '']
+    lines += ['void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)',
+              '{ // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords = NWORDS_FIELD',
+              '    UNREFERENCED_PARAMETER(nwords);',
+              '    COUNT_OP(mp_mul);',
+              '',
+              '    if (a == b) {',
+              '        sqr_unrolled(a, c);',
+              '    } else {',
+              '        mul_unrolled(a, b, c);',
+              '    }',
+              '}',
+              '',
+              '']
+    lines += gen_rdc(n, p1)
+    lines += ['',
+              '#undef MULACC',
+              '#undef ADDACC',
+              '#undef SHLACC',
+              '#undef COLUMN',
+              '#undef SQRACC',
+              '#undef DOUBLEACC']
+    sys.stdout.write('\n'.join(lines) + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
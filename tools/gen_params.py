@@ -0,0 +1,360 @@
+#!/usr/bin/env python3
+#####################################################################################################
+#   Supersingular Isogeny Group-Key Agreement Library
+#
+#   Abstract: parameter set generator
+#   For a prime p = 2^eA * 3^eB * 5^eC * f - 1, prints the constants of a parameter set in the format
+#   of P747.c: p, p+1 and 2p, the subgroup orders, the generators of the three parties in Montgomery
+#   representation, the Montgomery constants, the optimal strategies and their stack depths, and the
+#   addition chain computing a^(p-2) used by fpinv_chain_mont() in fpx.c.
+#
+#   Generators {XP0, XP1, XQ0, XR0, XR1} are chosen on E0: y^2 = x^3 + x as in SIGKp747: Q is a point of
+#   E0(GF(p)) of order l^e, P a point of order l^e with x(P) not in GF(p) such that P and Q generate
+#   E0[l^e], and R = P - Q. For l = 2, [2^(eA-1)]Q = (0,0), so the kernels P + [m]Q of Alice's 4-isogenies
+#   never contain (0,0).
+#   The strategies minimize the cost of the isogeny tree traversals, where a step of point
+#   multiplication costs "ratio" times the evaluation of an isogeny at one point. The default ratios
+#   are those fitted to the SIGKp747 strategies. With --points n, it also prints the optimal strategies
+#   storing at most n points during a traversal, used by SIGK_SMALL_FOOTPRINT builds. Their splits
+#   depend on the points left, so they are listed in the order the traversal reads them.
+#   With --cores k..., it prints for each k the strategies minimizing the latency of a traversal whose
+#   isogeny evaluations are shared by k threads (sigk_set_workers()). Each row then costs the time of its
+#   evaluations on k threads, which favors more stored points and fewer multiplications on the critical
+#   path. They store at most as many points as the default strategies and are in traversal order too.
+#
+#   Usage: gen_params.py eA eB eC f [--radix 64|32] [--seed n] [--ratios rA rB rC] [--points n]
+#                        [--cores k...] [--tracked n]
+#####################################################################################################
+
+import argparse
+import random
+import sys
+
+
+def is_prime(n, rounds=40):
+    if n < 2:
+        return False
+    for sp in (2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37):
+        if n % sp == 0:
+            return n == sp
+    d, s = n - 1, 0
+    while d % 2 == 0:
+        d, s = d // 2, s + 1
+    for _ in range(rounds):
+        x = pow(random.randrange(2, n - 1), d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(s - 1):
+            x = x * x % n
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+class Fp2:
+    # GF(p^2) = GF(p)[i]/(i^2 + 1), p = 3 mod 4
+    def __init__(self, p):
+        self.p = p
+
+    def add(self, a, b):
+        return ((a[0] + b[0]) % self.p, (a[1] + b[1]) % self.p)
+
+    def sub(self, a, b):
+        return ((a[0] - b[0]) % self.p, (a[1] - b[1]) % self.p)
+
+    def mul(self, a, b):
+        p = self.p
+        return ((a[0] * b[0] - a[1] * b[1]) % p, (a[0] * b[1] + a[1] * b[0]) % p)
+
+    def inv(self, a):
+        p = self.p
+        n = pow((a[0] * a[0] + a[1] * a[1]) % p, p - 2, p)
+        return (a[0] * n % p, -a[1] * n % p)
+
+    def pow(self, a, e):
+        r = (1, 0)
+        while e:
+            if e & 1:
+                r = self.mul(r, a)
+            a, e = self.mul(a, a), e >> 1
+        return r
+
+    def sqrt(self, a):
+        # Square root for p = 3 mod 4, None if a is not a square
+        p = self.p
+        a1 = self.pow(a, (p - 3) // 4)
+        alpha = self.mul(a1, self.mul(a1, a))
+        x0 = self.mul(a1, a)
+        if alpha == (p - 1, 0):
+            x = self.mul((0, 1), x0)
+        else:
+            x = self.mul(self.pow(self.add((1, 0), alpha), (p - 1) // 2), x0)
+        return x if self.mul(x, x) == a else None
+
+
+class E0:
+    # Affine arithmetic on y^2 = x^3 + x over GF(p^2), None is the point at infinity
+    def __init__(self, F):
+        self.F = F
+
+    def lift(self, x):
+        F = self.F
+        y = F.sqrt(F.add(F.mul(F.mul(x, x), x), x))
+        return None if y is None else (x, y)
+
+    def neg(self, P):
+        return (P[0], self.F.sub((0, 0), P[1]))
+
+    def add(self, P, Q):
+        F = self.F
+        if P is None:
+            return Q
+        if Q is None:
+            return P
+        if P[0] == Q[0]:
+            if F.add(P[1], Q[1]) == (0, 0):
+                return None
+            num = F.add(F.mul((3, 0), F.mul(P[0], P[0])), (1, 0))
+            lam = F.mul(num, F.inv(F.mul((2, 0), P[1])))
+        else:
+            lam = F.mul(F.sub(Q[1], P[1]), F.inv(F.sub(Q[0], P[0])))
+        x = F.sub(F.sub(F.mul(lam, lam), P[0]), Q[0])
+        return (x, F.sub(F.mul(lam, F.sub(P[0], x)), P[1]))
+
+    def mul(self, k, P):
+        R = None
+        while k:
+            if k & 1:
+                R = self.add(R, P)
+            P, k = self.add(P, P), k >> 1
+        return R
+
+
+def basis(E, p, l, e, rng):
+    # Points P, Q generating E0[l^e], with Q in E0(GF(p)) and x(P) not in GF(p)
+    cofactor = (p + 1) // l**e
+
+    def point(real):
+        while True:
+            x = (rng.randrange(p), 0 if real else rng.randrange(1, p))
+            T = E.lift(x)
+            if T is None:
+                continue
+            T = E.mul(cofactor, T)
+            if T is not None and E.mul(l**(e - 1), T) is not None:
+                return T
+
+    Q = point(True)
+    Q1 = E.mul(l**(e - 1), Q)
+    while True:
+        P = point(False)
+        P1 = E.mul(l**(e - 1), P)
+        if P1[0] not in [E.mul(k, Q1)[0] for k in range(1, (l + 1) // 2 + 1)]:
+            return P, Q
+
+
+def strategy(n, ratio):
+    # Optimal strategy for n leaves, in the format of strat_Alice: entry k is the split of a tree of k+1 leaves
+    cost, split = [0.0] * (n + 1), [0] * (n + 1)
+    for k in range(2, n + 1):
+        cost[k], split[k] = min((cost[k - m] + cost[m] + m * ratio + (k - m), m) for m in range(1, k))
+    return [0] + [split[k + 1] for k in range(1, n)]
+
+
+def eval_time(points, cores):
+    # Time of pushing "points" points through an isogeny when "cores" threads share their blocks of EVAL_BLOCK = 4 points
+    blocks = (points + 3) // 4
+    return min(points, 4 * ((blocks + cores - 1) // cores))
+
+
+def bounded_strategy(n, ratio, points, cores=1, tracked=0):
+    # Optimal strategy for n leaves storing at most "points" points, as the list of its splits in traversal order,
+    # and its cost. A tree of k leaves below d stored points stores its root, whose subtree of k-m leaves is then
+    # below d+1 points, and restores it as the root of the subtree of m leaves. The isogeny of a leaf pushes the d
+    # stored points and the "tracked" images of the walk. With one core, the splits are the same for any "tracked",
+    # and without a bound on the points they are those of strategy(). Returns None if no strategy fits.
+    inf = float('inf')
+    cost = [[inf] * (points + 1) for k in range(n + 1)]
+    split = [[0] * (points + 1) for k in range(n + 1)]
+    cost[1] = [eval_time(d + tracked, cores) for d in range(points + 1)]
+    for k in range(2, n + 1):
+        for d in range(points):
+            cost[k][d], split[k][d] = min((cost[k - m][d + 1] + cost[m][d] + m * ratio, m) for m in range(1, k))
+    if cost[n][0] == inf:
+        return None
+
+    splits, stack = [], [(n, 0)]
+    while stack:
+        k, d = stack.pop()
+        if k > 1:
+            splits.append(split[k][d])
+            stack.append((split[k][d], d))
+            stack.append((k - split[k][d], d + 1))
+    return splits, cost[n][0]
+
+
+def strategy_time(n, strat, ratio, cores, tracked):
+    # Cost of a strategy in the format of strat_Alice when the evaluations of each row are shared by "cores" threads
+    time, stack = 0.0, [(n, 0)]
+    while stack:
+        k, d = stack.pop()
+        if k == 1:
+            time += eval_time(d + tracked, cores)
+        else:
+            m = strat[k - 1]
+            time += m * ratio
+            stack.append((m, d))
+            stack.append((k - m, d + 1))
+    return time
+
+
+def max_points(n, strat):
+    # Largest number of points stored by the traversal of groupKey.c
+    stack, index, row, depth = [], 0, 1, 0
+    while row < n:
+        while index < n - row:
+            stack.append(index)
+            depth = max(depth, len(stack))
+            index += strat[n - index - row]
+        index = stack.pop()
+        row += 1
+    return depth
+
+
+def inversion_chain(e, width=6):
+    # Sliding window chain for a^e with the table t[i] = a^(2i+3), as in fpinv_chain_mont()
+    bits = bin(e)[2:]
+    windows, i = [], 0
+    while i < len(bits):
+        if bits[i] == '0':
+            windows.append((1, None))
+            i += 1
+            continue
+        j = min(i + width, len(bits))
+        while bits[j - 1] == '0':
+            j -= 1
+        windows.append((j - i, int(bits[i:j], 2)))
+        i = j
+    # Merge the squarings preceding each multiplication
+    steps, sqr = [], 0
+    for length, value in windows:
+        sqr += length
+        if value is not None:
+            steps.append((sqr if steps else 0, value))
+            sqr = 0
+    return steps, sqr
+
+
+def chain_code(e):
+    steps, tail = inversion_chain(e)
+    top = max(v for _, v in steps)
+    lines = ['    felm_t t[%d], tt;' % ((top - 3) // 2 + 1), '', '    COUNT_OP(fpinv);', '',
+             '    // Precomputed table', '    fpsqr_mont(a, tt);', '    fpmul_mont(a, tt, t[0]);',
+             '    for (i = 0; i <= %d; i++)' % ((top - 3) // 2 - 1), '        fpmul_mont(t[i], tt, t[i + 1]);', '']
+    first = steps[0][1]
+    lines.append('    fpcopy(a, tt);' if first == 1 else '    fpcopy(t[%d], tt);' % ((first - 3) // 2))
+    k = 1
+    while k < len(steps):
+        n = 1
+        while k + n < len(steps) and steps[k + n] == steps[k]:
+            n += 1
+        sqr, value = steps[k]
+        mul = 'fpmul_mont(a, tt, tt);' if value == 1 else 'fpmul_mont(t[%d], tt, tt);' % ((value - 3) // 2)
+        if n > 1:
+            lines += ['    for (j = 0; j < %d; j++)' % n, '    {', '        for (i = 0; i < %d; i++)' % sqr,
+                      '            fpsqr_mont(tt, tt);', '        ' + mul, '    }']
+        else:
+            lines += ['    for (i = 0; i < %d; i++)' % sqr, '        fpsqr_mont(tt, tt);', '    ' + mul]
+        k += n
+    if tail:
+        lines += ['    for (i = 0; i < %d; i++)' % tail, '        fpsqr_mont(tt, tt);']
+    return lines
+
+
+def words(x, radix, n):
+    return [(x >> (radix * i)) & ((1 << radix) - 1) for i in range(n)]
+
+
+def c_array(decl, values, radix, per_line=6):
+    fmt = '0x%0' + str(radix // 4) + 'X'
+    rows = [', '.join(fmt % v for v in values[i:i + per_line]) for i in range(0, len(values), per_line)]
+    return '%s = {%s};' % (decl, ',\n\t'.join(rows))
+
+
+def c_strategy(name, strat, size='MAX_%s'):
+    rows = [', '.join(str(v) for v in strat[i:i + 25]) for i in range(0, len(strat), 25)]
+    return 'static const unsigned int %s[%s] = {\n\t%s};' % (name, size % name.split('_')[1], ',\n\t'.join(rows))
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Constants of a SIGK parameter set')
+    parser.add_argument('eA', type=int)
+    parser.add_argument('eB', type=int)
+    parser.add_argument('eC', type=int)
+    parser.add_argument('f', type=int)
+    parser.add_argument('--radix', type=int, choices=(32, 64), default=64)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--ratios', type=float, nargs=3, default=(1.05, 1.55, 2.7))
+    parser.add_argument('--points', type=int)
+    parser.add_argument('--cores', type=int, nargs='+', default=())
+    parser.add_argument('--tracked', type=int, default=3)
+    args = parser.parse_args(argv)
+
+    eA, eB, eC = args.eA, args.eB, args.eC
+    p = 2**eA * 3**eB * 5**eC * args.f - 1
+    if eA % 2 != 0 or p % 4 != 3 or not is_prime(p):
+        sys.stderr.write('p = 2^%d*3^%d*5^%d*%d - 1 is not a prime = 3 mod 4 with eA even\n' % (eA, eB, eC, args.f))
+        return 1
+    nbits = p.bit_length()
+    nwords = (nbits + args.radix - 1) // args.radix
+    nwords_order = (max(eA, (3**eB).bit_length(), (5**eC).bit_length()) + args.radix - 1) // args.radix
+    zero_words = ((p + 1) & -(p + 1)).bit_length() // args.radix
+    R = 2**(args.radix * nwords)
+    rng = random.Random(args.seed)
+    F = Fp2(p)
+    E = E0(F)
+    r = args.radix
+
+    print('// p = 2^%d*3^%d*5^%d*%d - 1, %d bits, %d words of %d bits, %d zero words in p+1' % (eA, eB, eC, args.f, nbits, nwords, r, zero_words))
+    print(c_array('static const uint64_t p%d[NWORDS64_FIELD]' % nbits, words(p, r, nwords), r))
+    print(c_array('static const uint64_t p%dp1[NWORDS64_FIELD]' % nbits, words(p + 1, r, nwords), r))
+    print(c_array('static const uint64_t p%dx2[NWORDS64_FIELD]' % nbits, words(2 * p, r, nwords), r))
+    for name, order in (('Alice', 2**eA), ('Bob', 3**eB), ('Eve', 5**eC)):
+        print(c_array('static const uint64_t %s_order[NWORDS64_ORDER]' % name, words(order, r, nwords_order), r))
+    for name, l, e in (('A', 2, eA), ('B', 3, eB), ('C', 5, eC)):
+        P, Q = basis(E, p, l, e, rng)
+        Rpt = E.add(P, E.neg(Q))
+        gen = [P[0][0], P[0][1], Q[0][0], Rpt[0][0], Rpt[0][1]]
+        print(c_array('static const uint64_t %s_gen[5 * NWORDS64_FIELD]' % name, sum((words(v * R % p, r, nwords) for v in gen), []), r))
+    print(c_array('static const uint64_t Montgomery_R2[NWORDS64_FIELD]', words(R * R % p, r, nwords), r))
+    print(c_array('static const uint64_t Montgomery_one[NWORDS64_FIELD]', words(R % p, r, nwords), r))
+    for name, n, ratio in (('strat_Alice', eA // 2, args.ratios[0]), ('strat_Bob', eB, args.ratios[1]), ('strat_Eve', eC, args.ratios[2])):
+        strat = strategy(n, ratio)
+        print('// %s: MAX = %d, MAX_INT_POINTS = %d' % (name, n, max_points(n, strat)))
+        print(c_strategy(name, strat))
+    if args.points is not None:
+        for name, n, ratio in (('strat_Alice', eA // 2, args.ratios[0]), ('strat_Bob', eB, args.ratios[1]), ('strat_Eve', eC, args.ratios[2])):
+            bounded = bounded_strategy(n, ratio, args.points)
+            if bounded is None:
+                sys.stderr.write('no strategy of %d leaves stores at most %d points\n' % (n, args.points))
+                return 1
+            free = bounded_strategy(n, ratio, max_points(n, strategy(n, ratio)))[1]
+            print('// %s in traversal order: MAX = %d, at most %d points, cost +%.1f%%' % (name, n, args.points, 100 * (bounded[1] / free - 1)))
+            print(c_strategy(name, bounded[0], 'MAX_%s - 1'))
+    for cores in args.cores:
+        for name, n, ratio in (('strat_Alice', eA // 2, args.ratios[0]), ('strat_Bob', eB, args.ratios[1]), ('strat_Eve', eC, args.ratios[2])):
+            strat = strategy(n, ratio)
+            points = max_points(n, strat)
+            splits, time = bounded_strategy(n, ratio, points, cores, args.tracked)
+            print('// %s_%dcores in traversal order: MAX = %d, at most %d points, latency -%.1f%% with %d cores' %
+                  (name, cores, n, points, 100 * (1 - time / strategy_time(n, strat, ratio, cores, args.tracked)), cores))
+            print(c_strategy('%s_%dcores' % (name, cores), splits, 'MAX_%s - 1'))
+    print('// fpinv_chain_mont(), a^(p-2)')
+    print('\n'.join(chain_code(p - 2)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#####################################################################################################
+#   Supersingular Isogeny Group-Key Agreement Library
+#
+#   Abstract: worst-case stack usage report
+#   Reads the call graphs written by gcc -fcallgraph-info=su (one .ci file per object) and prints,
+#   for every function of the library, its own frame and the deepest stack reached through its callees.
+#
+#   Usage: stack_report.py [--all] file.ci [file.ci ...]
+#####################################################################################################
+
+import re
+import sys
+
+NODE = re.compile(r'node: \{ title: "([^"]*)" label: "([^"]*)"')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]*)" targetname: "([^"]*)"')
+FRAME = re.compile(r'(\d+) bytes \(([^)]*)\)')
+
+
+def short(title):
+    # Static functions are prefixed with the translation unit, external ones are not
+    return title.rsplit(':', 1)[-1]
+
+
+def load(files):
+    frames, quals, calls = {}, {}, {}
+    for name in files:
+        with open(name) as f:
+            for line in f:
+                m = NODE.search(line)
+                if m:
+                    fr = FRAME.search(m.group(2))
+                    if fr:
+                        frames[short(m.group(1))] = int(fr.group(1))
+                        quals[short(m.group(1))] = fr.group(2)
+                    continue
+                m = EDGE.search(line)
+                if m:
+                    calls.setdefault(short(m.group(1)), set()).add(short(m.group(2)))
+    return frames, quals, calls
+
+
+def worst_case(frames, calls):
+    # Depth-first evaluation of the deepest path. Recursion makes the bound infinite, calls to functions
+    # outside the library (libc, system calls) are not accounted for and mark the bound as a lower bound.
+    memo, open_ = {}, set()
+
+    def visit(fn):
+        if fn in memo:
+            return memo[fn]
+        if fn in open_:
+            return (None, True, [fn])
+        if fn not in frames:
+            return (0, False, [fn + '*'])
+        open_.add(fn)
+        best, partial, path = 0, False, []
+        for callee in sorted(calls.get(fn, ())):
+            depth, inexact, sub = visit(callee)
+            if depth is None:
+                best, path = None, sub
+                break
+            partial = partial or inexact or sub[-1].endswith('*')
+            if depth > best or not path:
+                best, path = depth, sub
+        open_.discard(fn)
+        if best is None:
+            result = (None, True, [fn] + path)
+        else:
+            result = (frames[fn] + best, partial, [fn] + path)
+        memo[fn] = result
+        return result
+
+    return {fn: visit(fn) for fn in frames}
+
+
+def main(argv):
+    show_all = '--all' in argv
+    files = [a for a in argv if a != '--all']
+    if not files:
+        sys.stderr.write('usage: stack_report.py [--all] file.ci [file.ci ...]\n')
+        return 1
+
+    frames, quals, calls = load(files)
+    report = worst_case(frames, calls)
+
+    print('%-40s %8s %10s  %s' % ('function', 'frame', 'worst', 'deepest path'))
+    for fn in sorted(report, key=lambda f: (-(report[f][0] or 1 << 62), f)):
+        depth, partial, path = report[fn]
+        if not show_all and fn not in calls and depth is not None and depth < 1024:
+            continue
+        worst = 'unbounded' if depth is None else ('%d%s' % (depth, '+' if partial else ''))
+        frame = '%d%s' % (frames[fn], '' if quals[fn] == 'static' else '~')
+        print('%-40s %8s %10s  %s' % (fn, frame, worst, ' > '.join(p for p in path[1:] if not p.endswith('*'))))
+    print('')
+    print('frame: own frame in bytes, "~" marks a frame gcc reports as dynamic but bounded')
+    print('worst: own frame plus the deepest chain of callees, "+" marks chains calling outside the library')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,188 @@
+/********************************************************************************************
+* Supersingular Isogeny Group Key Agreement Library
+*
+* Abstract: worker threads sharing the isogeny evaluations of the operations, see sigk_set_workers()
+* The pool is shared by all parameter sets. An operation splits the points pushed through the isogeny of a row
+* into parts, runs the first part itself, hands the others to the workers and waits for them. One operation uses
+* the workers at a time, the rows of the operations running meanwhile are evaluated on their own thread.
+*********************************************************************************************/
+
+#include "sigk_internal.h"
+#include "sigk_sdt.h"
+#if !defined(__WINDOWS__)
+#include <pthread.h>
+#endif
+
+// Static probes of the "sigk" provider at the entry and return of the functions of api.h
+#define PROBE_ENTRY(fn) SIGK_PROBE0(sigk, fn##__entry)
+#define PROBE_RETURN(fn, ret) SIGK_PROBE1(sigk, fn##__return, ret)
+
+#if defined(__WINDOWS__)
+
+int sigk_set_workers(unsigned int n)
+{ // Worker threads are not supported, the operations run on the calling thread
+    const int ret = (n == 0) ? 0 : 1;
+
+    PROBE_ENTRY(sigk_set_workers);
+    PROBE_RETURN(sigk_set_workers, ret);
+    return ret;
+}
+
+unsigned int sigk_workers_cores(void)
+{
+    return 1;
+}
+
+void sigk_workers_run(sigk_job_t job, void *ctx, const unsigned int nparts)
+{
+    unsigned int i;
+
+    for (i = 0; i < nparts; i++)
+    {
+        job(ctx, i, nparts);
+    }
+}
+
+#else
+
+static struct
+{
+    pthread_mutex_t busy;       // Held by the operation using the workers, and while the workers are replaced
+    pthread_mutex_t lock;       // Protects the fields below
+    pthread_cond_t start, done;
+    pthread_t threads[SIGK_MAX_WORKERS];
+    unsigned int nthreads;      // Running workers, only changed with pool.busy held
+    unsigned int round;         // Number of jobs handed to the running workers
+    unsigned int pending;       // Parts of the current job the workers have not finished
+    unsigned int stop;
+    sigk_job_t job;
+    void *ctx;
+    unsigned int nparts;
+} pool = {.busy = PTHREAD_MUTEX_INITIALIZER, .lock = PTHREAD_MUTEX_INITIALIZER, .start = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER};
+
+static void *worker(void *arg)
+{ // Worker i runs the part i+1 of each job made of more than i+1 parts, until the pool is stopped
+    const unsigned int part = (unsigned int)(uintptr_t)arg + 1;
+    unsigned int round = 0; // The workers are started with pool.round = 0
+    sigk_job_t job;
+    void *ctx;
+    unsigned int nparts;
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;)
+    {
+        while (pool.round == round && !pool.stop)
+            pthread_cond_wait(&pool.start, &pool.lock);
+        if (pool.stop)
+            break;
+        round = pool.round;
+        if (part >= pool.nparts)
+            continue;
+        job = pool.job;
+        ctx = pool.ctx;
+        nparts = pool.nparts;
+        pthread_mutex_unlock(&pool.lock);
+
+        job(ctx, part, nparts);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.pending == 0)
+            pthread_cond_signal(&pool.done);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+static void stop_workers(void)
+{ // Called with pool.busy held
+    unsigned int i;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 1;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+    for (i = 0; i < pool.nthreads; i++)
+    {
+        pthread_join(pool.threads[i], NULL);
+    }
+    pthread_mutex_lock(&pool.lock);
+    pool.nthreads = 0;
+    pool.stop = 0;
+    pool.round = 0;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+int sigk_set_workers(unsigned int n)
+{ // Replace the running workers with n new ones
+    int ret = 0;
+
+    PROBE_ENTRY(sigk_set_workers);
+    if (n > SIGK_MAX_WORKERS)
+    {
+        PROBE_RETURN(sigk_set_workers, 1);
+        return 1;
+    }
+    pthread_mutex_lock(&pool.busy);
+    stop_workers();
+    while (pool.nthreads < n)
+    {
+        if (pthread_create(&pool.threads[pool.nthreads], NULL, worker, (void *)(uintptr_t)pool.nthreads) != 0)
+        { // The workers started so far are kept
+            ret = 1;
+            break;
+        }
+        pthread_mutex_lock(&pool.lock);
+        pool.nthreads++;
+        pthread_mutex_unlock(&pool.lock);
+    }
+    pthread_mutex_unlock(&pool.busy);
+    PROBE_RETURN(sigk_set_workers, ret);
+    return ret;
+}
+
+unsigned int sigk_workers_cores(void)
+{ // Threads sharing the evaluations of an operation, the calling thread included
+    unsigned int n;
+
+    pthread_mutex_lock(&pool.lock);
+    n = pool.nthreads + 1;
+    pthread_mutex_unlock(&pool.lock);
+    return n;
+}
+
+void sigk_workers_run(sigk_job_t job, void *ctx, const unsigned int nparts)
+{ // Part 0 runs on the calling thread. If the workers are used by another operation or fewer than nparts-1 are running,
+  // all parts run on the calling thread.
+    unsigned int i;
+
+    if (nparts > 1 && pthread_mutex_trylock(&pool.busy) == 0)
+    { // pool.nthreads does not change while pool.busy is held
+        if (nparts <= pool.nthreads + 1)
+        {
+            pthread_mutex_lock(&pool.lock);
+            pool.job = job;
+            pool.ctx = ctx;
+            pool.nparts = nparts;
+            pool.pending = nparts - 1;
+            pool.round++;
+            pthread_cond_broadcast(&pool.start);
+            pthread_mutex_unlock(&pool.lock);
+
+            job(ctx, 0, nparts);
+
+            pthread_mutex_lock(&pool.lock);
+            while (pool.pending > 0)
+                pthread_cond_wait(&pool.done, &pool.lock);
+            pthread_mutex_unlock(&pool.lock);
+            pthread_mutex_unlock(&pool.busy);
+            return;
+        }
+        pthread_mutex_unlock(&pool.busy);
+    }
+    for (i = 0; i < nparts; i++)
+    {
+        job(ctx, i, nparts);
+    }
+}
+
+#endif